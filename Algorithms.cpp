@@ -3,12 +3,360 @@
 
 #include "Algorithms.hpp"
 #include "Graph.hpp"
+#include "CSRGraph.hpp"
 #include "Queue.hpp"
+#include "MinHeap.hpp"
+#include "IndexedHeap.hpp"
+#include "Bitmap.hpp"
 #include <stdexcept> // For exceptions
 #include <climits>
 #include "UnionFind.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+
+namespace {
+
+    // An undirected edge extracted from the graph for Kruskal's algorithm
+    struct KruskalEdge {
+        int src;
+        int dest;
+        int weight;
+    };
+
+    // Sorts the edges by weight with a stable LSD radix sort: 4 passes of 8 bits, O(E) for int weights.
+    // Flipping the sign bit maps negative weights below positive ones in unsigned order.
+    void radixSortByWeight(KruskalEdge* edges, int count)
+    {
+        if (count < 2) return; // Nothing to sort
+
+        KruskalEdge* buffer = new KruskalEdge[count];
+        KruskalEdge* from = edges;
+        KruskalEdge* to = buffer;
+
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            int bucket_start[257] = {0};
+            for (int i = 0; i < count; i++)
+            {
+                unsigned int key = static_cast<unsigned int>(from[i].weight) ^ 0x80000000u;
+                bucket_start[((key >> shift) & 0xFF) + 1]++;
+            }
+
+            unsigned int first_digit = ((static_cast<unsigned int>(from[0].weight) ^ 0x80000000u) >> shift) & 0xFF;
+            if (bucket_start[first_digit + 1] == count)
+            {
+                continue; // Every edge has the same digit here, this pass would not move anything
+            }
+
+            for (int b = 0; b < 256; b++)
+            {
+                bucket_start[b + 1] += bucket_start[b];
+            }
+            for (int i = 0; i < count; i++) // Scatter in order, so equal digits keep their relative order
+            {
+                unsigned int key = static_cast<unsigned int>(from[i].weight) ^ 0x80000000u;
+                to[bucket_start[(key >> shift) & 0xFF]++] = from[i];
+            }
+
+            KruskalEdge* temp = from;
+            from = to;
+            to = temp;
+        }
+
+        if (from != edges) // An odd number of passes moved the data, the result is in buffer
+        {
+            for (int i = 0; i < count; i++)
+            {
+                edges[i] = from[i];
+            }
+        }
+
+        delete[] buffer;
+    }
+
+    // Lists every undirected edge of g once (src < dest), in adjacency order, so Kruskal and Boruvka break ties the same way.
+    // The edges are counted first so the array fits the graph instead of the n choose 2 worst case. The caller frees it.
+    KruskalEdge* extractUndirectedEdges(const graph::Graph& g, int& count)
+    {
+        int num_vertices = g.getNumOfVertices();
+        graph::Edge** adj = g.getAdjList();
+
+        count = 0;
+        for (int i = 0; i < num_vertices; i++)
+        {
+            for (graph::Edge* current = adj[i]; current != nullptr; current = current->next)
+            {
+                if (i < current->dest_vertex)
+                {
+                    count++;
+                }
+            }
+        }
+
+        KruskalEdge* edge_list = new KruskalEdge[count];
+        int index = 0;
+        for (int i = 0; i < num_vertices; i++)
+        {
+            for (graph::Edge* current = adj[i]; current != nullptr; current = current->next)
+            {
+                if (i < current->dest_vertex) // This avoids storing both (i,j) and (j,i)
+                {
+                    edge_list[index++] = {i, current->dest_vertex, current->weight};
+                }
+            }
+        }
+        return edge_list;
+    }
+
+    // The same over the contiguous neighbor ranges of a CSR graph
+    KruskalEdge* extractUndirectedEdges(const graph::CSRGraph& g, int& count)
+    {
+        int num_vertices = g.getNumOfVertices();
+        const int* offsets = g.getOffsets();
+        const int* dest_vertices = g.getDestVertices();
+        const int* weights = g.getWeights();
+
+        count = 0;
+        for (int v = 0; v < num_vertices; v++)
+        {
+            for (int i = offsets[v]; i < offsets[v + 1]; i++)
+            {
+                if (v < dest_vertices[i])
+                {
+                    count++;
+                }
+            }
+        }
+
+        KruskalEdge* edge_list = new KruskalEdge[count];
+        int index = 0;
+        for (int v = 0; v < num_vertices; v++)
+        {
+            for (int i = offsets[v]; i < offsets[v + 1]; i++)
+            {
+                if (v < dest_vertices[i]) // Store each undirected edge once
+                {
+                    edge_list[index++] = {v, dest_vertices[i], weights[i]};
+                }
+            }
+        }
+        return edge_list;
+    }
+
+    // Lowers slot to key if key is smaller, safe to call from several threads at once
+    void atomicMin(std::atomic<unsigned long long>& slot, unsigned long long key)
+    {
+        unsigned long long current = slot.load(std::memory_order_relaxed);
+        while (key < current && !slot.compare_exchange_weak(current, key, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Borůvka's algorithm over an extracted edge list. Edges are ranked by (weight, index in the list),
+    // a strict total order, so the forest is unique and equal to what Kruskal's stable sort accepts.
+    graph::SpanningForest boruvkaOnEdges(const KruskalEdge* edges, int edge_count, int num_vertices, int num_threads)
+    {
+        const unsigned long long NO_EDGE = ~0ULL;
+        num_threads = graph::resolveThreadCount(num_threads);
+
+        graph::SpanningForest mst(num_vertices);
+        UnionFind uf(num_vertices);
+        int* component = new int[num_vertices]; // Snapshot of uf.find(v), read-only while the threads run
+        std::atomic<unsigned long long>* best = new std::atomic<unsigned long long>[num_vertices]; // Cheapest edge key leaving each component
+
+        bool merged = true;
+        while (merged) // Every round at least halves the number of components that still have outgoing edges
+        {
+            merged = false;
+
+            for (int v = 0; v < num_vertices; v++) // find() compresses paths, so it runs before the threads start
+            {
+                component[v] = uf.find(v);
+            }
+
+            graph::parallelFor(0, num_vertices, num_threads, [&](int, int first, int last) {
+                for (int c = first; c < last; c++)
+                {
+                    best[c].store(NO_EDGE, std::memory_order_relaxed);
+                }
+            });
+
+            // Find the minimum outgoing edge of every component, each thread scans its own slice of the edges
+            graph::parallelFor(0, edge_count, num_threads, [&](int, int first, int last) {
+                for (int i = first; i < last; i++)
+                {
+                    int src_component = component[edges[i].src];
+                    int dest_component = component[edges[i].dest];
+                    if (src_component == dest_component) continue; // Internal edge, it can never join the forest
+
+                    // Weight in the high half (sign bit flipped so negative weights order first), index in the low half
+                    unsigned long long key = (static_cast<unsigned long long>(static_cast<unsigned int>(edges[i].weight) ^ 0x80000000u) << 32) | static_cast<unsigned int>(i);
+                    atomicMin(best[src_component], key);
+                    atomicMin(best[dest_component], key);
+                }
+            });
+
+            // Contract: join every component with its minimum outgoing edge
+            for (int c = 0; c < num_vertices; c++)
+            {
+                unsigned long long key = best[c].load(std::memory_order_relaxed);
+                if (key == NO_EDGE) continue;
+
+                const KruskalEdge& edge = edges[key & 0xFFFFFFFFULL];
+                if (uf.find(edge.src) != uf.find(edge.dest)) // Both endpoints' components may have picked the same edge
+                {
+                    uf.unite(edge.src, edge.dest);
+                    mst.addEdge(edge.src, edge.dest, edge.weight);
+                    merged = true;
+                }
+            }
+        }
+
+        delete[] component;
+        delete[] best;
+        return mst;
+    }
+
+    // Builds a shortest path tree as a Graph with the edges added by ascending vertex, the order dijkstra() always used
+    graph::Graph shortestPathTreeGraph(const graph::TraversalTree& tree)
+    {
+        int num_vertices = tree.getNumOfVertices();
+        const int* parent = tree.getParents();
+        const int* parent_weight = tree.getParentWeights();
+
+        graph::Graph shortest_tree(num_vertices);
+        for (int i = 0; i < num_vertices; i++)
+        {
+            if (parent[i] != -1)
+            {
+                shortest_tree.addDirectedEdge(parent[i], i, parent_weight[i]);
+            }
+        }
+        return shortest_tree;
+    }
+
+    // A growable array written by one thread at a time, doubling when it is full
+    template <typename T>
+    struct LocalBuffer {
+        T* data = nullptr;
+        int size = 0;
+        int capacity = 0;
+
+        LocalBuffer() = default;
+        ~LocalBuffer()
+        {
+            delete[] data;
+        }
+        LocalBuffer(const LocalBuffer&) = delete; // The array is owned
+        LocalBuffer& operator=(const LocalBuffer&) = delete;
+
+        void append(const T& value)
+        {
+            if (size == capacity)
+            {
+                int new_capacity = capacity < 64 ? 64 : capacity * 2;
+                T* bigger = new T[new_capacity];
+                for (int i = 0; i < size; i++)
+                {
+                    bigger[i] = data[i];
+                }
+                delete[] data;
+                data = bigger;
+                capacity = new_capacity;
+            }
+            data[size++] = value;
+        }
+    };
+
+    // Bidirectional Dijkstra between source and target. forward(u, relax) and backward(u, relax) call relax(v, w)
+    // for every edge u -> v of the graph, and for every edge v -> u of the graph (u -> v of its reverse), respectively.
+    template <typename ForwardEdges, typename BackwardEdges>
+    graph::Path bidirectionalSearch(int num_vertices, int source, int target, ForwardEdges forward, BackwardEdges backward)
+    {
+        const long long NO_PATH = graph::Path::NO_PATH;
+
+        // Index 0 is the forward search from source, index 1 the backward search from target
+        long long* dist[2] = {new long long[num_vertices], new long long[num_vertices]};
+        int* parent[2] = {new int[num_vertices], new int[num_vertices]}; // Backwards, parent[1][v] is the next vertex towards target
+        bool* settled[2] = {new bool[num_vertices]{false}, new bool[num_vertices]{false}};
+        for (int i = 0; i < num_vertices; i++)
+        {
+            dist[0][i] = NO_PATH;
+            dist[1][i] = NO_PATH;
+            parent[0][i] = -1;
+            parent[1][i] = -1;
+        }
+
+        MinHeap heap[2] = {MinHeap(64), MinHeap(64)};
+        dist[0][source] = 0;
+        dist[1][target] = 0;
+        heap[0].push(0, source);
+        heap[1].push(0, target);
+
+        long long best = (source == target) ? 0 : NO_PATH; // Shortest source -> target path seen so far
+        int meeting = source; // A vertex of that path reached by both searches
+
+        // Stop when no path through an unsettled vertex can beat best: its cost would be at least the sum of the two minimums
+        while (!heap[0].isEmpty() && !heap[1].isEmpty() && heap[0].peekKey() + heap[1].peekKey() < best)
+        {
+            int side = heap[0].peekKey() <= heap[1].peekKey() ? 0 : 1; // Grow the search with the smaller radius
+            int other = 1 - side;
+            int current = heap[side].pop();
+            if (settled[side][current]) continue; // A stale entry of an already settled vertex
+            settled[side][current] = true;
+
+            auto relax = [&](int neighbor, int weight)
+            {
+                long long candidate = dist[side][current] + weight;
+                if (candidate < dist[side][neighbor])
+                {
+                    dist[side][neighbor] = candidate;
+                    parent[side][neighbor] = current;
+                    heap[side].push(candidate, neighbor);
+                }
+                if (dist[other][neighbor] != NO_PATH && candidate + dist[other][neighbor] < best) // The searches meet at neighbor
+                {
+                    best = candidate + dist[other][neighbor];
+                    meeting = neighbor;
+                }
+            };
+
+            if (side == 0)
+            {
+                forward(current, relax);
+            }
+            else
+            {
+                backward(current, relax);
+            }
+        }
+
+        graph::Path path(parent[0], parent[1], meeting, best);
+
+        for (int k = 0; k < 2; k++)
+        {
+            delete[] dist[k];
+            delete[] parent[k];
+            delete[] settled[k];
+        }
+        return path;
+    }
+
+    // A relaxation found by delta-stepping: vertex can be reached through parent (over an edge of weight) at distance
+    struct RelaxRequest {
+        int vertex;
+        int parent;
+        int weight;
+        long long distance;
+    };
+}
 
 graph::Graph graph::Algorithms::bfs(const Graph& g, int start_vertex)
+{
+    return bfsTree(g, start_vertex).toGraph(); // The rooted tree, edges added in discovery order
+}
+
+graph::TraversalTree graph::Algorithms::bfsTree(const Graph& g, int start_vertex)
 {
     int num_vertices = g.getNumOfVertices();
 
@@ -17,12 +365,12 @@ graph::Graph graph::Algorithms::bfs(const Graph& g, int start_vertex)
         throw std::out_of_range("Invalid start vertex");
     }
 
-    Graph rooted_tree(num_vertices); // The rooted tree to be returned drom the BFS traverse
-    bool* visited = new bool[num_vertices]{false};
+    TraversalTree rooted_tree(num_vertices); // The rooted tree to be returned drom the BFS traverse
+    const long long* depth = rooted_tree.distance; // A vertex is visited once it has a depth
     
     Queue queue(num_vertices);
     queue.enqueue(start_vertex);
-    visited[start_vertex] = true;
+    rooted_tree.discover(start_vertex, -1, 0, 0);
 
     while(!queue.isEmpty()) // Perform a breadth-first search on the graph, starting from "start_vertex"
     {
@@ -30,23 +378,26 @@ graph::Graph graph::Algorithms::bfs(const Graph& g, int start_vertex)
         // std::cout << "Visited " << current << std::endl;
 
         for(Edge* edge = g.getAdjList()[current]; edge != nullptr; edge = edge->next) // Go over all the neighbors of "current", 
-        // And check if they are already marked as visited. If not, mark them as visited (true) and add them to the queue
+        // And check if they are already marked as visited. If not, mark them as visited and add them to the queue
         {
-            if (!visited[edge->dest_vertex])
+            if (depth[edge->dest_vertex] == TraversalTree::UNREACHED)
             {
-                visited[edge->dest_vertex] = true;
+                rooted_tree.discover(edge->dest_vertex, current, edge->weight, depth[current] + 1); // Attach it to the rooted tree
                 queue.enqueue(edge->dest_vertex);
-                rooted_tree.addDirectedEdge(current, edge->dest_vertex, edge->weight); // Add a new directed edge to the rooted tree
             }
         }
     }
     
-    delete[] visited;
     return rooted_tree;
 
 }
 
 graph::Graph graph::Algorithms::dfs(const Graph& g, int start_vertex)
+{
+    return dfsTree(g, start_vertex).toGraph();
+}
+
+graph::TraversalTree graph::Algorithms::dfsTree(const Graph& g, int start_vertex)
 {
     int num_vertices = g.getNumOfVertices();
 
@@ -55,7 +406,7 @@ graph::Graph graph::Algorithms::dfs(const Graph& g, int start_vertex)
         throw std::out_of_range("Invalid start vertex");
     }
 
-    Graph dfs_tree(num_vertices);
+    TraversalTree dfs_tree(num_vertices);
     VertexState* vertex_state = new VertexState[num_vertices]; // Dynamic array to store the state of visit of each vertex of the graph : Unvisited, Visited, Finished
 
     for (int i = 0; i < num_vertices; i++) // Initialize all vertices to Unvisited as default
@@ -63,42 +414,75 @@ graph::Graph graph::Algorithms::dfs(const Graph& g, int start_vertex)
         vertex_state[i] = VertexState::Unvisited;
     }
     
-    dfsVisit(g, start_vertex, vertex_state, dfs_tree);
+    DfsFrame* stack = new DfsFrame[num_vertices]; // One explicit stack shared by every visit of the forest
+
+    dfsVisit(g, start_vertex, vertex_state, dfs_tree, stack);
 
     for (int i = 0; i < num_vertices; i++)
     {
         if (vertex_state[i] == VertexState::Unvisited)
         {
-            dfsVisit(g, i, vertex_state, dfs_tree);
+            dfsVisit(g, i, vertex_state, dfs_tree, stack);
         }
         
     }
     
+    delete[] stack;
     delete[] vertex_state;
     return dfs_tree;
 
 }
 
-void graph::Algorithms::dfsVisit(const Graph& g, int current_vertex, VertexState* vertex_state, Graph& dfs_tree)
+void graph::Algorithms::dfsVisit(const Graph& g, int current_vertex, VertexState* vertex_state, TraversalTree& dfs_tree, DfsFrame* stack)
 {
+    bool own_stack = (stack == nullptr);
+    if (own_stack)
+    {
+        stack = new DfsFrame[g.getNumOfVertices()]; // Every vertex is pushed at most once, so this is enough
+    }
+
     vertex_state[current_vertex] = VertexState::Visited;
+    dfs_tree.discover(current_vertex, -1, 0, 0); // A new root of the forest
+    int top = 0;
+    stack[top++] = {current_vertex, g.getAdjList()[current_vertex]};
 
-    for (Edge* edge = g.getAdjList()[current_vertex]; edge != nullptr; edge = edge->next)
+    while (top > 0)
     {
+        DfsFrame& frame = stack[top - 1]; // The deepest vertex on the current path
+
+        if (frame.next_edge == nullptr) // All neighbors explored, backtrack
+        {
+            vertex_state[frame.vertex] = VertexState::Finished;
+            top--;
+            continue;
+        }
+
+        Edge* edge = frame.next_edge;
+        frame.next_edge = edge->next; // Resume from the following edge when we come back to this vertex
+
         int neighbor = edge->dest_vertex;
         if (vertex_state[neighbor] == VertexState::Unvisited) // If a neighbor is unvisited' it's a tree-edge and we add it to the dfs_tree
         {
-            dfs_tree.addDirectedEdge(current_vertex, edge->dest_vertex, edge->weight);  
-            dfsVisit(g, neighbor, vertex_state, dfs_tree); // Recursively go over the current vertex' neighbors
+            dfs_tree.discover(neighbor, frame.vertex, edge->weight, dfs_tree.distance[frame.vertex] + 1);
+            vertex_state[neighbor] = VertexState::Visited;
+            stack[top++] = {neighbor, g.getAdjList()[neighbor]}; // Go deeper, like the recursive call would
         }
-        
     }
 
-    vertex_state[current_vertex] = VertexState::Finished; 
+    if (own_stack)
+    {
+        delete[] stack;
+    }
+
+}
 
+graph::Graph graph::Algorithms::dijkstra(const Graph& g, int start_vertex, DijkstraEngine engine)
+{
+    // Constructing the shortest path tree as a graph from the parent array
+    return shortestPathTreeGraph(dijkstraTree(g, start_vertex, engine));
 }
 
-graph::Graph graph::Algorithms::dijkstra(const Graph& g, int start_vertex)
+graph::TraversalTree graph::Algorithms::dijkstraTree(const Graph& g, int start_vertex, DijkstraEngine engine)
 {
     int num_vertices = g.getNumOfVertices();
 
@@ -107,67 +491,120 @@ graph::Graph graph::Algorithms::dijkstra(const Graph& g, int start_vertex)
         throw std::out_of_range("Invalid start vertex");
     }
     
-    int* dist = new int[num_vertices]; // The shortest known distance from start_vertex to vertex i
-    int* parent = new int[num_vertices]; // The previous vertex on the shortest path from start_vertex to i
-    bool* visited = new bool[num_vertices]; // Boolean value indicating whether vertex i has been fully processed (shortest distance is known)
-
-    // Initialize distances to INT_MAX and parent indices to -1
-    for (int i = 0; i < num_vertices; i++) {
-
-        dist[i] = INT_MAX;
-        parent[i] = -1;
-        visited[i] = false;
+    int max_weight = 0;
+    if (engine == DijkstraEngine::BucketQueue || engine == DijkstraEngine::Auto) // The bucket queue is sized by the largest weight
+    {
+        int min_weight = 0;
+        for (int i = 0; i < num_vertices; i++)
+        {
+            for (Edge* e = g.getAdjList()[i]; e != nullptr; e = e->next)
+            {
+                min_weight = e->weight < min_weight ? e->weight : min_weight;
+                max_weight = e->weight > max_weight ? e->weight : max_weight;
+            }
+        }
+        engine = resolveDijkstraEngine(engine, min_weight, max_weight);
     }
 
+    TraversalTree shortest_tree(num_vertices); // Its arrays are filled in place, distances start at UNREACHED and parents at -1
+    long long* dist = shortest_tree.distance; // The shortest known distance from start_vertex to vertex i
+    int* parent = shortest_tree.parent; // The previous vertex on the shortest path from start_vertex to i
+    int* parent_weight = shortest_tree.parent_weight; // Weight of the edge parent[i] -> i
+    bool* visited = new bool[num_vertices]{false}; // Boolean value indicating whether vertex i has been fully processed (shortest distance is known)
+
     dist[start_vertex] = 0; // Distance from start_vertex to itself    
 
-    // Main loop of dijkstra algorithm, process each vertex exactly once
-    for (int count = 0; count < num_vertices - 1; count++)
+    // Only the selected engine's queue is built, a queue sized for no vertices would be dead code the optimizer warns about
+    MinHeap* heap = nullptr;
+    BucketQueue* buckets = nullptr;
+    try // Frees the queues and visited if one of them runs out of memory
     {
-        int current = -1;
-        int min_dist = INT_MAX;
+        if (engine == DijkstraEngine::BinaryHeap)
+        {
+            heap = new MinHeap(num_vertices);
+            heap->push(0, start_vertex);
+        }
+        else if (engine == DijkstraEngine::BucketQueue)
+        {
+            buckets = new BucketQueue(num_vertices, max_weight);
+            buckets->pushOrDecrease(start_vertex, 0);
+        }
 
-        // Find the unvisited vertex with the minimum distance
-        for (int i = 0; i < num_vertices; i++)
+        // Main loop of dijkstra algorithm, process each vertex exactly once
+        for (int count = 0; count < num_vertices; count++)
         {
-            if (!visited[i] && dist[i] < min_dist)
+            int current = -1;
+
+            if (engine == DijkstraEngine::LinearScan)
             {
-                min_dist = dist[i];
-                current = i;
+                long long min_dist = TraversalTree::UNREACHED;
+
+                // Find the unvisited vertex with the minimum distance
+                for (int i = 0; i < num_vertices; i++)
+                {
+                    if (!visited[i] && dist[i] < min_dist)
+                    {
+                        min_dist = dist[i];
+                        current = i;
+                    }
+                
+                }
+            }
+            else if (engine == DijkstraEngine::BinaryHeap)
+            {
+                // Pop until an unvisited vertex comes out, older entries of already settled vertices are stale
+                while (!heap->isEmpty() && current == -1)
+                {
+                    int candidate = heap->pop();
+                    if (!visited[candidate])
+                    {
+                        current = candidate;
+                    }
+                }
+            }
+            else if (!buckets->isEmpty()) // Decrease-key keeps a vertex in one bucket, so nothing popped is stale
+            {
+                current = buckets->pop();
             }
-            
-        }
 
-        if (current == -1) break; // All remaining vertices are inaccessible from source_vertex, break the loop
+            if (current == -1) break; // All remaining vertices are inaccessible from source_vertex, break the loop
 
-        visited[current] = true; // Mark the current vertex as visited
+            visited[current] = true; // Mark the current vertex as visited
+            shortest_tree.order[shortest_tree.reached_count++] = current; // Its distance and parent are final now
 
-        // Relaxation step: update the distances to the adjacent vertices
-        for (Edge* e = g.getAdjList()[current]; e != nullptr; e = e->next) // Update distances of adjacent vertices of the current vertex
-        {
-            int neighbor = e->dest_vertex;
-            // Only update if the vertex has not been visited and the new distance is smaller
-            if (!visited[neighbor] && dist[current] != INT_MAX && dist[current] + e->weight < dist[neighbor])
+            // Relaxation step: update the distances to the adjacent vertices
+            for (Edge* e = g.getAdjList()[current]; e != nullptr; e = e->next) // Update distances of adjacent vertices of the current vertex
             {
-                dist[neighbor] = dist[current] + e->weight;
-                parent[neighbor] = current; // Update the parent to reconstruct the path later
+                int neighbor = e->dest_vertex;
+                // Only update if the vertex has not been visited and the new distance is smaller
+                if (!visited[neighbor] && dist[current] + e->weight < dist[neighbor])
+                {
+                    dist[neighbor] = dist[current] + e->weight;
+                    parent[neighbor] = current; // Update the parent to reconstruct the path later
+                    parent_weight[neighbor] = e->weight;
+                    if (engine == DijkstraEngine::BinaryHeap)
+                    {
+                        heap->push(dist[neighbor], neighbor);
+                    }
+                    else if (buckets != nullptr)
+                    {
+                        buckets->pushOrDecrease(neighbor, dist[neighbor]);
+                    }
+                }
             }
         }
     }
-
-    // Constructing the shortest path tree as a graph from the parent array using getWeight() function to get the original edges' weight
-    Graph shortest_tree(num_vertices);
-    for (int i = 0; i < num_vertices; i++)
+    catch (...)
     {
-        if (parent[i] != -1)
-        {
-            shortest_tree.addDirectedEdge(parent[i], i, g.getWeight(parent[i], i));
-        }
+        delete heap;
+        delete buckets;
+        delete[] visited;
+        throw;
     }
 
     // Clean resources
-    delete[] dist;
-    delete[] parent;
+    delete heap;
+    delete buckets;
     delete[] visited;
 
     return shortest_tree;
@@ -175,6 +612,11 @@ graph::Graph graph::Algorithms::dijkstra(const Graph& g, int start_vertex)
 }
 
 graph::Graph graph::Algorithms::prim(const Graph& g)
+{
+    return primForest(g).toGraph();
+}
+
+graph::SpanningForest graph::Algorithms::primForest(const Graph& g)
 {
     int num_vertices = g.getNumOfVertices(); 
     
@@ -229,12 +671,12 @@ graph::Graph graph::Algorithms::prim(const Graph& g)
     }
     
     // Build MST using parent array
-    Graph mst(num_vertices);
+    SpanningForest mst(num_vertices);
     for (int v = 0; v < num_vertices; v++)
     {
         if (parent[v] != -1)
         {
-            mst.addEdge(parent[v], v, g.getWeight(parent[v], v));
+            mst.addEdge(parent[v], v, key[v]); // key[v] is the weight of the edge parent[v] -> v
         }
     }
 
@@ -248,64 +690,21 @@ graph::Graph graph::Algorithms::prim(const Graph& g)
 
 graph::Graph graph::Algorithms::kruskal(const Graph& g)
 {
-    int num_vertices = g.getNumOfVertices();
-    Edge** adj = g.getAdjList(); // A pointer to an array of linked lists (one per vertex)
-
-    // Local struct to hold edges temporarily
-    struct KruskalEdge {
-        int src;
-        int dest;
-        int weight;
-    };
-
-    // Estimate maximum number of unique edges (undirected, no duplicates) (n choose 2)
-    int max_edges = num_vertices * (num_vertices - 1) / 2; // Max possible unique edges (undirected)
-
-    // Allocate edge list
-    KruskalEdge* edge_list = new KruskalEdge[max_edges];
-    int edge_count = 0; 
-
-    // Traverse adjacency list to extract unique edges (i < neighbor avoids duplicates)
-    for (int i = 0; i < num_vertices; i++) // Loop through each vertex i
-    {
-        Edge* current = adj[i];
-        while (current != nullptr) // Loop through i's neighbors using the linked list
-        {
-            int neighbor = current->dest_vertex;
-            int weight = current->weight;
-            if (i < neighbor) // If i < neighbor, store the edge (this avoids storing both (i,j) and (j,i))
-            {
-                edge_list[edge_count++] = {i, neighbor, weight};
-            }
-            current = current->next;
-        }
-        
-    }
+    return kruskalForest(g).toGraph();
+}
 
-    // Sort the edges by weight using selection sort (sort the edge_list by weight)
-    for (int i = 0; i < edge_count -  1; i++) // edge_count is the actual number of unique edges
-    {
-        int min_index = i;
+graph::SpanningForest graph::Algorithms::kruskalForest(const Graph& g)
+{
+    int num_vertices = g.getNumOfVertices();
 
-        for (int j = i + 1; j < edge_count; j++)
-        {
-            if (edge_list[j].weight < edge_list[min_index].weight)
-            {
-                min_index = j;
-            }
-            
-        }
+    int edge_count = 0;
+    KruskalEdge* edge_list = extractUndirectedEdges(g, edge_count);
 
-        if (min_index != i)
-        {
-            KruskalEdge temp = edge_list[i];
-            edge_list[i] = edge_list[min_index];
-            edge_list[min_index] = temp;
-        }
-    }
+    // Sort the edges by weight in linear time
+    radixSortByWeight(edge_list, edge_count);
 
     // Build mst using union find    
-    Graph mst(num_vertices);
+    SpanningForest mst(num_vertices);
     UnionFind uf(num_vertices); 
 
     for (int i = 0; i < edge_count; i++)
@@ -327,3 +726,998 @@ graph::Graph graph::Algorithms::kruskal(const Graph& g)
     return mst;
 }
 
+graph::Graph graph::Algorithms::bfs(const CSRGraph& g, int start_vertex)
+{
+    return bfsTree(g, start_vertex).toGraph();
+}
+
+graph::Graph graph::Algorithms::dfs(const CSRGraph& g, int start_vertex)
+{
+    return dfsTree(g, start_vertex).toGraph();
+}
+
+graph::Graph graph::Algorithms::dijkstra(const CSRGraph& g, int start_vertex, DijkstraEngine engine)
+{
+    return shortestPathTreeGraph(dijkstraTree(g, start_vertex, engine));
+}
+
+graph::Graph graph::Algorithms::prim(const CSRGraph& g)
+{
+    return primForest(g).toGraph();
+}
+
+graph::SpanningForest graph::Algorithms::primForest(const CSRGraph& g)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+
+    int* key = new int[num_vertices];
+    int* parent = new int[num_vertices];
+    bool* inMST = new bool[num_vertices];
+
+    for (int i = 0; i < num_vertices; i++) {
+        key[i] = INT_MAX;
+        parent[i] = -1;
+        inMST[i] = false;
+    }
+
+    if (num_vertices > 0)
+    {
+        key[0] = 0; // Start from vertex 0
+    }
+
+    for (int count = 0; count < num_vertices; count++)
+    {
+        int current = -1;
+        int min_key = INT_MAX;
+
+        for (int i = 0; i < num_vertices; i++)
+        {
+            if (!inMST[i] && key[i] < min_key)
+            {
+                min_key = key[i];
+                current = i;
+            }
+        }
+
+        if (current == -1) break; // All remaining vertices are inaccessible (disconnected components)
+
+        inMST[current] = true;
+
+        for (int i = offsets[current]; i < offsets[current + 1]; i++)
+        {
+            int neighbor = dest_vertices[i];
+            if (!inMST[neighbor] && weights[i] < key[neighbor])
+            {
+                key[neighbor] = weights[i]; // key[neighbor] is also the weight of the edge parent[neighbor] -> neighbor
+                parent[neighbor] = current;
+            }
+        }
+    }
+
+    SpanningForest mst(num_vertices);
+    for (int v = 0; v < num_vertices; v++)
+    {
+        if (parent[v] != -1)
+        {
+            mst.addEdge(parent[v], v, key[v]);
+        }
+    }
+
+    delete[] key;
+    delete[] parent;
+    delete[] inMST;
+
+    return mst;
+
+}
+
+graph::Graph graph::Algorithms::kruskal(const CSRGraph& g)
+{
+    return kruskalForest(g).toGraph();
+}
+
+graph::SpanningForest graph::Algorithms::kruskalForest(const CSRGraph& g)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    int edge_count = 0;
+    KruskalEdge* edge_list = extractUndirectedEdges(g, edge_count);
+
+    radixSortByWeight(edge_list, edge_count);
+
+    SpanningForest mst(num_vertices);
+    UnionFind uf(num_vertices);
+
+    for (int i = 0; i < edge_count; i++)
+    {
+        int src = edge_list[i].src;
+        int dest = edge_list[i].dest;
+
+        if (uf.find(src) != uf.find(dest)) // Only add edge if it connects two different sets (avoids cycles)
+        {
+            uf.unite(src, dest);
+            mst.addEdge(src, dest, edge_list[i].weight);
+        }
+    }
+
+    delete[] edge_list;
+    return mst;
+}
+
+template <int Arity>
+graph::Graph graph::Algorithms::primHeap(const Graph& g)
+{
+    return primHeapForest<Arity>(g).toGraph();
+}
+
+template <int Arity>
+graph::SpanningForest graph::Algorithms::primHeapForest(const Graph& g)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    int* key = new int[num_vertices]; // The minimum weight edge that connects vertex i to the MST
+    int* parent = new int[num_vertices]; // The parent of vertex i in the MST
+    bool* inMST = new bool[num_vertices]; // Is vertex i already included in the MST?
+
+    for (int i = 0; i < num_vertices; i++) {
+        key[i] = INT_MAX;
+        parent[i] = -1;
+        inMST[i] = false;
+    }
+
+    // The heap holds exactly the vertices outside the MST with a finite key, which are the ones
+    // the linear scan in prim() chooses from, so both select the same vertex at every step
+    IndexedHeap<Arity> heap(num_vertices);
+    if (num_vertices > 0)
+    {
+        key[0] = 0; // Start from vertex 0
+        heap.push(0, 0);
+    }
+
+    while (!heap.isEmpty())
+    {
+        int current = heap.pop();
+        inMST[current] = true;
+
+        for (Edge* e = g.getAdjList()[current]; e != nullptr; e = e->next)
+        {
+            int neighbor = e->dest_vertex;
+            if (!inMST[neighbor] && e->weight < key[neighbor])
+            {
+                key[neighbor] = e->weight;
+                parent[neighbor] = current;
+                heap.pushOrDecrease(neighbor, e->weight); // Decrease-key instead of a second heap entry
+            }
+        }
+    }
+
+    SpanningForest mst(num_vertices);
+    for (int v = 0; v < num_vertices; v++)
+    {
+        if (parent[v] != -1)
+        {
+            mst.addEdge(parent[v], v, key[v]); // key[v] is the weight of the edge parent[v] -> v
+        }
+    }
+
+    delete[] key;
+    delete[] parent;
+    delete[] inMST;
+
+    return mst;
+}
+
+template <int Arity>
+graph::Graph graph::Algorithms::primHeap(const CSRGraph& g)
+{
+    return primHeapForest<Arity>(g).toGraph();
+}
+
+template <int Arity>
+graph::SpanningForest graph::Algorithms::primHeapForest(const CSRGraph& g)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+
+    int* key = new int[num_vertices];
+    int* parent = new int[num_vertices];
+    bool* inMST = new bool[num_vertices];
+
+    for (int i = 0; i < num_vertices; i++) {
+        key[i] = INT_MAX;
+        parent[i] = -1;
+        inMST[i] = false;
+    }
+
+    IndexedHeap<Arity> heap(num_vertices);
+    if (num_vertices > 0)
+    {
+        key[0] = 0; // Start from vertex 0
+        heap.push(0, 0);
+    }
+
+    while (!heap.isEmpty())
+    {
+        int current = heap.pop();
+        inMST[current] = true;
+
+        for (int i = offsets[current]; i < offsets[current + 1]; i++)
+        {
+            int neighbor = dest_vertices[i];
+            if (!inMST[neighbor] && weights[i] < key[neighbor])
+            {
+                key[neighbor] = weights[i];
+                parent[neighbor] = current;
+                heap.pushOrDecrease(neighbor, weights[i]);
+            }
+        }
+    }
+
+    SpanningForest mst(num_vertices);
+    for (int v = 0; v < num_vertices; v++)
+    {
+        if (parent[v] != -1)
+        {
+            mst.addEdge(parent[v], v, key[v]);
+        }
+    }
+
+    delete[] key;
+    delete[] parent;
+    delete[] inMST;
+
+    return mst;
+}
+
+// The heap arities available to callers of primHeap
+template graph::Graph graph::Algorithms::primHeap<2>(const Graph& g);
+template graph::Graph graph::Algorithms::primHeap<4>(const Graph& g);
+template graph::Graph graph::Algorithms::primHeap<8>(const Graph& g);
+template graph::Graph graph::Algorithms::primHeap<16>(const Graph& g);
+template graph::Graph graph::Algorithms::primHeap<2>(const CSRGraph& g);
+template graph::Graph graph::Algorithms::primHeap<4>(const CSRGraph& g);
+template graph::Graph graph::Algorithms::primHeap<8>(const CSRGraph& g);
+template graph::Graph graph::Algorithms::primHeap<16>(const CSRGraph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<2>(const Graph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<4>(const Graph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<8>(const Graph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<16>(const Graph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<2>(const CSRGraph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<4>(const CSRGraph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<8>(const CSRGraph& g);
+template graph::SpanningForest graph::Algorithms::primHeapForest<16>(const CSRGraph& g);
+
+graph::Graph graph::Algorithms::boruvka(const Graph& g, int num_threads)
+{
+    return boruvkaForest(g, num_threads).toGraph();
+}
+
+graph::SpanningForest graph::Algorithms::boruvkaForest(const Graph& g, int num_threads)
+{
+    int edge_count = 0;
+    KruskalEdge* edge_list = extractUndirectedEdges(g, edge_count); // In the same order as kruskal(), so ties are broken the same way
+
+    SpanningForest mst = boruvkaOnEdges(edge_list, edge_count, g.getNumOfVertices(), num_threads);
+    delete[] edge_list;
+    return mst;
+}
+
+graph::Graph graph::Algorithms::boruvka(const CSRGraph& g, int num_threads)
+{
+    return boruvkaForest(g, num_threads).toGraph();
+}
+
+graph::SpanningForest graph::Algorithms::boruvkaForest(const CSRGraph& g, int num_threads)
+{
+    int edge_count = 0;
+    KruskalEdge* edge_list = extractUndirectedEdges(g, edge_count);
+
+    SpanningForest mst = boruvkaOnEdges(edge_list, edge_count, g.getNumOfVertices(), num_threads);
+    delete[] edge_list;
+    return mst;
+}
+
+graph::Graph graph::Algorithms::bfsDirectionOptimizing(const Graph& g, int start_vertex, int alpha, int beta)
+{
+    return bfsDirectionOptimizingTree(g, start_vertex, alpha, beta).toGraph();
+}
+
+graph::TraversalTree graph::Algorithms::bfsDirectionOptimizingTree(const Graph& g, int start_vertex, int alpha, int beta)
+{
+    CSRGraph csr(g); // Bottom-up steps scan every unvisited vertex's neighbors, which needs contiguous adjacency
+    return bfsDirectionOptimizingTree(csr, start_vertex, alpha, beta);
+}
+
+graph::Graph graph::Algorithms::bfsDirectionOptimizing(const CSRGraph& g, int start_vertex, int alpha, int beta)
+{
+    return bfsDirectionOptimizingTree(g, start_vertex, alpha, beta).toGraph();
+}
+
+graph::TraversalTree graph::Algorithms::bfsDirectionOptimizingTree(const CSRGraph& g, int start_vertex, int alpha, int beta)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    if (start_vertex < 0 || start_vertex >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+    if (alpha < 1 || beta < 1)
+    {
+        throw std::invalid_argument("alpha and beta must be at least 1");
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+
+    TraversalTree rooted_tree(num_vertices);
+    const long long* depth = rooted_tree.distance; // A vertex is visited once it has a depth
+    int* frontier = new int[num_vertices]; // The current level as a list
+    int* next = new int[num_vertices]; // The level being discovered as a list
+    Bitmap frontier_bits(num_vertices); // The current level as a bitmap, only maintained in bottom-up mode
+    Bitmap next_bits(num_vertices);
+
+    rooted_tree.discover(start_vertex, -1, 0, 0);
+    long long level = 0; // Depth of the current frontier
+    frontier[0] = start_vertex;
+    int frontier_size = 1;
+
+    long long frontier_edges = offsets[start_vertex + 1] - offsets[start_vertex]; // Edges to check from the frontier
+    long long unexplored_edges = static_cast<long long>(g.getNumOfEdges()) - frontier_edges; // Edges of unvisited vertices
+    bool bottom_up = false;
+
+    while (frontier_size > 0)
+    {
+        if (!bottom_up && frontier_edges > unexplored_edges / alpha) // The frontier is large, switch to bottom-up
+        {
+            bottom_up = true;
+            frontier_bits.clear();
+            for (int k = 0; k < frontier_size; k++)
+            {
+                frontier_bits.set(frontier[k]);
+            }
+        }
+        else if (bottom_up && frontier_size < num_vertices / beta) // The frontier has shrunk, back to top-down
+        {
+            bottom_up = false;
+        }
+
+        int next_size = 0;
+        frontier_edges = 0;
+
+        if (!bottom_up)
+        {
+            // Top-down step: every frontier vertex claims its unvisited neighbors
+            for (int k = 0; k < frontier_size; k++)
+            {
+                int current = frontier[k];
+                for (int i = offsets[current]; i < offsets[current + 1]; i++)
+                {
+                    int neighbor = dest_vertices[i];
+                    if (depth[neighbor] == TraversalTree::UNREACHED)
+                    {
+                        rooted_tree.discover(neighbor, current, weights[i], level + 1);
+                        next[next_size++] = neighbor;
+                        frontier_edges += offsets[neighbor + 1] - offsets[neighbor];
+                    }
+                }
+            }
+        }
+        else
+        {
+            // Bottom-up step: every unvisited vertex looks for a parent in the frontier and stops at the first one
+            next_bits.clear();
+            for (int v = 0; v < num_vertices; v++)
+            {
+                if (depth[v] != TraversalTree::UNREACHED) continue;
+
+                for (int i = offsets[v]; i < offsets[v + 1]; i++)
+                {
+                    if (frontier_bits.test(dest_vertices[i]))
+                    {
+                        rooted_tree.discover(v, dest_vertices[i], weights[i], level + 1); // The graph is undirected, v -> parent has the same weight
+                        next_bits.set(v);
+                        next[next_size++] = v;
+                        frontier_edges += offsets[v + 1] - offsets[v];
+                        break;
+                    }
+                }
+            }
+            frontier_bits.swap(next_bits);
+        }
+
+        unexplored_edges -= frontier_edges;
+
+        int* temp = frontier; // The discovered level becomes the frontier
+        frontier = next;
+        next = temp;
+        frontier_size = next_size;
+        level++;
+    }
+
+    delete[] frontier;
+    delete[] next;
+
+    return rooted_tree;
+}
+
+graph::Graph graph::Algorithms::bfsParallel(const Graph& g, int start_vertex, int num_threads)
+{
+    return bfsParallelTree(g, start_vertex, num_threads).toGraph();
+}
+
+graph::TraversalTree graph::Algorithms::bfsParallelTree(const Graph& g, int start_vertex, int num_threads)
+{
+    CSRGraph csr(g); // Threads split frontiers by vertex and read neighbor ranges, which needs contiguous adjacency
+    return bfsParallelTree(csr, start_vertex, num_threads);
+}
+
+graph::Graph graph::Algorithms::bfsParallel(const CSRGraph& g, int start_vertex, int num_threads)
+{
+    return bfsParallelTree(g, start_vertex, num_threads).toGraph();
+}
+
+graph::TraversalTree graph::Algorithms::bfsParallelTree(const CSRGraph& g, int start_vertex, int num_threads)
+{
+    const int VERTICES_PER_THREAD = 1024; // Levels smaller than this per thread are not worth another thread
+
+    int num_vertices = g.getNumOfVertices();
+
+    if (start_vertex < 0 || start_vertex >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+
+    num_threads = resolveThreadCount(num_threads);
+    ThreadTeam team(num_threads); // Started once, every level below runs on the same threads
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+
+    TraversalTree rooted_tree(num_vertices);
+    std::atomic<int>* parent = new std::atomic<int>[num_vertices]; // -1 while unvisited, claimed with compare-and-swap
+    int* parent_weight = rooted_tree.parent_weight; // Written only by the thread that claimed the vertex
+    long long* depth = rooted_tree.distance; // Same, and only read for vertices of finished levels
+    int* order = rooted_tree.order; // All levels one after the other, order[levels_end] starts the next level
+
+    // One growable next-frontier buffer per thread, so threads never share a write position
+    int** local = new int*[num_threads];
+    int* local_size = new int[num_threads];
+    int* local_capacity = new int[num_threads];
+    for (int t = 0; t < num_threads; t++)
+    {
+        local[t] = nullptr;
+        local_size[t] = 0;
+        local_capacity[t] = 0;
+    }
+
+    for (int i = 0; i < num_vertices; i++)
+    {
+        parent[i].store(-1, std::memory_order_relaxed);
+    }
+
+    parent[start_vertex].store(start_vertex, std::memory_order_relaxed); // The root is its own parent while searching
+    depth[start_vertex] = 0;
+    order[0] = start_vertex;
+    int frontier_begin = 0; // The current level is order[frontier_begin .. frontier_end)
+    int frontier_end = 1;
+
+    while (frontier_begin < frontier_end)
+    {
+        int frontier_size = frontier_end - frontier_begin;
+        int level_threads = frontier_size / VERTICES_PER_THREAD + 1;
+        if (level_threads > num_threads)
+        {
+            level_threads = num_threads;
+        }
+
+        team.parallelFor(frontier_begin, frontier_end, level_threads, [&](int t, int first, int last) {
+            local_size[t] = 0;
+            for (int k = first; k < last; k++)
+            {
+                int current = order[k];
+                for (int i = offsets[current]; i < offsets[current + 1]; i++)
+                {
+                    int neighbor = dest_vertices[i];
+                    int expected = -1;
+                    // The cheap load filters out visited vertices before paying for the compare-and-swap
+                    if (parent[neighbor].load(std::memory_order_relaxed) == -1 &&
+                        parent[neighbor].compare_exchange_strong(expected, current, std::memory_order_relaxed))
+                    {
+                        parent_weight[neighbor] = weights[i];
+                        depth[neighbor] = depth[current] + 1;
+
+                        if (local_size[t] == local_capacity[t]) // Grow this thread's buffer
+                        {
+                            int new_capacity = local_capacity[t] < 64 ? 64 : local_capacity[t] * 2;
+                            int* bigger = new int[new_capacity];
+                            for (int j = 0; j < local_size[t]; j++)
+                            {
+                                bigger[j] = local[t][j];
+                            }
+                            delete[] local[t];
+                            local[t] = bigger;
+                            local_capacity[t] = new_capacity;
+                        }
+                        local[t][local_size[t]++] = neighbor;
+                    }
+                }
+            }
+        });
+
+        // Barrier reached (every chunk is done), concatenate the per-thread buffers into the next level
+        int next_end = frontier_end;
+        for (int t = 0; t < level_threads; t++)
+        {
+            for (int j = 0; j < local_size[t]; j++)
+            {
+                order[next_end++] = local[t][j];
+            }
+        }
+
+        frontier_begin = frontier_end;
+        frontier_end = next_end;
+    }
+
+    rooted_tree.reached_count = frontier_end;
+    for (int k = 1; k < frontier_end; k++) // order[0] is the root, its parent stays -1
+    {
+        int v = order[k];
+        rooted_tree.parent[v] = parent[v].load(std::memory_order_relaxed);
+    }
+
+    for (int t = 0; t < num_threads; t++)
+    {
+        delete[] local[t];
+    }
+    delete[] local;
+    delete[] local_size;
+    delete[] local_capacity;
+    delete[] parent;
+
+    return rooted_tree;
+}
+
+graph::Graph graph::Algorithms::deltaStepping(const Graph& g, int start_vertex, long long delta, int num_threads)
+{
+    return shortestPathTreeGraph(deltaSteppingTree(g, start_vertex, delta, num_threads));
+}
+
+graph::TraversalTree graph::Algorithms::deltaSteppingTree(const Graph& g, int start_vertex, long long delta, int num_threads)
+{
+    CSRGraph csr(g); // Threads split frontiers by vertex and read neighbor ranges, which needs contiguous adjacency
+    return deltaSteppingTree(csr, start_vertex, delta, num_threads);
+}
+
+graph::Graph graph::Algorithms::deltaStepping(const CSRGraph& g, int start_vertex, long long delta, int num_threads)
+{
+    return shortestPathTreeGraph(deltaSteppingTree(g, start_vertex, delta, num_threads));
+}
+
+graph::TraversalTree graph::Algorithms::deltaSteppingTree(const CSRGraph& g, int start_vertex, long long delta, int num_threads)
+{
+    const int VERTICES_PER_THREAD = 1024; // Phases smaller than this per thread are not worth another thread
+
+    int num_vertices = g.getNumOfVertices();
+
+    if (start_vertex < 0 || start_vertex >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+    int num_edges = g.getNumOfEdges();
+
+    long long max_weight = 0;
+    for (int i = 0; i < num_edges; i++)
+    {
+        if (weights[i] < 0)
+        {
+            throw std::invalid_argument("Delta-stepping requires non-negative weights");
+        }
+        if (weights[i] > max_weight)
+        {
+            max_weight = weights[i];
+        }
+    }
+    if (delta < 1) // Maximum weight / average degree, so a vertex has about one light edge
+    {
+        double average_degree = static_cast<double>(num_edges) / num_vertices;
+        delta = average_degree > 1 ? static_cast<long long>(max_weight / average_degree) : max_weight;
+        if (delta < 1)
+        {
+            delta = 1;
+        }
+    }
+
+    num_threads = resolveThreadCount(num_threads);
+    if (num_threads > num_vertices) // Every thread owns at least one vertex
+    {
+        num_threads = num_vertices;
+    }
+    // Thread o owns the vertices v with v * num_threads / num_vertices == o: only it updates them and lists them
+    auto owner = [num_threads, num_vertices](int v) {
+        return static_cast<int>(static_cast<long long>(v) * num_threads / num_vertices);
+    };
+    ThreadTeam team(num_threads); // Started once, every phase below runs on the same threads
+
+    TraversalTree shortest_tree(num_vertices); // Its arrays are filled in place, distances start at UNREACHED
+    long long* dist = shortest_tree.distance;
+    int* parent = shortest_tree.parent;
+    int* parent_weight = shortest_tree.parent_weight;
+    int* order = shortest_tree.order; // The settled vertices, bucket by bucket
+
+    LocalBuffer<RelaxRequest>* requests = new LocalBuffer<RelaxRequest>[num_threads * num_threads]; // [thread * num_threads + owner]
+    LocalBuffer<int>* next = new LocalBuffer<int>[num_threads]; // Per owner: vertices improved in the last phase
+    LocalBuffer<int>* far = new LocalBuffer<int>[num_threads]; // Per owner: vertices above the current bucket, may be stale or repeated
+    long long* far_min = new long long[num_threads]; // Per owner: smallest distance in its far list
+    long long* stamp = new long long[num_vertices]; // The last phase that touched each vertex
+    long long* settled_in = new long long[num_vertices]; // The bucket each vertex was appended to order in
+    int* frontier = new int[num_vertices]; // The vertices of the current bucket to relax next
+    for (int v = 0; v < num_vertices; v++)
+    {
+        stamp[v] = -1;
+        settled_in[v] = -1;
+    }
+
+    long long phase = 0; // Numbers the phases, so stamps never have to be cleared
+    long long bucket = 0; // Numbers the buckets processed so far
+    long long bucket_end = delta; // The current bucket holds the distances in [bucket_end - delta, bucket_end)
+
+    // Relaxes the light (or heavy) edges of sources: the threads collect requests, then the owners apply them
+    auto relax = [&](const int* sources, int count, bool light) {
+        phase++;
+        int phase_threads = count / VERTICES_PER_THREAD + 1;
+        if (phase_threads > num_threads)
+        {
+            phase_threads = num_threads;
+        }
+
+        team.parallelFor(0, count, phase_threads, [&](int t, int first, int last) {
+            for (int k = first; k < last; k++)
+            {
+                int current = sources[k];
+                for (int i = offsets[current]; i < offsets[current + 1]; i++)
+                {
+                    if ((weights[i] <= delta) != light) continue;
+                    int neighbor = dest_vertices[i];
+                    long long candidate = dist[current] + weights[i];
+                    if (candidate < dist[neighbor]) // Nothing writes dist while the requests are collected
+                    {
+                        requests[t * num_threads + owner(neighbor)].append({neighbor, current, weights[i], candidate});
+                    }
+                }
+            }
+        });
+
+        team.parallelFor(0, num_threads, phase_threads, [&](int, int first, int last) {
+            for (int o = first; o < last; o++)
+            {
+                for (int t = 0; t < phase_threads; t++)
+                {
+                    LocalBuffer<RelaxRequest>& mine = requests[t * num_threads + o];
+                    for (int j = 0; j < mine.size; j++)
+                    {
+                        const RelaxRequest& request = mine.data[j];
+                        int v = request.vertex;
+                        // Equal distances found in the same phase go to the smaller parent, whatever the thread timing
+                        if (request.distance < dist[v] || (request.distance == dist[v] && stamp[v] == phase && request.parent < parent[v]))
+                        {
+                            if (stamp[v] != phase)
+                            {
+                                stamp[v] = phase;
+                                next[o].append(v);
+                            }
+                            dist[v] = request.distance;
+                            parent[v] = request.parent;
+                            parent_weight[v] = request.weight;
+                        }
+                    }
+                    mine.size = 0;
+                }
+
+                // Improved vertices of the current bucket are relaxed again, the others wait in the far list
+                int kept = 0;
+                for (int j = 0; j < next[o].size; j++)
+                {
+                    int v = next[o].data[j];
+                    if (dist[v] < bucket_end)
+                    {
+                        next[o].data[kept++] = v;
+                    }
+                    else
+                    {
+                        far[o].append(v);
+                    }
+                }
+                next[o].size = kept;
+            }
+        });
+    };
+
+    // Moves the owners' next lists into the frontier, appending newly settled vertices to the order
+    auto gatherFrontier = [&]() {
+        int frontier_size = 0;
+        for (int o = 0; o < num_threads; o++)
+        {
+            for (int j = 0; j < next[o].size; j++)
+            {
+                int v = next[o].data[j];
+                frontier[frontier_size++] = v;
+                if (settled_in[v] != bucket)
+                {
+                    settled_in[v] = bucket;
+                    order[shortest_tree.reached_count++] = v;
+                }
+            }
+            next[o].size = 0;
+        }
+        return frontier_size;
+    };
+
+    dist[start_vertex] = 0;
+    settled_in[start_vertex] = bucket;
+    order[shortest_tree.reached_count++] = start_vertex;
+    frontier[0] = start_vertex;
+    int frontier_size = 1;
+    int bucket_begin = 0; // The vertices settled in the current bucket are order[bucket_begin .. reached_count)
+
+    while (true)
+    {
+        while (frontier_size > 0) // Light edges can lead back into the current bucket, repeat until it is stable
+        {
+            relax(frontier, frontier_size, true);
+            frontier_size = gatherFrontier();
+        }
+        relax(order + bucket_begin, shortest_tree.reached_count - bucket_begin, false); // Heavy edges always leave the bucket
+
+        // Drop the stale and repeated far entries and find the next non-empty bucket
+        phase++;
+        int far_total = 0;
+        for (int o = 0; o < num_threads; o++)
+        {
+            far_total += far[o].size;
+        }
+        int far_threads = far_total / VERTICES_PER_THREAD + 1;
+        if (far_threads > num_threads)
+        {
+            far_threads = num_threads;
+        }
+        team.parallelFor(0, num_threads, far_threads, [&](int, int first, int last) {
+            for (int o = first; o < last; o++)
+            {
+                far_min[o] = TraversalTree::UNREACHED;
+                int kept = 0;
+                for (int j = 0; j < far[o].size; j++)
+                {
+                    int v = far[o].data[j];
+                    if (dist[v] >= bucket_end && stamp[v] != phase) // Below bucket_end the vertex is already settled
+                    {
+                        stamp[v] = phase;
+                        far[o].data[kept++] = v;
+                        if (dist[v] < far_min[o])
+                        {
+                            far_min[o] = dist[v];
+                        }
+                    }
+                }
+                far[o].size = kept;
+            }
+        });
+
+        long long next_min = TraversalTree::UNREACHED;
+        for (int o = 0; o < num_threads; o++)
+        {
+            if (far_min[o] < next_min)
+            {
+                next_min = far_min[o];
+            }
+        }
+        if (next_min == TraversalTree::UNREACHED) break; // No tentative distance left, every reachable vertex is settled
+
+        bucket++;
+        bucket_end = next_min / delta * delta + delta; // Skips the empty buckets in between
+
+        team.parallelFor(0, num_threads, far_threads, [&](int, int first, int last) {
+            for (int o = first; o < last; o++)
+            {
+                int kept = 0;
+                for (int j = 0; j < far[o].size; j++)
+                {
+                    int v = far[o].data[j];
+                    if (dist[v] < bucket_end)
+                    {
+                        next[o].append(v);
+                    }
+                    else
+                    {
+                        far[o].data[kept++] = v;
+                    }
+                }
+                far[o].size = kept;
+            }
+        });
+
+        bucket_begin = shortest_tree.reached_count;
+        frontier_size = gatherFrontier();
+    }
+
+    delete[] requests;
+    delete[] next;
+    delete[] far;
+    delete[] far_min;
+    delete[] stamp;
+    delete[] settled_in;
+    delete[] frontier;
+
+    return shortest_tree;
+}
+
+graph::Path graph::Algorithms::shortestPath(const Graph& g, int source, int target)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    if (source < 0 || source >= num_vertices || target < 0 || target >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    long long* dist = new long long[num_vertices];
+    int* parent = new int[num_vertices];
+    bool* visited = new bool[num_vertices]{false};
+    for (int i = 0; i < num_vertices; i++)
+    {
+        dist[i] = Path::NO_PATH;
+        parent[i] = -1;
+    }
+
+    dist[source] = 0;
+    MinHeap heap(64); // Grows with the search, which usually stays far smaller than the graph
+    heap.push(0, source);
+
+    while (!heap.isEmpty())
+    {
+        int current = heap.pop();
+        if (visited[current]) continue; // A stale entry of an already settled vertex
+        visited[current] = true;
+        if (current == target) break; // Settled, so its distance and path are final
+
+        for (Edge* e = g.getAdjList()[current]; e != nullptr; e = e->next)
+        {
+            int neighbor = e->dest_vertex;
+            if (!visited[neighbor] && dist[current] + e->weight < dist[neighbor])
+            {
+                dist[neighbor] = dist[current] + e->weight;
+                parent[neighbor] = current;
+                heap.push(dist[neighbor], neighbor);
+            }
+        }
+    }
+
+    Path path(parent, target, dist[target]);
+
+    delete[] dist;
+    delete[] parent;
+    delete[] visited;
+
+    return path;
+}
+
+graph::Path graph::Algorithms::shortestPath(const CSRGraph& g, int source, int target)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    if (source < 0 || source >= num_vertices || target < 0 || target >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+
+    long long* dist = new long long[num_vertices];
+    int* parent = new int[num_vertices];
+    bool* visited = new bool[num_vertices]{false};
+    for (int i = 0; i < num_vertices; i++)
+    {
+        dist[i] = Path::NO_PATH;
+        parent[i] = -1;
+    }
+
+    dist[source] = 0;
+    MinHeap heap(64); // Grows with the search, which usually stays far smaller than the graph
+    heap.push(0, source);
+
+    while (!heap.isEmpty())
+    {
+        int current = heap.pop();
+        if (visited[current]) continue; // A stale entry of an already settled vertex
+        visited[current] = true;
+        if (current == target) break; // Settled, so its distance and path are final
+
+        for (int i = offsets[current]; i < offsets[current + 1]; i++)
+        {
+            int neighbor = dest_vertices[i];
+            if (!visited[neighbor] && dist[current] + weights[i] < dist[neighbor])
+            {
+                dist[neighbor] = dist[current] + weights[i];
+                parent[neighbor] = current;
+                heap.push(dist[neighbor], neighbor);
+            }
+        }
+    }
+
+    Path path(parent, target, dist[target]);
+
+    delete[] dist;
+    delete[] parent;
+    delete[] visited;
+
+    return path;
+}
+
+graph::Path graph::Algorithms::bidirectionalShortestPath(const Graph& g, const Graph& reverse, int source, int target)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    if (reverse.getNumOfVertices() != num_vertices)
+    {
+        throw std::invalid_argument("The reverse graph must have the same vertices as the graph.");
+    }
+    if (source < 0 || source >= num_vertices || target < 0 || target >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    auto edges_of = [](const Graph& graph_side)
+    {
+        return [&graph_side](int vertex, auto& relax)
+        {
+            for (Edge* e = graph_side.getAdjList()[vertex]; e != nullptr; e = e->next)
+            {
+                relax(e->dest_vertex, e->weight);
+            }
+        };
+    };
+    return bidirectionalSearch(num_vertices, source, target, edges_of(g), edges_of(reverse));
+}
+
+graph::Path graph::Algorithms::bidirectionalShortestPath(const CSRGraph& g, const CSRGraph& reverse, int source, int target)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    if (reverse.getNumOfVertices() != num_vertices)
+    {
+        throw std::invalid_argument("The reverse graph must have the same vertices as the graph.");
+    }
+    if (source < 0 || source >= num_vertices || target < 0 || target >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    auto edges_of = [](const CSRGraph& graph_side)
+    {
+        return [&graph_side](int vertex, auto& relax)
+        {
+            const int* offsets = graph_side.getOffsets();
+            const int* dest_vertices = graph_side.getDestVertices();
+            const int* weights = graph_side.getWeights();
+            for (int i = offsets[vertex]; i < offsets[vertex + 1]; i++)
+            {
+                relax(dest_vertices[i], weights[i]);
+            }
+        };
+    };
+    return bidirectionalSearch(num_vertices, source, target, edges_of(g), edges_of(reverse));
+}
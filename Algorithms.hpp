@@ -3,13 +3,93 @@
 
 #pragma once
 #include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "TraversalTree.hpp"
+#include "SpanningForest.hpp"
+#include "Path.hpp"
+#include "VertexCoordinates.hpp"
+#include "MinHeap.hpp"
+#include "BucketQueue.hpp"
+#include "DijkstraScratch.hpp"
+#include "LaneMask.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
 
 namespace graph {
 
+    /**
+     * @brief Selects how Dijkstra's algorithm finds the next vertex to settle.
+     * 
+     * LinearScan and BinaryHeap settle vertices in the same order (smallest distance, then smallest index),
+     * so they produce the same shortest path tree. BucketQueue settles vertices of equal distance in
+     * bucket order instead: the distances are the same, but of several equally short paths to a vertex
+     * it may keep a different one.
+     */
+
+    enum class DijkstraEngine
+    {
+        LinearScan, // Scans all vertices for the minimum distance, O(V^2)
+        BinaryHeap, // Binary heap with lazy deletion, O((V + E) log V)
+        BucketQueue, // Dial's bucket queue, O(V + E + D) for the largest distance D; non-negative integer weights only
+        Auto // BucketQueue if the weights are integers in 0 .. DIJKSTRA_BUCKET_MAX_WEIGHT, BinaryHeap otherwise
+    };
+
+    constexpr long long DIJKSTRA_BUCKET_MAX_WEIGHT = 1024; // Above this, Auto prefers the heap to walking empty buckets
+
+    /**
+     * @brief Resolves the Auto engine from the range of the edge weights, and checks that BucketQueue can be used.
+     * @param engine The requested engine.
+     * @param min_weight The smallest edge weight (0 for a graph without edges).
+     * @param max_weight The largest edge weight (0 for a graph without edges).
+     * @return The engine to run (never Auto).
+     * @throws std::invalid_argument if BucketQueue is requested for a graph with a negative weight.
+     */
+
+    inline DijkstraEngine resolveDijkstraEngine(DijkstraEngine engine, long long min_weight, long long max_weight)
+    {
+        if (engine == DijkstraEngine::Auto)
+        {
+            return min_weight >= 0 && max_weight <= DIJKSTRA_BUCKET_MAX_WEIGHT ? DijkstraEngine::BucketQueue : DijkstraEngine::BinaryHeap;
+        }
+        if (engine == DijkstraEngine::BucketQueue && min_weight < 0)
+        {
+            throw std::invalid_argument("The bucket queue engine needs non-negative weights");
+        }
+        return engine;
+    }
+
+    /**
+     * @brief One entry of the explicit DFS stack over a Graph: a vertex and the next edge of it to explore.
+     */
+
+    struct DfsFrame {
+        int vertex; // The vertex being explored
+        Edge* next_edge; // The next edge of vertex to look at, nullptr when all are done
+    };
+
+    /**
+     * @brief One entry of the explicit DFS stack over a BasicCSRGraph: a vertex and the next edge index of it to explore.
+     */
+
+    template <typename VertexId, typename EdgeId>
+    struct BasicCSRDfsFrame {
+        VertexId vertex; // The vertex being explored
+        EdgeId next_index; // Index into the CSR arrays of the next edge of vertex to look at
+    };
+
+    using CSRDfsFrame = BasicCSRDfsFrame<int, int>; // The DFS stack entry over a CSRGraph
+
     /**
      * @brief A utility class containing static graph algorithms such as BFS, DFS, Dijkstra, Prim, and Kruskal.
      * 
      * This class cannot be instantiated. All methods are static and operate on the Graph class.
+     * 
+     * Every algorithm has a variant that fills a flat result (TraversalTree or SpanningForest) and one that
+     * converts that result into a Graph, as the original interface did. Prefer the flat variant when only
+     * parents or distances are needed, it skips allocating an edge node per tree edge.
      */
 
     class Algorithms 
@@ -27,6 +107,89 @@ namespace graph {
 
         static Graph bfs(const Graph& g, int start_vertex);
 
+        /**
+         * @brief Performs BFS and returns the tree as flat arrays.
+         * 
+         * Distances are numbers of edges from start_vertex, and the order is the BFS discovery order.
+         * 
+         * @param g The input graph (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @return The BFS tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        static TraversalTree bfsTree(const Graph& g, int start_vertex);
+
+        /**
+         * @brief Performs a direction-optimizing BFS (top-down and bottom-up steps) from a given vertex.
+         * 
+         * Freezes g into a CSRGraph and runs the CSRGraph overload.
+         * 
+         * @param g The input graph (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param alpha Switch to bottom-up when the frontier's edges exceed the unexplored edges / alpha (default is 15).
+         * @param beta Switch back to top-down when the frontier has fewer than num_vertices / beta vertices (default is 18).
+         * @return A rooted tree as a directed graph representing the BFS traversal rooted at start_vertex.
+         */
+
+        static Graph bfsDirectionOptimizing(const Graph& g, int start_vertex, int alpha = 15, int beta = 18);
+
+        /**
+         * @brief Performs a direction-optimizing BFS and returns the tree as flat arrays.
+         * 
+         * @param g The input graph (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param alpha Top-down to bottom-up switch threshold (default is 15).
+         * @param beta Bottom-up to top-down switch threshold (default is 18).
+         * @return The BFS tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if alpha or beta is smaller than 1.
+         */
+
+        static TraversalTree bfsDirectionOptimizingTree(const Graph& g, int start_vertex, int alpha = 15, int beta = 18);
+
+        /**
+         * @brief Performs a level-synchronous BFS on several threads from a given vertex.
+         * 
+         * Freezes g into a CSRGraph and runs the CSRGraph overload.
+         * 
+         * @param g The input graph (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return A rooted tree as a directed graph representing the BFS traversal rooted at start_vertex.
+         */
+
+        static Graph bfsParallel(const Graph& g, int start_vertex, int num_threads = 0);
+
+        /**
+         * @brief Performs a level-synchronous BFS on several threads and returns the tree as flat arrays.
+         * 
+         * @param g The input graph (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return The BFS tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        static TraversalTree bfsParallelTree(const Graph& g, int start_vertex, int num_threads = 0);
+
+        /**
+         * @brief Runs BFS from many sources at once, sharing every adjacency list scan among them.
+         * 
+         * Freezes g into a CSRGraph once, see multiSourceBfs(const CSRGraph&, ...).
+         * 
+         * @tparam Lanes Number of BFSs run together, 64, 256 or 512 (default is 64).
+         * @tparam Callback A callable taking (int source_index, int vertex, int level).
+         * @param g The input graph (weights are ignored).
+         * @param sources The source vertices, repeats allowed.
+         * @param num_sources Number of entries in sources.
+         * @param callback Called once for every vertex reached from every source, with its hop distance.
+         * @throws std::out_of_range if a source is invalid (before any search starts).
+         */
+
+        template <int Lanes = 64, typename Callback>
+        static void multiSourceBfs(const Graph& g, const int* sources, int num_sources, Callback callback);
+
         /**
          * @brief Performs Depth-First Search (DFS) from a given start vertex.
          * 
@@ -40,27 +203,168 @@ namespace graph {
         static Graph dfs(const Graph& g, int start_vertex);
 
         /**
-         * @brief Helper function for performing a recursive DFS visit.
+         * @brief Performs DFS from a given start vertex, covering all components, and returns the forest as flat arrays.
          * 
-         * Marks vertices and builds the DFS tree as recursion progresses.
+         * Every vertex is reached. Roots (start_vertex, then the first unvisited vertex of every other component)
+         * have parent -1 and distance 0. Distances are depths in the forest, and the order is the DFS discovery order.
          * 
          * @param g The input graph.
-         * @param current_vertex The vertex currently being visited.
+         * @param start_vertex The starting vertex for the DFS traversal.
+         * @return The DFS forest.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        static TraversalTree dfsTree(const Graph& g, int start_vertex);
+
+        /**
+         * @brief Helper function for performing a DFS visit from one vertex.
+         * 
+         * Marks vertices and records them in the DFS forest in the same order as a recursive DFS would, but keeps
+         * the path on an explicit stack, so deep graphs (long chains) cannot overflow the call stack.
+         * 
+         * @param g The input graph.
+         * @param current_vertex The vertex to start the visit from (becomes a root of the forest).
          * @param vertex_state An array of states (Unvisited, Visited, Finished).
-         * @param dfs_tree The tree/forest being constructed during DFS.
+         * @param dfs_tree The forest being filled during DFS.
+         * @param stack A buffer of at least g.getNumOfVertices() frames, reused across calls.
+         * If nullptr (default), a buffer is allocated for this call.
          */
 
-        static void dfsVisit(const Graph& g, int current_vertex, VertexState* vertex_state, Graph& dfs_tree); 
+        static void dfsVisit(const Graph& g, int current_vertex, VertexState* vertex_state, TraversalTree& dfs_tree, DfsFrame* stack = nullptr);
 
         /**
          * @brief Computes the shortest path tree from a start vertex using Dijkstra's algorithm.
          * 
          * @param g The input graph.
          * @param start_vertex The source vertex.
+         * @param engine How the next vertex is selected (default is BinaryHeap).
+         * @return A directed graph representing the shortest path tree.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if BucketQueue is requested for a graph with a negative weight.
+         */
+
+        static Graph dijkstra(const Graph& g, int start_vertex, DijkstraEngine engine = DijkstraEngine::BinaryHeap);
+
+        /**
+         * @brief Computes the shortest path tree from a start vertex and returns it as flat arrays.
+         * 
+         * Distances are summed in 64 bits, so long paths of large weights do not overflow.
+         * The order is the order in which the vertices were settled.
+         * 
+         * @param g The input graph.
+         * @param start_vertex The source vertex.
+         * @param engine How the next vertex is selected (default is BinaryHeap).
+         * @return The shortest path tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if BucketQueue is requested for a graph with a negative weight.
+         */
+
+        static TraversalTree dijkstraTree(const Graph& g, int start_vertex, DijkstraEngine engine = DijkstraEngine::BinaryHeap);
+
+        /**
+         * @brief Computes the shortest path tree from a start vertex with parallel delta-stepping.
+         * 
+         * Freezes g into a CSRGraph first, see deltaSteppingTree(const CSRGraph&, ...).
+         * 
+         * @param g The input graph (non-negative weights).
+         * @param start_vertex The source vertex.
+         * @param delta Bucket width, values below 1 choose it from the weights (default).
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
          * @return A directed graph representing the shortest path tree.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if an edge has a negative weight.
          */
 
-        static Graph dijkstra(const Graph& g, int start_vertex);
+        static Graph deltaStepping(const Graph& g, int start_vertex, long long delta = 0, int num_threads = 0);
+
+        /**
+         * @brief Computes the shortest path tree with parallel delta-stepping and returns it as flat arrays.
+         * 
+         * @param g The input graph (non-negative weights).
+         * @param start_vertex The source vertex.
+         * @param delta Bucket width, values below 1 choose it from the weights (default).
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return The shortest path tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if an edge has a negative weight.
+         */
+
+        static TraversalTree deltaSteppingTree(const Graph& g, int start_vertex, long long delta = 0, int num_threads = 0);
+
+        /**
+         * @brief Finds a shortest path between two vertices with Dijkstra's algorithm, stopping as soon as the target is settled.
+         * 
+         * Only the vertices closer to the source than the target are settled, instead of the whole graph.
+         * The adjacency lists are searched directly, a query does not freeze the graph.
+         * 
+         * @param g The input graph (non-negative weights).
+         * @param source The first vertex of the path.
+         * @param target The last vertex of the path.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        static Path shortestPath(const Graph& g, int source, int target);
+
+        /**
+         * @brief Finds a shortest path between two vertices with bidirectional Dijkstra.
+         * 
+         * One search grows forward from source over g, the other backward from target over the reverse graph,
+         * always advancing the one with the smaller radius. The query stops once the two radii add up to at least
+         * the best path found through a vertex both searches reached, which usually settles far fewer vertices than
+         * shortestPath(). Build the reverse once with g.reversed() and reuse it for every query; an undirected graph
+         * is its own reverse, so g can be passed twice.
+         * 
+         * @param g The input graph (non-negative weights).
+         * @param reverse The reverse of g (g.reversed(), or g itself if it is undirected).
+         * @param source The first vertex of the path.
+         * @param target The last vertex of the path.
+         * @return The path and its cost, or an empty path if target is not reachable from source. The cost is the same as shortestPath(), the path may be another one of equal cost.
+         * @throws std::out_of_range if source or target is invalid.
+         * @throws std::invalid_argument if reverse does not have the same number of vertices as g.
+         */
+
+        static Path bidirectionalShortestPath(const Graph& g, const Graph& reverse, int source, int target);
+
+        /**
+         * @brief Finds a shortest path between two vertices with A* search, guided towards the target by a heuristic.
+         * 
+         * Like shortestPath(), but vertices are settled in order of distance from source plus heuristic(vertex),
+         * so the search heads for the target instead of growing evenly in every direction.
+         * The heuristic must be consistent: heuristic(u) <= weight(u, v) + heuristic(v) for every edge, and
+         * heuristic(target) == 0 (EuclideanHeuristic and ManhattanHeuristic are, for suitable weights).
+         * A heuristic that always returns 0 makes this shortestPath().
+         * 
+         * @tparam Heuristic A callable taking a vertex and returning a long long lower bound on its cost to target.
+         *         It is a template parameter so the call is inlined into the search loop.
+         * @param g The input graph (non-negative weights).
+         * @param source The first vertex of the path.
+         * @param target The last vertex of the path.
+         * @param heuristic The estimate of the remaining cost from a vertex to target.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        template <typename Heuristic>
+        static Path aStar(const Graph& g, int source, int target, Heuristic heuristic);
+
+        /**
+         * @brief Runs Dijkstra's algorithm from many sources on several threads and streams each result to a callback.
+         * 
+         * Freezes g into a CSRGraph once, see dijkstraBatch(const CSRGraph&, ...).
+         * 
+         * @tparam Callback A callable taking (int source_index, const DijkstraScratch& result).
+         * @param g The input graph (non-negative weights).
+         * @param sources The source vertices, repeats allowed.
+         * @param num_sources Number of entries in sources.
+         * @param callback Called once per source with the finished run.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @throws std::out_of_range if a source is invalid (before any search starts).
+         * @throws std::bad_alloc if the scratch buffers cannot be allocated; an exception from the callback is rethrown.
+         */
+
+        template <typename Callback>
+        static void dijkstraBatch(const Graph& g, const int* sources, int num_sources, Callback callback, int num_threads = 0);
 
         /**
          * @brief Computes the Minimum Spanning Tree (MST) using Prim's algorithm.
@@ -73,6 +377,40 @@ namespace graph {
 
         static Graph prim(const Graph& g);
 
+        /**
+         * @brief Computes the MST using Prim's algorithm and returns its edges as a flat list.
+         * 
+         * @param g The input graph.
+         * @return The MST (or forest), with the edges listed by ascending vertex.
+         */
+
+        static SpanningForest primForest(const Graph& g);
+
+        /**
+         * @brief Computes the MST using Prim's algorithm driven by an indexed d-ary heap, in O(E log V).
+         * 
+         * Selects vertices in the same order as prim() and returns the same tree.
+         * Instantiated for Arity 2, 4, 8 and 16.
+         * 
+         * @tparam Arity Number of children per heap node (default is 4).
+         * @param g The input graph.
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        template <int Arity = 4>
+        static Graph primHeap(const Graph& g);
+
+        /**
+         * @brief Computes the MST using heap-based Prim and returns its edges as a flat list.
+         * 
+         * @tparam Arity Number of children per heap node (default is 4).
+         * @param g The input graph.
+         * @return The MST (or forest), with the edges listed by ascending vertex.
+         */
+
+        template <int Arity = 4>
+        static SpanningForest primHeapForest(const Graph& g);
+
         /**
          * @brief Computes the Minimum Spanning Tree (MST) using Kruskal's algorithm.
          * 
@@ -84,5 +422,926 @@ namespace graph {
 
         static Graph kruskal(const Graph& g);
 
+        /**
+         * @brief Computes the MST using Kruskal's algorithm and returns its edges as a flat list.
+         * 
+         * @param g The input graph.
+         * @return The MST (or forest), with the edges listed in the order Kruskal accepted them.
+         */
+
+        static SpanningForest kruskalForest(const Graph& g);
+
+        /**
+         * @brief Computes the Minimum Spanning Tree (MST) using Borůvka's algorithm on several threads.
+         * 
+         * Each round finds the cheapest edge leaving every component in parallel, then contracts the
+         * components with Union-Find. Ties are broken like kruskal(), so the result has the same edges.
+         * Works on connected or disconnected graphs (returns a forest).
+         * 
+         * @param g The input graph.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        static Graph boruvka(const Graph& g, int num_threads = 0);
+
+        /**
+         * @brief Computes the MST using Borůvka's algorithm on several threads and returns its edges as a flat list.
+         * 
+         * @param g The input graph.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return The MST (or forest), with the edges listed in the order they were contracted.
+         */
+
+        static SpanningForest boruvkaForest(const Graph& g, int num_threads = 0);
+
+        /**
+         * @brief Performs BFS over a frozen CSR graph.
+         * 
+         * Produces the same rooted tree as bfs(const Graph&, int) on the graph it was frozen from.
+         * 
+         * @param g The input graph in CSR form (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @return A rooted tree as a directed graph representing the BFS traversal rooted at start_vertex.
+         */
+
+        static Graph bfs(const CSRGraph& g, int start_vertex);
+
+        /**
+         * @brief Performs BFS over a frozen CSR graph of any vertex id and weight type, and returns the tree as flat arrays.
+         * 
+         * Produces the same tree as bfsTree(const Graph&, int) on the graph it was frozen from.
+         * Distances are numbers of edges, so a NoWeight graph is enough.
+         * 
+         * @param g The input graph in CSR form (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @return The BFS tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        template <typename VertexId, typename Weight, typename EdgeId>
+        static BasicTraversalTree<VertexId, Weight> bfsTree(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, typename BasicCSRGraph<VertexId, Weight, EdgeId>::VertexType start_vertex);
+
+        /**
+         * @brief Performs a direction-optimizing BFS over a frozen CSR graph.
+         * 
+         * Small frontiers are expanded top-down (each frontier vertex claims its unvisited neighbors).
+         * Once the frontier touches more than 1/alpha of the unexplored edges, levels are expanded bottom-up:
+         * every unvisited vertex looks for any neighbor in the frontier bitmap and stops at the first one.
+         * When the frontier drops below num_vertices / beta vertices it goes back to top-down.
+         * 
+         * Every vertex gets the same depth as in bfs(). A vertex with several parents on the previous level
+         * may be attached to a different one of them than in bfs(), so the tree is a valid BFS tree
+         * but not necessarily the identical one.
+         * 
+         * @param g The input graph in CSR form (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param alpha Top-down to bottom-up switch threshold (default is 15).
+         * @param beta Bottom-up to top-down switch threshold (default is 18).
+         * @return A rooted tree as a directed graph representing the BFS traversal rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if alpha or beta is smaller than 1.
+         */
+
+        static Graph bfsDirectionOptimizing(const CSRGraph& g, int start_vertex, int alpha = 15, int beta = 18);
+
+        /**
+         * @brief Performs a direction-optimizing BFS over a frozen CSR graph and returns the tree as flat arrays.
+         * 
+         * @param g The input graph in CSR form (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param alpha Top-down to bottom-up switch threshold (default is 15).
+         * @param beta Bottom-up to top-down switch threshold (default is 18).
+         * @return The BFS tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if alpha or beta is smaller than 1.
+         */
+
+        static TraversalTree bfsDirectionOptimizingTree(const CSRGraph& g, int start_vertex, int alpha = 15, int beta = 18);
+
+        /**
+         * @brief Performs a level-synchronous BFS on several threads over a frozen CSR graph.
+         * 
+         * Each level's frontier is split between the threads. A thread claims an unvisited neighbor with an
+         * atomic compare-and-swap on the parent array and appends it to its own next-frontier buffer;
+         * the buffers are concatenated once all threads are done with the level. The threads are started
+         * once per call (a ThreadTeam) and wait on a barrier between levels. Small levels run on fewer
+         * threads, since waking a thread costs more than expanding a few vertices.
+         * 
+         * Every vertex gets the same depth as in bfs(). Which parent wins for a vertex reachable from several
+         * frontier vertices depends on thread timing, so the tree is a valid BFS tree but not always the identical one.
+         * 
+         * @param g The input graph in CSR form (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return A rooted tree as a directed graph representing the BFS traversal rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        static Graph bfsParallel(const CSRGraph& g, int start_vertex, int num_threads = 0);
+
+        /**
+         * @brief Performs a level-synchronous BFS on several threads over a frozen CSR graph and returns the tree as flat arrays.
+         * 
+         * @param g The input graph in CSR form (undirected).
+         * @param start_vertex The vertex to begin the BFS traversal from.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return The BFS tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        static TraversalTree bfsParallelTree(const CSRGraph& g, int start_vertex, int num_threads = 0);
+
+        /**
+         * @brief Runs BFS from many sources of a frozen CSR graph at once (MS-BFS), sharing every adjacency list
+         * scan among them.
+         * 
+         * The sources are taken Lanes at a time. Every vertex keeps three LaneMasks, one bit per BFS of the batch:
+         * the BFSs that have seen it, that visit it in the current level, and that reach it in the next one.
+         * A frontier vertex ORs its visit mask into each neighbor's next mask, so one pass over its edges advances
+         * every BFS that visits it in this level, instead of one pass per BFS. When many sources reach the same
+         * vertices at similar levels (closeness centrality, all-pairs hop distances on small-world graphs), the
+         * edge reads, which dominate BFS, drop by up to a factor of Lanes. Wider masks share more but cost
+         * Lanes / 8 bytes per vertex and mask.
+         * 
+         * Within a batch the callback sees the reached pairs level by level; batches run one after the other.
+         * 
+         * @tparam Lanes Number of BFSs run together, 64, 256 or 512 (default is 64).
+         * @tparam Callback A callable taking (int source_index, int vertex, int level).
+         * @param g The input graph in CSR form (weights are ignored).
+         * @param sources The source vertices, repeats allowed.
+         * @param num_sources Number of entries in sources.
+         * @param callback Called once for every vertex reached from every source, with its hop distance.
+         * @throws std::out_of_range if a source is invalid (before any search starts).
+         */
+
+        template <int Lanes = 64, typename Callback>
+        static void multiSourceBfs(const CSRGraph& g, const int* sources, int num_sources, Callback callback);
+
+        /**
+         * @brief Performs DFS over a frozen CSR graph, covering all components (forest).
+         * 
+         * @param g The input graph in CSR form.
+         * @param start_vertex The starting vertex for the DFS traversal.
+         * @return A directed graph representing the DFS tree or forest.
+         */
+
+        static Graph dfs(const CSRGraph& g, int start_vertex);
+
+        /**
+         * @brief Performs DFS over a frozen CSR graph of any vertex id and weight type, covering all components,
+         * and returns the forest as flat arrays.
+         * 
+         * @param g The input graph in CSR form.
+         * @param start_vertex The starting vertex for the DFS traversal.
+         * @return The DFS forest.
+         * @throws std::out_of_range if start_vertex is invalid.
+         */
+
+        template <typename VertexId, typename Weight, typename EdgeId>
+        static BasicTraversalTree<VertexId, Weight> dfsTree(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, typename BasicCSRGraph<VertexId, Weight, EdgeId>::VertexType start_vertex);
+
+        /**
+         * @brief Helper function for performing a DFS visit over a CSR graph, with an explicit stack.
+         * 
+         * @param g The input graph in CSR form.
+         * @param current_vertex The vertex to start the visit from (becomes a root of the forest).
+         * @param vertex_state An array of states (Unvisited, Visited, Finished).
+         * @param dfs_tree The forest being filled during DFS.
+         * @param stack A buffer of at least g.getNumOfVertices() frames, reused across calls.
+         * If nullptr (default), a buffer is allocated for this call.
+         */
+
+        template <typename VertexId, typename Weight, typename EdgeId>
+        static void dfsVisit(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, VertexId current_vertex, VertexState* vertex_state,
+                             BasicTraversalTree<VertexId, Weight>& dfs_tree, BasicCSRDfsFrame<VertexId, EdgeId>* stack = nullptr);
+
+        /**
+         * @brief Computes the shortest path tree over a frozen CSR graph using Dijkstra's algorithm.
+         * 
+         * @param g The input graph in CSR form.
+         * @param start_vertex The source vertex.
+         * @param engine How the next vertex is selected (default is BinaryHeap).
+         * @return A directed graph representing the shortest path tree.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if BucketQueue is requested for a graph with a negative weight.
+         */
+
+        static Graph dijkstra(const CSRGraph& g, int start_vertex, DijkstraEngine engine = DijkstraEngine::BinaryHeap);
+
+        /**
+         * @brief Computes the shortest path tree over a frozen CSR graph of any vertex id and weight type,
+         * and returns it as flat arrays.
+         * 
+         * Distances are summed in WeightTraits<Weight>::Distance (64-bit integers, or double for floating
+         * point weights). On a NoWeight graph every edge has length 1, so Auto always picks BucketQueue;
+         * with floating point weights Auto picks BinaryHeap.
+         * 
+         * @param g The input graph in CSR form.
+         * @param start_vertex The source vertex.
+         * @param engine How the next vertex is selected (default is BinaryHeap).
+         * @return The shortest path tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if BucketQueue is requested for a graph with negative or floating point weights.
+         */
+
+        template <typename VertexId, typename Weight, typename EdgeId>
+        static BasicTraversalTree<VertexId, Weight> dijkstraTree(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, typename BasicCSRGraph<VertexId, Weight, EdgeId>::VertexType start_vertex,
+                                                                 DijkstraEngine engine = DijkstraEngine::BinaryHeap);
+
+        /**
+         * @brief Computes the shortest path tree over a frozen CSR graph with parallel delta-stepping (Meyer and Sanders).
+         * 
+         * Tentative distances are kept in buckets of width delta. The lowest non-empty bucket is settled in
+         * phases: its vertices relax their light edges (weight <= delta) until no distance in the bucket
+         * changes, then every vertex settled in the bucket relaxes its heavy edges once. Within a phase the
+         * frontier is split between the threads, which write relaxation requests into per-thread buffers;
+         * each thread then applies the requests for its own block of vertices, so no two threads ever write
+         * the same vertex and no atomics are needed. Buckets above the current one are kept in one
+         * unsorted "far" list per thread and split when the current bucket is done, so empty buckets cost nothing.
+         * The threads are started once per call (a ThreadTeam) and wait on a barrier between phases.
+         * 
+         * Distances are the same as dijkstraTree(). Ties between equally short paths are broken towards
+         * the smaller parent within a phase, so the tree does not depend on the number of threads,
+         * but it can differ from Dijkstra's. The order lists the vertices bucket by bucket.
+         * 
+         * With delta below 1 the bucket width is the maximum weight divided by the average degree
+         * (at least 1), the choice Meyer and Sanders analyze: about one light edge per vertex.
+         * A small delta approaches Dijkstra (little parallelism per bucket), a large delta approaches
+         * Bellman-Ford (much parallelism, many re-relaxations).
+         * 
+         * @param g The input graph in CSR form (non-negative weights).
+         * @param start_vertex The source vertex.
+         * @param delta Bucket width, values below 1 choose it from the weights (default).
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return A directed graph representing the shortest path tree.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if an edge has a negative weight.
+         */
+
+        static Graph deltaStepping(const CSRGraph& g, int start_vertex, long long delta = 0, int num_threads = 0);
+
+        /**
+         * @brief Computes the shortest path tree over a frozen CSR graph with parallel delta-stepping
+         * and returns it as flat arrays.
+         * 
+         * @param g The input graph in CSR form (non-negative weights).
+         * @param start_vertex The source vertex.
+         * @param delta Bucket width, values below 1 choose it from the weights (default).
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return The shortest path tree rooted at start_vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if an edge has a negative weight.
+         */
+
+        static TraversalTree deltaSteppingTree(const CSRGraph& g, int start_vertex, long long delta = 0, int num_threads = 0);
+
+        /**
+         * @brief Finds a shortest path between two vertices of a frozen CSR graph, stopping as soon as the target is settled.
+         * 
+         * @param g The input graph in CSR form (non-negative weights).
+         * @param source The first vertex of the path.
+         * @param target The last vertex of the path.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        static Path shortestPath(const CSRGraph& g, int source, int target);
+
+        /**
+         * @brief Finds a shortest path between two vertices of a frozen CSR graph with bidirectional Dijkstra.
+         * @param g The input graph in CSR form (non-negative weights).
+         * @param reverse The reverse of g (g.reversed(), or g itself if it is undirected).
+         * @param source The first vertex of the path.
+         * @param target The last vertex of the path.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         * @throws std::invalid_argument if reverse does not have the same number of vertices as g.
+         */
+
+        static Path bidirectionalShortestPath(const CSRGraph& g, const CSRGraph& reverse, int source, int target);
+
+        /**
+         * @brief Runs Dijkstra's algorithm from many sources of a frozen CSR graph on several threads and streams
+         * each result to a callback.
+         * 
+         * Every worker owns one DijkstraScratch and takes the next source from a shared counter until none are
+         * left, so a few expensive sources do not hold up a thread with a fixed share of the list. The scratch
+         * only resets the vertices the previous run reached, so no run pays for clearing the whole graph, and
+         * nothing is allocated per source. The results are not collected: callback(source_index, result) sees
+         * each run while it is still in the scratch (valid only during the call), and keeps what it needs.
+         * The callback is called concurrently from the worker threads, in no particular order, so it must be
+         * safe to call that way (for example, by only writing to slots of source_index). If it throws, or a run
+         * runs out of memory, the remaining sources are skipped and the exception is rethrown once every worker
+         * has stopped.
+         * 
+         * @tparam Callback A callable taking (int source_index, const DijkstraScratch& result).
+         * @param g The input graph in CSR form (non-negative weights).
+         * @param sources The source vertices, repeats allowed.
+         * @param num_sources Number of entries in sources.
+         * @param callback Called once per source with the finished run.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @throws std::out_of_range if a source is invalid (before any search starts).
+         * @throws std::bad_alloc if the scratch buffers (one per thread, O(V) each) or a run's heap cannot be allocated.
+         */
+
+        template <typename Callback>
+        static void dijkstraBatch(const CSRGraph& g, const int* sources, int num_sources, Callback callback, int num_threads = 0);
+
+        /**
+         * @brief Computes the MST (or forest) of a frozen CSR graph using Prim's algorithm.
+         * 
+         * @param g The input graph in CSR form.
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        static Graph prim(const CSRGraph& g);
+
+        /**
+         * @brief Computes the MST of a frozen CSR graph using Prim's algorithm and returns its edges as a flat list.
+         * 
+         * @param g The input graph in CSR form.
+         * @return The MST (or forest), with the edges listed by ascending vertex.
+         */
+
+        static SpanningForest primForest(const CSRGraph& g);
+
+        /**
+         * @brief Computes the MST of a frozen CSR graph using Prim's algorithm driven by an indexed d-ary heap.
+         * 
+         * @tparam Arity Number of children per heap node (default is 4).
+         * @param g The input graph in CSR form.
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        template <int Arity = 4>
+        static Graph primHeap(const CSRGraph& g);
+
+        /**
+         * @brief Computes the MST of a frozen CSR graph using heap-based Prim and returns its edges as a flat list.
+         * 
+         * @tparam Arity Number of children per heap node (default is 4).
+         * @param g The input graph in CSR form.
+         * @return The MST (or forest), with the edges listed by ascending vertex.
+         */
+
+        template <int Arity = 4>
+        static SpanningForest primHeapForest(const CSRGraph& g);
+
+        /**
+         * @brief Computes the MST (or forest) of a frozen CSR graph using Kruskal's algorithm.
+         * 
+         * @param g The input graph in CSR form.
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        static Graph kruskal(const CSRGraph& g);
+
+        /**
+         * @brief Computes the MST of a frozen CSR graph using Kruskal's algorithm and returns its edges as a flat list.
+         * 
+         * @param g The input graph in CSR form.
+         * @return The MST (or forest), with the edges listed in the order Kruskal accepted them.
+         */
+
+        static SpanningForest kruskalForest(const CSRGraph& g);
+
+        /**
+         * @brief Computes the MST (or forest) of a frozen CSR graph using Borůvka's algorithm on several threads.
+         * 
+         * @param g The input graph in CSR form.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        static Graph boruvka(const CSRGraph& g, int num_threads = 0);
+
+        /**
+         * @brief Computes the MST of a frozen CSR graph using Borůvka's algorithm on several threads and returns its edges as a flat list.
+         * 
+         * @param g The input graph in CSR form.
+         * @param num_threads Number of threads to use (default is 0, one per hardware thread).
+         * @return The MST (or forest), with the edges listed in the order they were contracted.
+         */
+
+        static SpanningForest boruvkaForest(const CSRGraph& g, int num_threads = 0);
+
     };
-};
\ No newline at end of file
+};
+
+// The traversals over BasicCSRGraph are templates over the vertex id and weight types,
+// so they are defined here where every instantiation can see them
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicTraversalTree<VertexId, Weight> graph::Algorithms::bfsTree(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, typename BasicCSRGraph<VertexId, Weight, EdgeId>::VertexType start_vertex)
+{
+    using Tree = BasicTraversalTree<VertexId, Weight>;
+
+    VertexId num_vertices = g.getNumOfVertices();
+
+    if (!isValidVertex(start_vertex, num_vertices)) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+
+    const EdgeId* offsets = g.getOffsets();
+    const VertexId* dest_vertices = g.getDestVertices();
+
+    Tree rooted_tree(num_vertices);
+    const typename Tree::Distance* depth = rooted_tree.distance; // A vertex is visited once it has a depth
+    rooted_tree.discover(start_vertex, Tree::NO_PARENT, Weight{}, 0);
+
+    // The discovery order doubles as the BFS queue: vertices are expanded in the order they were discovered
+    for (VertexId head = 0; head < rooted_tree.reached_count; head++)
+    {
+        VertexId current = rooted_tree.order[head];
+
+        for (EdgeId i = offsets[current]; i < offsets[current + 1]; i++) // The neighbors of "current" are contiguous in dest_vertices
+        {
+            VertexId neighbor = dest_vertices[i];
+            if (depth[neighbor] == Tree::UNREACHED)
+            {
+                rooted_tree.discover(neighbor, current, g.getEdgeWeight(i), depth[current] + 1);
+            }
+        }
+    }
+
+    return rooted_tree;
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicTraversalTree<VertexId, Weight> graph::Algorithms::dfsTree(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, typename BasicCSRGraph<VertexId, Weight, EdgeId>::VertexType start_vertex)
+{
+    VertexId num_vertices = g.getNumOfVertices();
+
+    if (!isValidVertex(start_vertex, num_vertices)) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+
+    BasicTraversalTree<VertexId, Weight> dfs_tree(num_vertices);
+    VertexState* vertex_state = new VertexState[num_vertices];
+
+    for (VertexId i = 0; i < num_vertices; i++) // Initialize all vertices to Unvisited as default
+    {
+        vertex_state[i] = VertexState::Unvisited;
+    }
+
+    BasicCSRDfsFrame<VertexId, EdgeId>* stack = new BasicCSRDfsFrame<VertexId, EdgeId>[num_vertices]; // One explicit stack shared by every visit of the forest
+
+    dfsVisit(g, start_vertex, vertex_state, dfs_tree, stack);
+
+    for (VertexId i = 0; i < num_vertices; i++)
+    {
+        if (vertex_state[i] == VertexState::Unvisited)
+        {
+            dfsVisit(g, i, vertex_state, dfs_tree, stack);
+        }
+    }
+
+    delete[] stack;
+    delete[] vertex_state;
+    return dfs_tree;
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+void graph::Algorithms::dfsVisit(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, VertexId current_vertex, VertexState* vertex_state,
+                                 BasicTraversalTree<VertexId, Weight>& dfs_tree, BasicCSRDfsFrame<VertexId, EdgeId>* stack)
+{
+    const EdgeId* offsets = g.getOffsets();
+    const VertexId* dest_vertices = g.getDestVertices();
+
+    bool own_stack = (stack == nullptr);
+    if (own_stack)
+    {
+        stack = new BasicCSRDfsFrame<VertexId, EdgeId>[g.getNumOfVertices()];
+    }
+
+    vertex_state[current_vertex] = VertexState::Visited;
+    dfs_tree.discover(current_vertex, BasicTraversalTree<VertexId, Weight>::NO_PARENT, Weight{}, 0); // A new root of the forest
+    VertexId top = 0;
+    stack[top++] = {current_vertex, offsets[current_vertex]};
+
+    while (top > 0)
+    {
+        BasicCSRDfsFrame<VertexId, EdgeId>& frame = stack[top - 1];
+
+        if (frame.next_index == offsets[frame.vertex + 1]) // All neighbors explored, backtrack
+        {
+            vertex_state[frame.vertex] = VertexState::Finished;
+            top--;
+            continue;
+        }
+
+        EdgeId i = frame.next_index++;
+        VertexId neighbor = dest_vertices[i];
+        if (vertex_state[neighbor] == VertexState::Unvisited) // Tree-edge, add it to the dfs_tree and go deeper
+        {
+            dfs_tree.discover(neighbor, frame.vertex, g.getEdgeWeight(i), dfs_tree.distance[frame.vertex] + 1);
+            vertex_state[neighbor] = VertexState::Visited;
+            stack[top++] = {neighbor, offsets[neighbor]};
+        }
+    }
+
+    if (own_stack)
+    {
+        delete[] stack;
+    }
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicTraversalTree<VertexId, Weight> graph::Algorithms::dijkstraTree(const BasicCSRGraph<VertexId, Weight, EdgeId>& g, typename BasicCSRGraph<VertexId, Weight, EdgeId>::VertexType start_vertex,
+                                                                            DijkstraEngine engine)
+{
+    using Tree = BasicTraversalTree<VertexId, Weight>;
+    using Distance = typename Tree::Distance;
+
+    VertexId num_vertices = g.getNumOfVertices();
+
+    if (!isValidVertex(start_vertex, num_vertices)) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+
+    const EdgeId* offsets = g.getOffsets();
+    const VertexId* dest_vertices = g.getDestVertices();
+
+    // The bucket queue is sized by the largest weight, and only works for integer distances
+    long long max_weight = 1; // A NoWeight edge has length 1
+    if (engine == DijkstraEngine::BucketQueue || engine == DijkstraEngine::Auto)
+    {
+        if constexpr (!std::is_integral<Distance>::value)
+        {
+            if (engine == DijkstraEngine::BucketQueue)
+            {
+                throw std::invalid_argument("The bucket queue engine needs integer weights");
+            }
+            engine = DijkstraEngine::BinaryHeap;
+        }
+        else if constexpr (BasicCSRGraph<VertexId, Weight, EdgeId>::HAS_WEIGHTS)
+        {
+            const Weight* weights = g.getWeights();
+            long long min_weight = 0;
+            max_weight = 0;
+            for (EdgeId i = 0; i < g.getNumOfEdges(); i++)
+            {
+                long long weight = static_cast<long long>(weights[i]);
+                min_weight = weight < min_weight ? weight : min_weight;
+                max_weight = weight > max_weight ? weight : max_weight;
+            }
+            engine = resolveDijkstraEngine(engine, min_weight, max_weight);
+        }
+        else
+        {
+            engine = DijkstraEngine::BucketQueue;
+        }
+    }
+
+    Tree shortest_tree(num_vertices); // Its arrays are filled in place, distances start at UNREACHED
+    Distance* dist = shortest_tree.distance;
+    VertexId* parent = shortest_tree.parent;
+    bool* visited = new bool[num_vertices]{false};
+
+    dist[start_vertex] = 0;
+
+    // Only the selected engine's queue is built, a queue sized for no vertices would be dead code the optimizer warns about
+    BasicMinHeap<Distance, VertexId>* heap = nullptr;
+    BasicBucketQueue<VertexId>* buckets = nullptr;
+    try // Frees the queues and visited if one of them runs out of memory
+    {
+        if (engine == DijkstraEngine::BinaryHeap)
+        {
+            heap = new BasicMinHeap<Distance, VertexId>(num_vertices);
+            heap->push(0, start_vertex);
+        }
+        else if (engine == DijkstraEngine::BucketQueue) // Only integer distances get here
+        {
+            buckets = new BasicBucketQueue<VertexId>(num_vertices, max_weight);
+            buckets->pushOrDecrease(start_vertex, 0);
+        }
+
+        for (VertexId count = 0; count < num_vertices; count++)
+        {
+            VertexId current = Tree::NO_PARENT; // No vertex selected yet
+
+            if (engine == DijkstraEngine::LinearScan)
+            {
+                Distance min_dist = Tree::UNREACHED;
+
+                // Find the unvisited vertex with the minimum distance
+                for (VertexId i = 0; i < num_vertices; i++)
+                {
+                    if (!visited[i] && dist[i] < min_dist)
+                    {
+                        min_dist = dist[i];
+                        current = i;
+                    }
+                }
+            }
+            else if (engine == DijkstraEngine::BinaryHeap)
+            {
+                while (!heap->isEmpty() && current == Tree::NO_PARENT) // Skip stale entries of already settled vertices
+                {
+                    VertexId candidate = heap->pop();
+                    if (!visited[candidate])
+                    {
+                        current = candidate;
+                    }
+                }
+            }
+            else if (!buckets->isEmpty()) // Decrease-key keeps a vertex in one bucket, so nothing popped is stale
+            {
+                current = buckets->pop();
+            }
+
+            if (current == Tree::NO_PARENT) break; // All remaining vertices are inaccessible from start_vertex
+
+            visited[current] = true;
+            shortest_tree.order[shortest_tree.reached_count++] = current; // Its distance and parent are final now
+
+            // Relaxation step over the contiguous neighbor range of current
+            for (EdgeId i = offsets[current]; i < offsets[current + 1]; i++)
+            {
+                VertexId neighbor = dest_vertices[i];
+                Distance candidate = dist[current] + WeightTraits<Weight>::length(g.getEdgeWeight(i));
+                if (!visited[neighbor] && candidate < dist[neighbor])
+                {
+                    dist[neighbor] = candidate;
+                    parent[neighbor] = current;
+                    if constexpr (Tree::HAS_WEIGHTS)
+                    {
+                        shortest_tree.parent_weight[neighbor] = g.getEdgeWeight(i); // Saves a getWeight() lookup per tree edge
+                    }
+                    if (engine == DijkstraEngine::BinaryHeap)
+                    {
+                        heap->push(candidate, neighbor);
+                    }
+                    else if (buckets != nullptr)
+                    {
+                        buckets->pushOrDecrease(neighbor, static_cast<long long>(candidate));
+                    }
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        delete heap;
+        delete buckets;
+        delete[] visited;
+        throw;
+    }
+
+    delete heap;
+    delete buckets;
+    delete[] visited;
+
+    return shortest_tree;
+}
+
+template <typename Heuristic>
+graph::Path graph::Algorithms::aStar(const Graph& g, int source, int target, Heuristic heuristic)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    if (source < 0 || source >= num_vertices || target < 0 || target >= num_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    long long* dist = new long long[num_vertices];
+    int* parent = new int[num_vertices];
+    bool* visited = new bool[num_vertices]{false};
+    for (int i = 0; i < num_vertices; i++)
+    {
+        dist[i] = Path::NO_PATH;
+        parent[i] = -1;
+    }
+
+    dist[source] = 0;
+    MinHeap heap(64); // Keyed by distance plus estimate, so the vertices towards target come out first
+    heap.push(heuristic(source), source);
+
+    while (!heap.isEmpty())
+    {
+        int current = heap.pop();
+        if (visited[current]) continue; // A stale entry of an already settled vertex
+        visited[current] = true;
+        if (current == target) break; // With a consistent heuristic, a settled distance is final
+
+        for (Edge* e = g.getAdjList()[current]; e != nullptr; e = e->next)
+        {
+            int neighbor = e->dest_vertex;
+            if (!visited[neighbor] && dist[current] + e->weight < dist[neighbor])
+            {
+                dist[neighbor] = dist[current] + e->weight;
+                parent[neighbor] = current;
+                heap.push(dist[neighbor] + heuristic(neighbor), neighbor);
+            }
+        }
+    }
+
+    Path path(parent, target, dist[target]);
+
+    delete[] dist;
+    delete[] parent;
+    delete[] visited;
+
+    return path;
+}
+
+template <typename Callback>
+void graph::Algorithms::dijkstraBatch(const Graph& g, const int* sources, int num_sources, Callback callback, int num_threads)
+{
+    CSRGraph csr(g); // Frozen once for the whole batch, every run reads neighbor ranges
+    dijkstraBatch(csr, sources, num_sources, callback, num_threads);
+}
+
+template <typename Callback>
+void graph::Algorithms::dijkstraBatch(const CSRGraph& g, const int* sources, int num_sources, Callback callback, int num_threads)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    for (int i = 0; i < num_sources; i++) // Checked up front, the workers must not throw
+    {
+        if (sources[i] < 0 || sources[i] >= num_vertices)
+        {
+            throw std::out_of_range("Invalid vertex. ");
+        }
+    }
+    if (num_sources <= 0) return;
+
+    int threads = resolveThreadCount(num_threads);
+    if (threads > num_sources)
+    {
+        threads = num_sources;
+    }
+
+    // Every worker's scratch is allocated here, so a bad_alloc reaches the caller instead of ending a worker thread
+    std::exception_ptr* failures = new std::exception_ptr[threads]; // What stopped each worker, rethrown after the join
+    DijkstraScratch** scratches = new DijkstraScratch*[threads]();
+    try
+    {
+        for (int worker = 0; worker < threads; worker++)
+        {
+            scratches[worker] = new DijkstraScratch(num_vertices);
+        }
+    }
+    catch (...)
+    {
+        for (int worker = 0; worker < threads; worker++)
+        {
+            delete scratches[worker];
+        }
+        delete[] scratches;
+        delete[] failures;
+        throw;
+    }
+
+    std::atomic<int> next_source(0); // Index of the next source a worker takes
+    parallelFor(0, threads, threads, [&](int, int first_worker, int last_worker)
+    {
+        for (int worker = first_worker; worker < last_worker; worker++) // Exactly one worker per chunk
+        {
+            DijkstraScratch& scratch = *scratches[worker];
+            try
+            {
+                for (int i = next_source.fetch_add(1, std::memory_order_relaxed); i < num_sources; i = next_source.fetch_add(1, std::memory_order_relaxed))
+                {
+                    scratch.run(g, sources[i]);
+                    callback(i, static_cast<const DijkstraScratch&>(scratch));
+                }
+            }
+            catch (...) // A heap that cannot grow or a throwing callback: stop every worker, parallelFor bodies must not throw
+            {
+                failures[worker] = std::current_exception();
+                next_source.store(num_sources, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (int worker = 0; worker < threads; worker++)
+    {
+        delete scratches[worker];
+    }
+    delete[] scratches;
+    std::exception_ptr failure = nullptr;
+    for (int worker = 0; worker < threads && failure == nullptr; worker++)
+    {
+        failure = failures[worker];
+    }
+    delete[] failures;
+    if (failure != nullptr)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+template <int Lanes, typename Callback>
+void graph::Algorithms::multiSourceBfs(const Graph& g, const int* sources, int num_sources, Callback callback)
+{
+    CSRGraph csr(g); // Frozen once for every batch, the level sweeps read neighbor ranges
+    multiSourceBfs<Lanes>(csr, sources, num_sources, callback);
+}
+
+template <int Lanes, typename Callback>
+void graph::Algorithms::multiSourceBfs(const CSRGraph& g, const int* sources, int num_sources, Callback callback)
+{
+    int num_vertices = g.getNumOfVertices();
+
+    for (int i = 0; i < num_sources; i++) // Checked up front, so no batch runs before a bad source is found
+    {
+        if (sources[i] < 0 || sources[i] >= num_vertices)
+        {
+            throw std::out_of_range("Invalid vertex. ");
+        }
+    }
+    if (num_sources <= 0) return;
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+
+    LaneMask<Lanes>* seen = new LaneMask<Lanes>[num_vertices]; // The BFSs of the batch that reached each vertex
+    LaneMask<Lanes>* visit = new LaneMask<Lanes>[num_vertices]; // The BFSs that expand each vertex in this level
+    LaneMask<Lanes>* next = new LaneMask<Lanes>[num_vertices]; // The BFSs that reach each vertex from this level
+    bool* queued = new bool[num_vertices]{false}; // Whether a vertex is in next_list
+    int* frontier = new int[num_vertices]; // The vertices with a non-empty visit mask
+    int* next_list = new int[num_vertices]; // The vertices with a non-empty next mask
+    for (int v = 0; v < num_vertices; v++)
+    {
+        seen[v].clear();
+        visit[v].clear();
+        next[v].clear();
+    }
+
+    for (int batch = 0; batch < num_sources; batch += Lanes)
+    {
+        int batch_size = num_sources - batch < Lanes ? num_sources - batch : Lanes;
+
+        int frontier_size = 0;
+        for (int lane = 0; lane < batch_size; lane++)
+        {
+            int source = sources[batch + lane];
+            if (!visit[source].any()) // A repeated source is in the frontier once, with all its lanes
+            {
+                frontier[frontier_size++] = source;
+            }
+            seen[source].set(lane);
+            visit[source].set(lane);
+            callback(batch + lane, source, 0);
+        }
+
+        for (int level = 1; frontier_size > 0; level++)
+        {
+            int next_size = 0;
+            for (int i = 0; i < frontier_size; i++) // One scan of each adjacency list serves every lane visiting it
+            {
+                int current = frontier[i];
+                for (int j = offsets[current]; j < offsets[current + 1]; j++)
+                {
+                    int neighbor = dest_vertices[j];
+                    if (!queued[neighbor])
+                    {
+                        queued[neighbor] = true;
+                        next_list[next_size++] = neighbor;
+                    }
+                    next[neighbor].orWith(visit[current]);
+                }
+            }
+            for (int i = 0; i < frontier_size; i++)
+            {
+                visit[frontier[i]].clear();
+            }
+
+            frontier_size = 0;
+            for (int i = 0; i < next_size; i++)
+            {
+                int v = next_list[i];
+                queued[v] = false;
+                if (next[v].andNot(seen[v])) // The lanes reaching v for the first time
+                {
+                    seen[v].orWith(next[v]);
+                    visit[v] = next[v];
+                    frontier[frontier_size++] = v;
+                    next[v].forEachLane([&](int lane) { callback(batch + lane, v, level); });
+                }
+                next[v].clear();
+            }
+        }
+
+        if (batch + Lanes < num_sources) // The next batch reuses the lanes
+        {
+            for (int v = 0; v < num_vertices; v++)
+            {
+                seen[v].clear();
+            }
+        }
+    }
+
+    delete[] seen;
+    delete[] visit;
+    delete[] next;
+    delete[] queued;
+    delete[] frontier;
+    delete[] next_list;
+}
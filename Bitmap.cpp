@@ -0,0 +1,54 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "Bitmap.hpp"
+
+// Constructor: allocates enough words for size bits, all cleared
+Bitmap::Bitmap(int size) : num_bits(size), num_words((size + 63) / 64) {
+
+    words = new unsigned long long[num_words > 0 ? num_words : 1];
+    clear();
+}
+
+Bitmap::~Bitmap() // Destructor: frees the words array
+{
+    delete[] words;
+}
+
+void Bitmap::clear() // Clears every bit
+{
+    for (int i = 0; i < num_words; i++)
+    {
+        words[i] = 0;
+    }
+}
+
+int Bitmap::count() const // Counts the set bits word by word
+{
+    int total = 0;
+    for (int i = 0; i < num_words; i++)
+    {
+        total += __builtin_popcountll(words[i]);
+    }
+    return total;
+}
+
+int Bitmap::size() const // Returns the number of bits
+{
+    return num_bits;
+}
+
+void Bitmap::swap(Bitmap& other) // Swaps the word arrays, the sizes are expected to match
+{
+    unsigned long long* temp_words = words;
+    words = other.words;
+    other.words = temp_words;
+
+    int temp_bits = num_bits;
+    num_bits = other.num_bits;
+    other.num_bits = temp_bits;
+
+    int temp_num_words = num_words;
+    num_words = other.num_words;
+    other.num_words = temp_num_words;
+}
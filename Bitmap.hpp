@@ -0,0 +1,97 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+
+/**
+ * @brief A fixed-size set of bits packed into 64-bit words.
+ *
+ * Used as a compact vertex set (for example a BFS frontier): one bit per vertex,
+ * so membership tests touch 64 times less memory than a bool array.
+ */
+
+class Bitmap {
+
+    private:
+
+    unsigned long long* words; // The bits, bit i is bit (i % 64) of words[i / 64]
+    int num_bits; // Number of bits in the bitmap
+    int num_words; // Number of 64-bit words in the array
+
+    public:
+
+    /**
+     * @brief Constructs a bitmap with all bits cleared.
+     * @param size The number of bits.
+     */
+
+    Bitmap(int size);
+
+    /**
+     * @brief Destructor. Frees the words array.
+     */
+
+    ~Bitmap();
+
+    Bitmap(const Bitmap&) = delete; // The words array is owned, copying would double-free it
+    Bitmap& operator=(const Bitmap&) = delete;
+
+    /**
+     * @brief Sets a bit.
+     * @param index The bit to set.
+     */
+
+    void set(int index)
+    {
+        words[index >> 6] |= 1ULL << (index & 63);
+    }
+
+    /**
+     * @brief Clears a bit.
+     * @param index The bit to clear.
+     */
+
+    void reset(int index)
+    {
+        words[index >> 6] &= ~(1ULL << (index & 63));
+    }
+
+    /**
+     * @brief Tests a bit. No bounds check, this is meant for inner loops.
+     * @param index The bit to test.
+     * @return true if the bit is set, false otherwise.
+     */
+
+    bool test(int index) const
+    {
+        return (words[index >> 6] >> (index & 63)) & 1ULL;
+    }
+
+    /**
+     * @brief Clears every bit.
+     */
+
+    void clear();
+
+    /**
+     * @brief Counts the set bits.
+     * @return Number of bits that are set.
+     */
+
+    int count() const;
+
+    /**
+     * @brief Returns the number of bits.
+     * @return The size of the bitmap.
+     */
+
+    int size() const;
+
+    /**
+     * @brief Exchanges the contents of two bitmaps of the same size in O(1).
+     * @param other The bitmap to swap with.
+     */
+
+    void swap(Bitmap& other);
+
+};
@@ -0,0 +1,224 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "GraphTypes.hpp"
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief A monotone bucket priority queue over the items 0 .. num_items - 1 (Dial's algorithm), with decrease-key.
+ *
+ * There is one bucket per key modulo (max_step + 1), each an intrusive doubly linked list of items,
+ * so inserting, decreasing a key and removing are O(1), and pop() only walks over empty buckets.
+ * The queue is monotone: a key must not be smaller than the last popped key, nor larger by more than
+ * max_step. Dijkstra's algorithm with integer weights in 0 .. max_step satisfies both, which makes
+ * a run O(V + E + D) for a largest distance D, without any comparisons between keys.
+ *
+ * Items with equal keys come out in no particular order (last inserted first).
+ *
+ * @tparam Item Integral type of the items (vertex ids).
+ */
+
+template <typename Item>
+class BasicBucketQueue {
+
+    private:
+    static constexpr Item NONE = static_cast<Item>(-1); // Marks the end of a list and an empty bucket
+
+    Item* bucket_head; // First item of every bucket, NONE if the bucket is empty
+    std::size_t num_buckets; // max_step + 1
+    Item* next_item; // next_item[i] follows i in its bucket
+    Item* prev_item; // prev_item[i] precedes i in its bucket, NONE for the head
+    long long* keys; // keys[i] is the key of item i while it is queued
+    bool* queued; // Whether each item is in the queue
+    Item capacity; // Number of items (valid items are 0 .. capacity - 1)
+    std::size_t count; // Number of queued items
+    long long current_key; // The last popped key, no queued key is smaller
+
+    void checkItem(Item item) const
+    {
+        if (!graph::isValidVertex(item, capacity))
+        {
+            throw std::out_of_range("Invalid item index.");
+        }
+    }
+
+    void link(Item item) // Puts item at the head of the bucket of its key
+    {
+        std::size_t slot = static_cast<std::size_t>(keys[item]) % num_buckets;
+        prev_item[item] = NONE;
+        next_item[item] = bucket_head[slot];
+        if (bucket_head[slot] != NONE)
+        {
+            prev_item[bucket_head[slot]] = item;
+        }
+        bucket_head[slot] = item;
+    }
+
+    void unlink(Item item) // Takes item out of the bucket of its key
+    {
+        if (prev_item[item] != NONE)
+        {
+            next_item[prev_item[item]] = next_item[item];
+        }
+        else
+        {
+            bucket_head[static_cast<std::size_t>(keys[item]) % num_buckets] = next_item[item];
+        }
+        if (next_item[item] != NONE)
+        {
+            prev_item[next_item[item]] = prev_item[item];
+        }
+    }
+
+    public:
+
+    /**
+     * @brief Constructs an empty queue for the items 0 .. num_items - 1.
+     * @param num_items The number of items.
+     * @param max_step The largest amount a key may exceed the last popped key by (the maximum edge weight).
+     */
+
+    BasicBucketQueue(Item num_items, long long max_step)
+        : num_buckets(static_cast<std::size_t>(max_step > 0 ? max_step : 0) + 1), capacity(num_items), count(0), current_key(0)
+    {
+        bucket_head = new Item[num_buckets];
+        next_item = new Item[capacity];
+        prev_item = new Item[capacity];
+        keys = new long long[capacity];
+        queued = new bool[capacity];
+        for (std::size_t b = 0; b < num_buckets; b++)
+        {
+            bucket_head[b] = NONE;
+        }
+        for (Item i = 0; i < capacity; i++)
+        {
+            queued[i] = false;
+        }
+    }
+
+    /**
+     * @brief Destructor. Frees the bucket and item arrays.
+     */
+
+    ~BasicBucketQueue()
+    {
+        delete[] bucket_head;
+        delete[] next_item;
+        delete[] prev_item;
+        delete[] keys;
+        delete[] queued;
+    }
+
+    BasicBucketQueue(const BasicBucketQueue&) = delete; // The arrays are owned, copying would double-free them
+    BasicBucketQueue& operator=(const BasicBucketQueue&) = delete;
+
+    /**
+     * @brief Inserts the item, or lowers its key if it is already queued with a larger key.
+     * @param item The item to insert or update.
+     * @param key The key, at least the last popped key and at most max_step above it.
+     * @return true if the queue changed, false if the item was already queued with a key at most key.
+     * @throws std::out_of_range if the item index is invalid.
+     * @throws std::invalid_argument if the key is outside the window of the queue.
+     */
+
+    bool pushOrDecrease(Item item, long long key)
+    {
+        checkItem(item);
+        if (key < current_key || static_cast<unsigned long long>(key - current_key) >= num_buckets)
+        {
+            throw std::invalid_argument("The key is outside the window of the bucket queue.");
+        }
+        if (queued[item])
+        {
+            if (key >= keys[item]) return false;
+            unlink(item);
+        }
+        else
+        {
+            queued[item] = true;
+            count = count + 1;
+        }
+        keys[item] = key;
+        link(item);
+        return true;
+    }
+
+    /**
+     * @brief Removes and returns an item with the smallest key.
+     * @return The removed item.
+     * @throws std::underflow_error if the queue is empty.
+     */
+
+    Item pop() // Walks from the bucket of the last popped key to the first non-empty one
+    {
+        if (isEmpty())
+        {
+            throw std::underflow_error("The queue is empty.");
+        }
+
+        std::size_t slot = static_cast<std::size_t>(current_key) % num_buckets;
+        while (bucket_head[slot] == NONE) // Every queued key is within num_buckets of current_key, so this ends
+        {
+            slot = slot + 1 == num_buckets ? 0 : slot + 1;
+            current_key = current_key + 1;
+        }
+
+        Item item = bucket_head[slot];
+        unlink(item);
+        queued[item] = false;
+        count = count - 1;
+        return item;
+    }
+
+    /**
+     * @brief Returns the key of the last popped item.
+     * @return The smallest key the queue can still hold (0 before the first pop).
+     */
+
+    long long getCurrentKey() const
+    {
+        return current_key;
+    }
+
+    /**
+     * @brief Checks whether an item is currently in the queue.
+     * @param item The item index.
+     * @return true if the item is queued.
+     * @throws std::out_of_range if the item index is invalid.
+     */
+
+    bool contains(Item item) const
+    {
+        checkItem(item);
+        return queued[item];
+    }
+
+    /**
+     * @brief Checks if the queue is empty.
+     * @return true if the queue is empty, false otherwise.
+     */
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Returns the number of items in the queue.
+     * @return Number of items.
+     */
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+};
+
+/**
+ * @brief The bucket queue used by the int Dijkstra: int items, 64-bit keys.
+ */
+
+using BucketQueue = BasicBucketQueue<int>;
@@ -0,0 +1,460 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "GraphTypes.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <limits>
+
+namespace graph {
+
+    /**
+     * @brief An immutable graph stored in Compressed Sparse Row (CSR) form.
+     *
+     * The neighbors of vertex v are dest_vertices[offsets[v]] .. dest_vertices[offsets[v + 1] - 1],
+     * with the matching weights at the same indices of the weights array.
+     * Built once ("frozen") from a mutable Graph, or from an edge list, so traversals walk contiguous memory.
+     * A graph can also be a view over arrays it does not own, such as the sections of a mapped graph file.
+     *
+     * The element types are template parameters, so a graph only pays for the range it needs:
+     * 32-bit ids for graphs below 2^32 vertices, 64-bit ids beyond that, and no weight array at all
+     * with Weight = NoWeight. The class is header-only, like the other templates of this project.
+     *
+     * @tparam VertexId Integral type of vertex ids (int, uint32_t, uint64_t ...).
+     * @tparam Weight Arithmetic type of edge weights (uint8_t, int32_t, int64_t, float, double ...), or NoWeight.
+     * @tparam EdgeId Integral type of edge indices and offsets, must hold the number of edges (default is VertexId).
+     */
+
+    template <typename VertexId, typename Weight, typename EdgeId = VertexId>
+    class BasicCSRGraph
+    {
+
+        static_assert(std::is_integral<VertexId>::value, "VertexId must be an integral type");
+        static_assert(std::is_integral<EdgeId>::value, "EdgeId must be an integral type");
+
+        public:
+        using VertexType = VertexId; // The template parameters, for code that is generic over the graph type
+        using WeightType = Weight;
+        using EdgeIdType = EdgeId;
+        using Distance = typename WeightTraits<Weight>::Distance; // Type path lengths are summed in
+
+        static constexpr bool HAS_WEIGHTS = WeightTraits<Weight>::HAS_WEIGHTS; // false for NoWeight
+
+        private:
+        VertexId num_of_vertices; // Number of vertices in the graph
+        EdgeId num_of_edges; // Number of directed edge entries (an undirected edge is stored twice)
+        const EdgeId* offsets; // offsets[v] is the index of the first edge of vertex v, offsets[num_of_vertices] == num_of_edges
+        const VertexId* dest_vertices; // Destination vertex of each edge, grouped by source vertex
+        const Weight* weights; // Weight of each edge, parallel to dest_vertices (nullptr for NoWeight)
+        bool owns_arrays; // false for a view over arrays owned by someone else (e.g. a mapped file)
+
+        BasicCSRGraph(VertexId vertices, const EdgeId* csr_offsets, const VertexId* csr_dest_vertices, const Weight* csr_weights, bool take_ownership)
+            : num_of_vertices(vertices), num_of_edges(csr_offsets[vertices]), offsets(csr_offsets),
+              dest_vertices(csr_dest_vertices), weights(csr_weights), owns_arrays(take_ownership)
+        {
+        }
+
+        public:
+
+        /**
+         * @brief Freezes a mutable graph into CSR form.
+         *
+         * Each vertex keeps its neighbors in the same order as its adjacency list in g,
+         * so traversals over the CSR graph visit vertices in the same order as over g.
+         * The weights are converted to Weight (and dropped for NoWeight).
+         *
+         * @param g The graph to freeze.
+         */
+
+        explicit BasicCSRGraph(const Graph& g);
+
+        /**
+         * @brief Builds a CSR graph directly from a list of directed edges, without going through a Graph.
+         *
+         * Edge i goes from sources[i] to destinations[i]. Each vertex keeps its edges in the order they appear
+         * in the list. For an undirected graph, list every edge in both directions.
+         *
+         * @param vertices The number of vertices.
+         * @param edge_count The number of edges in the list.
+         * @param sources Source vertex of every edge.
+         * @param destinations Destination vertex of every edge.
+         * @param edge_weights Weight of every edge (ignored for NoWeight, may be nullptr then).
+         * @throws std::out_of_range if any vertex index is invalid.
+         */
+
+        BasicCSRGraph(VertexId vertices, EdgeId edge_count, const VertexId* sources, const VertexId* destinations, const Weight* edge_weights);
+
+        /**
+         * @brief Wraps CSR arrays owned by someone else, without copying them (a view).
+         *
+         * Used to run the algorithms directly over a memory-mapped graph file. The arrays are not
+         * validated or freed, and must outlive the graph.
+         *
+         * @param vertices The number of vertices.
+         * @param csr_offsets The offsets array (vertices + 1 entries).
+         * @param csr_dest_vertices The destination array (csr_offsets[vertices] entries).
+         * @param csr_weights The weight array, parallel to the destinations (nullptr for NoWeight).
+         */
+
+        BasicCSRGraph(VertexId vertices, const EdgeId* csr_offsets, const VertexId* csr_dest_vertices, const Weight* csr_weights)
+            : num_of_vertices(vertices), num_of_edges(csr_offsets[vertices]), offsets(csr_offsets),
+              dest_vertices(csr_dest_vertices), weights(csr_weights), owns_arrays(false)
+        {
+        }
+
+        /**
+         * @brief Destructor. Frees the offsets, destination and weight arrays (unless the graph is a view).
+         */
+
+        ~BasicCSRGraph();
+
+        BasicCSRGraph(const BasicCSRGraph&) = delete; // The arrays are owned, copying would double-free them
+        BasicCSRGraph& operator=(const BasicCSRGraph&) = delete;
+
+        /**
+         * @brief Returns the number of vertices in the graph.
+         * @return Number of vertices.
+         */
+
+        VertexId getNumOfVertices() const
+        {
+            return num_of_vertices;
+        }
+
+        /**
+         * @brief Returns the number of stored (directed) edge entries.
+         * @return Number of edges.
+         */
+
+        EdgeId getNumOfEdges() const
+        {
+            return num_of_edges;
+        }
+
+        /**
+         * @brief Returns the offsets array (num_of_vertices + 1 entries).
+         * @return A pointer to the offsets array.
+         */
+
+        const EdgeId* getOffsets() const
+        {
+            return offsets;
+        }
+
+        /**
+         * @brief Returns the destination vertex of every edge.
+         * @return A pointer to the destination array (num_of_edges entries).
+         */
+
+        const VertexId* getDestVertices() const
+        {
+            return dest_vertices;
+        }
+
+        /**
+         * @brief Returns the weight of every edge.
+         * @return A pointer to the weight array (num_of_edges entries), nullptr for NoWeight.
+         */
+
+        const Weight* getWeights() const
+        {
+            return weights;
+        }
+
+        /**
+         * @brief Returns the weight of one edge by its index in the CSR arrays.
+         * @param edge The edge index.
+         * @return The weight of the edge (NoWeight{} for an unweighted graph).
+         */
+
+        Weight getEdgeWeight(EdgeId edge) const
+        {
+            if constexpr (HAS_WEIGHTS)
+            {
+                return weights[edge];
+            }
+            else
+            {
+                return Weight{};
+            }
+        }
+
+        /**
+         * @brief Checks whether the graph owns its arrays.
+         * @return false if the graph is a view over arrays owned by someone else.
+         */
+
+        bool ownsArrays() const
+        {
+            return owns_arrays;
+        }
+
+        /**
+         * @brief Builds the reverse (transpose) of the graph: an edge dest -> src for every edge src -> dest, with the same weight.
+         *
+         * The incoming edges of a vertex are its outgoing edges in the reverse graph, which is what a backward search walks.
+         * Each reversed range is ordered by source vertex. An undirected graph stores both directions, so it is its own reverse.
+         *
+         * @return A new graph that owns its arrays, even when this graph is a view.
+         */
+
+        BasicCSRGraph reversed() const;
+
+        /**
+         * @brief Returns the number of neighbors of a vertex.
+         * @param vertex The vertex index.
+         * @return The out-degree of the vertex.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        EdgeId getDegree(VertexId vertex) const;
+
+        /**
+         * @brief Returns the weight of the edge between two vertices. Only available when the graph has weights.
+         * @param src Source vertex.
+         * @param dest Destination vertex.
+         * @return Weight of the edge if it exists, the largest Weight value (INT_MAX for int) otherwise.
+         * @throws std::out_of_range if vertex indices are invalid.
+         */
+
+        Weight getWeight(VertexId src, VertexId dest) const;
+
+        /**
+         * @brief Checks whether there is an edge from src to dest.
+         * @param src Source vertex.
+         * @param dest Destination vertex.
+         * @return true if the edge exists, false otherwise.
+         * @throws std::out_of_range if vertex indices are invalid.
+         */
+
+        bool hasEdge(VertexId src, VertexId dest) const;
+
+        /**
+         * @brief Prints the graph in the same format as Graph::printGraph (without weights for NoWeight).
+         */
+
+        void printGraph() const;
+
+    };
+
+    /**
+     * @brief The CSR graph with int vertex ids and int weights, frozen from a Graph.
+     */
+
+    using CSRGraph = BasicCSRGraph<int, int>;
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicCSRGraph<VertexId, Weight, EdgeId>::BasicCSRGraph(const Graph& g) : owns_arrays(true) // Freezes the adjacency lists of g into flat arrays
+{
+    num_of_vertices = static_cast<VertexId>(g.getNumOfVertices());
+    Edge** adj = g.getAdjList();
+
+    // First pass: count the neighbors of every vertex to build the offsets array
+    EdgeId* new_offsets = new EdgeId[num_of_vertices + 1];
+    new_offsets[0] = 0;
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        EdgeId degree = 0;
+        for (Edge* e = adj[v]; e != nullptr; e = e->next)
+        {
+            degree++;
+        }
+        new_offsets[v + 1] = new_offsets[v] + degree;
+    }
+    num_of_edges = new_offsets[num_of_vertices];
+
+    // Second pass: copy the edges, keeping the order of each adjacency list
+    VertexId* new_dest_vertices = new VertexId[num_of_edges];
+    Weight* new_weights = HAS_WEIGHTS ? new Weight[num_of_edges] : nullptr;
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        EdgeId index = new_offsets[v];
+        for (Edge* e = adj[v]; e != nullptr; e = e->next)
+        {
+            new_dest_vertices[index] = static_cast<VertexId>(e->dest_vertex);
+            if constexpr (HAS_WEIGHTS)
+            {
+                new_weights[index] = static_cast<Weight>(e->weight);
+            }
+            index++;
+        }
+    }
+
+    offsets = new_offsets;
+    dest_vertices = new_dest_vertices;
+    weights = new_weights;
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicCSRGraph<VertexId, Weight, EdgeId>::BasicCSRGraph(VertexId vertices, EdgeId edge_count, const VertexId* sources, const VertexId* destinations, const Weight* edge_weights)
+    : num_of_vertices(vertices), num_of_edges(edge_count), owns_arrays(true)
+{
+    for (EdgeId i = 0; i < edge_count; i++) // Validate everything before allocating
+    {
+        if (!isValidVertex(sources[i], vertices) || !isValidVertex(destinations[i], vertices))
+        {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+    }
+
+    // Counting sort by source: count the degrees, prefix-sum them into offsets, then place every edge
+    EdgeId* new_offsets = new EdgeId[num_of_vertices + 1];
+    for (VertexId v = 0; v <= num_of_vertices; v++)
+    {
+        new_offsets[v] = 0;
+    }
+    for (EdgeId i = 0; i < edge_count; i++)
+    {
+        new_offsets[sources[i] + 1]++;
+    }
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        new_offsets[v + 1] += new_offsets[v];
+    }
+
+    VertexId* new_dest_vertices = new VertexId[num_of_edges];
+    Weight* new_weights = HAS_WEIGHTS ? new Weight[num_of_edges] : nullptr;
+    EdgeId* next_slot = new EdgeId[num_of_vertices]; // Where the next edge of each vertex goes
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        next_slot[v] = new_offsets[v];
+    }
+    for (EdgeId i = 0; i < edge_count; i++) // In list order, so each vertex keeps the order of its edges
+    {
+        EdgeId slot = next_slot[sources[i]]++;
+        new_dest_vertices[slot] = destinations[i];
+        if constexpr (HAS_WEIGHTS)
+        {
+            new_weights[slot] = edge_weights[i];
+        }
+    }
+    delete[] next_slot;
+
+    offsets = new_offsets;
+    dest_vertices = new_dest_vertices;
+    weights = new_weights;
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicCSRGraph<VertexId, Weight, EdgeId>::~BasicCSRGraph() // Destructor: frees the CSR arrays, a view leaves them to their owner
+{
+    if (owns_arrays)
+    {
+        delete[] offsets;
+        delete[] dest_vertices;
+        delete[] weights;
+    }
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+graph::BasicCSRGraph<VertexId, Weight, EdgeId> graph::BasicCSRGraph<VertexId, Weight, EdgeId>::reversed() const
+{
+    // Counting sort by destination: count the in-degrees, prefix-sum them into offsets, then place every edge
+    EdgeId* new_offsets = new EdgeId[num_of_vertices + 1];
+    for (VertexId v = 0; v <= num_of_vertices; v++)
+    {
+        new_offsets[v] = 0;
+    }
+    for (EdgeId i = 0; i < num_of_edges; i++)
+    {
+        new_offsets[dest_vertices[i] + 1]++;
+    }
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        new_offsets[v + 1] += new_offsets[v];
+    }
+
+    VertexId* new_dest_vertices = new VertexId[num_of_edges];
+    Weight* new_weights = HAS_WEIGHTS ? new Weight[num_of_edges] : nullptr;
+    EdgeId* next_slot = new EdgeId[num_of_vertices]; // Where the next reversed edge of each vertex goes
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        next_slot[v] = new_offsets[v];
+    }
+    for (VertexId src = 0; src < num_of_vertices; src++) // By source, so every reversed range comes out sorted
+    {
+        for (EdgeId i = offsets[src]; i < offsets[src + 1]; i++)
+        {
+            EdgeId slot = next_slot[dest_vertices[i]]++;
+            new_dest_vertices[slot] = src;
+            if constexpr (HAS_WEIGHTS)
+            {
+                new_weights[slot] = weights[i];
+            }
+        }
+    }
+    delete[] next_slot;
+
+    return BasicCSRGraph(num_of_vertices, new_offsets, new_dest_vertices, new_weights, true);
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+EdgeId graph::BasicCSRGraph<VertexId, Weight, EdgeId>::getDegree(VertexId vertex) const
+{
+    if (!isValidVertex(vertex, num_of_vertices))
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+    return offsets[vertex + 1] - offsets[vertex];
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+Weight graph::BasicCSRGraph<VertexId, Weight, EdgeId>::getWeight(VertexId src, VertexId dest) const
+{
+    static_assert(HAS_WEIGHTS, "getWeight() needs a weighted graph, use hasEdge() on a NoWeight graph");
+
+    if (!isValidVertex(src, num_of_vertices) || !isValidVertex(dest, num_of_vertices))
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    for (EdgeId i = offsets[src]; i < offsets[src + 1]; i++)
+    {
+        if (dest_vertices[i] == dest)
+        {
+            return weights[i];
+        }
+    }
+
+    return std::numeric_limits<Weight>::max(); // The edge doesnt exist, return infinity
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+bool graph::BasicCSRGraph<VertexId, Weight, EdgeId>::hasEdge(VertexId src, VertexId dest) const
+{
+    if (!isValidVertex(src, num_of_vertices) || !isValidVertex(dest, num_of_vertices))
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    for (EdgeId i = offsets[src]; i < offsets[src + 1]; i++)
+    {
+        if (dest_vertices[i] == dest)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+void graph::BasicCSRGraph<VertexId, Weight, EdgeId>::printGraph() const
+{
+    for (VertexId v = 0; v < num_of_vertices; v++)
+    {
+        std::cout << "Vertex " << v;
+        for (EdgeId i = offsets[v]; i < offsets[v + 1]; i++)
+        {
+            std::cout << "->" << "[" << "Vertex " << dest_vertices[i];
+            if constexpr (HAS_WEIGHTS)
+            {
+                std::cout << ", weight = " << +weights[i]; // Unary + prints uint8_t weights as numbers
+            }
+            std::cout << "]";
+        }
+        std::cout << std::endl;
+    }
+}
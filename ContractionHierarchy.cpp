@@ -0,0 +1,783 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "ContractionHierarchy.hpp"
+#include "GraphFile.hpp"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+const char graph::CH_FILE_MAGIC[8] = {'N', 'P', 'C', 'H', 'I', 'D', 'X', '\0'};
+
+namespace {
+
+    const int WITNESS_SETTLE_LIMIT = 500; // A witness search gives up after this many vertices and keeps the shortcut
+    const int SIMULATION_SETTLE_LIMIT = 50; // The same for the searches that only estimate the priority of a vertex
+
+    // An arc of the graph being contracted: its other end, cost, and the vertex it skips (-1 for an original edge)
+    struct Arc {
+        int vertex;
+        long long weight;
+        int middle;
+    };
+
+    // A growable list of arcs, doubling when it is full. Order does not matter, so removal swaps in the last arc.
+    struct ArcList {
+        Arc* arcs = nullptr;
+        int size = 0;
+        int capacity = 0;
+
+        ArcList() = default;
+        ~ArcList()
+        {
+            delete[] arcs;
+        }
+        ArcList(const ArcList&) = delete; // The array is owned
+        ArcList& operator=(const ArcList&) = delete;
+
+        void append(const Arc& arc)
+        {
+            if (size == capacity)
+            {
+                int new_capacity = capacity < 4 ? 4 : capacity * 2;
+                Arc* bigger = new Arc[new_capacity];
+                for (int i = 0; i < size; i++)
+                {
+                    bigger[i] = arcs[i];
+                }
+                delete[] arcs;
+                arcs = bigger;
+                capacity = new_capacity;
+            }
+            arcs[size++] = arc;
+        }
+
+        // Adds an arc to vertex, or lowers the cost of the one already there (parallel edges keep the cheapest)
+        void addOrLower(int vertex, long long weight, int middle)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                if (arcs[i].vertex == vertex)
+                {
+                    if (weight < arcs[i].weight)
+                    {
+                        arcs[i].weight = weight;
+                        arcs[i].middle = middle;
+                    }
+                    return;
+                }
+            }
+            append({vertex, weight, middle});
+        }
+
+        void remove(int vertex)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                if (arcs[i].vertex == vertex)
+                {
+                    arcs[i] = arcs[--size];
+                    return;
+                }
+            }
+        }
+
+        void release()
+        {
+            delete[] arcs;
+            arcs = nullptr;
+            size = 0;
+            capacity = 0;
+        }
+    };
+
+    // The graph being contracted: the remaining (uncontracted) vertices with their arcs, shortcuts included
+    class Contractor {
+
+        private:
+        int num_vertices;
+        ArcList* out_arcs; // out_arcs[v]: arcs v -> w between remaining vertices
+        ArcList* in_arcs; // in_arcs[v]: arcs u -> v between remaining vertices (arc.vertex is u)
+        int* contracted_neighbors; // Number of neighbors of v contracted so far
+        int* level; // Depth of v in the hierarchy so far: one more than its deepest contracted neighbor
+        long long* witness_distance; // Scratch distances of the witness search, NO_PATH when untouched
+        int* witness_touched; // The vertices the last witness search set a distance for
+        int num_witness_touched;
+        int* target_stamp; // target_stamp[w] == stamp marks the vertices the current witness search must reach
+        int stamp;
+        MinHeap heap;
+
+        // Dijkstra from source over the remaining graph without avoid, until every one of the num_targets marked
+        // targets is settled, the distance passes max_distance, or settle_limit vertices are settled
+        void witnessSearch(int source, int avoid, long long max_distance, int num_targets, int settle_limit)
+        {
+            for (int i = 0; i < num_witness_touched; i++)
+            {
+                witness_distance[witness_touched[i]] = graph::Path::NO_PATH;
+            }
+            num_witness_touched = 0;
+            heap.clear();
+
+            witness_distance[source] = 0;
+            witness_touched[num_witness_touched++] = source;
+            heap.push(0, source);
+            int settled = 0;
+            while (!heap.isEmpty() && settled < settle_limit)
+            {
+                long long key = heap.peekKey();
+                int current = heap.pop();
+                if (key > witness_distance[current]) continue; // A stale entry
+                if (key > max_distance) break; // No witness can be this long
+                settled++;
+                if (target_stamp[current] == stamp && --num_targets == 0) break; // Every target has its final distance
+
+                const ArcList& arcs = out_arcs[current];
+                for (int i = 0; i < arcs.size; i++)
+                {
+                    int neighbor = arcs.arcs[i].vertex;
+                    long long candidate = key + arcs.arcs[i].weight;
+                    if (neighbor != avoid && candidate < witness_distance[neighbor])
+                    {
+                        if (witness_distance[neighbor] == graph::Path::NO_PATH)
+                        {
+                            witness_touched[num_witness_touched++] = neighbor;
+                        }
+                        witness_distance[neighbor] = candidate;
+                        heap.push(candidate, neighbor);
+                    }
+                }
+            }
+        }
+
+        public:
+        Contractor(const graph::Graph& g) : num_vertices(g.getNumOfVertices()), num_witness_touched(0), stamp(0), heap(64)
+        {
+            out_arcs = new ArcList[num_vertices];
+            in_arcs = new ArcList[num_vertices];
+            contracted_neighbors = new int[num_vertices];
+            level = new int[num_vertices];
+            witness_distance = new long long[num_vertices];
+            witness_touched = new int[num_vertices];
+            target_stamp = new int[num_vertices];
+            for (int v = 0; v < num_vertices; v++)
+            {
+                contracted_neighbors[v] = 0;
+                level[v] = 0;
+                witness_distance[v] = graph::Path::NO_PATH;
+                target_stamp[v] = 0;
+            }
+
+            for (int v = 0; v < num_vertices; v++)
+            {
+                for (graph::Edge* e = g.getAdjList()[v]; e != nullptr; e = e->next)
+                {
+                    if (e->dest_vertex == v) continue; // A self loop is never on a shortest path
+                    out_arcs[v].addOrLower(e->dest_vertex, e->weight, -1);
+                    in_arcs[e->dest_vertex].addOrLower(v, e->weight, -1);
+                }
+            }
+        }
+
+        ~Contractor()
+        {
+            delete[] out_arcs;
+            delete[] in_arcs;
+            delete[] contracted_neighbors;
+            delete[] level;
+            delete[] witness_distance;
+            delete[] witness_touched;
+            delete[] target_stamp;
+        }
+
+        Contractor(const Contractor&) = delete; // The arrays are owned
+        Contractor& operator=(const Contractor&) = delete;
+
+        const ArcList& outArcs(int v) const
+        {
+            return out_arcs[v];
+        }
+
+        const ArcList& inArcs(int v) const
+        {
+            return in_arcs[v];
+        }
+
+        // The shortcuts contracting v needs: one for every u -> v -> w without a witness path. Added unless simulate is set.
+        int contract(int v, bool simulate)
+        {
+            int shortcuts = 0;
+            const ArcList& incoming = in_arcs[v];
+            const ArcList& outgoing = out_arcs[v];
+            for (int i = 0; i < incoming.size; i++)
+            {
+                int u = incoming.arcs[i].vertex;
+                long long max_through = -1; // The longest path u -> v -> w that may need a shortcut
+                int num_targets = 0;
+                stamp++;
+                for (int j = 0; j < outgoing.size; j++)
+                {
+                    if (outgoing.arcs[j].vertex == u) continue;
+                    target_stamp[outgoing.arcs[j].vertex] = stamp;
+                    num_targets++;
+                    if (incoming.arcs[i].weight + outgoing.arcs[j].weight > max_through)
+                    {
+                        max_through = incoming.arcs[i].weight + outgoing.arcs[j].weight;
+                    }
+                }
+                if (num_targets == 0) continue;
+
+                witnessSearch(u, v, max_through, num_targets, simulate ? SIMULATION_SETTLE_LIMIT : WITNESS_SETTLE_LIMIT);
+                for (int j = 0; j < outgoing.size; j++)
+                {
+                    int w = outgoing.arcs[j].vertex;
+                    long long through = incoming.arcs[i].weight + outgoing.arcs[j].weight;
+                    if (w == u || witness_distance[w] <= through) continue; // A witness keeps the distance without v
+                    shortcuts++;
+                    if (!simulate)
+                    {
+                        out_arcs[u].addOrLower(w, through, v);
+                        in_arcs[w].addOrLower(u, through, v);
+                    }
+                }
+            }
+            return shortcuts;
+        }
+
+        // Lower is contracted first: twice the edge difference (shortcuts added minus arcs removed), plus the
+        // contracted neighbors and the level, which spread the contraction evenly over the graph
+        long long priority(int v)
+        {
+            long long edge_difference = static_cast<long long>(contract(v, true)) - in_arcs[v].size - out_arcs[v].size;
+            return 2 * edge_difference + contracted_neighbors[v] + level[v];
+        }
+
+        // Takes v out of the remaining graph, after its shortcuts were added
+        void remove(int v)
+        {
+            for (int i = 0; i < out_arcs[v].size; i++)
+            {
+                int w = out_arcs[v].arcs[i].vertex;
+                in_arcs[w].remove(v);
+                contracted_neighbors[w]++;
+                if (level[v] + 1 > level[w]) level[w] = level[v] + 1;
+            }
+            for (int i = 0; i < in_arcs[v].size; i++)
+            {
+                int u = in_arcs[v].arcs[i].vertex;
+                out_arcs[u].remove(v);
+                contracted_neighbors[u]++;
+                if (level[v] + 1 > level[u]) level[u] = level[v] + 1;
+            }
+            out_arcs[v].release();
+            in_arcs[v].release();
+        }
+    };
+
+    // Packs one list of arcs per vertex into CSR arrays
+    void packArcs(const ArcList* lists, int num_vertices, int*& offsets, int*& targets, long long*& weights, int*& middles)
+    {
+        long long total = 0;
+        for (int v = 0; v < num_vertices; v++)
+        {
+            total += lists[v].size;
+        }
+        if (total > INT_MAX)
+        {
+            throw std::runtime_error("The contraction hierarchy has too many arcs.");
+        }
+
+        offsets = new int[num_vertices + 1];
+        targets = new int[total];
+        weights = new long long[total];
+        middles = new int[total];
+        offsets[0] = 0;
+        for (int v = 0; v < num_vertices; v++)
+        {
+            int index = offsets[v];
+            for (int i = 0; i < lists[v].size; i++)
+            {
+                targets[index] = lists[v].arcs[i].vertex;
+                weights[index] = lists[v].arcs[i].weight;
+                middles[index] = lists[v].arcs[i].middle;
+                index++;
+            }
+            offsets[v + 1] = index;
+        }
+    }
+
+    // The middle vertex of the arc from -> to (one of them is the lower ranked owner of the arc), searched in its arc range
+    int arcMiddle(const int* offsets, const int* targets, const long long* weights, const int* middles, int owner, int other)
+    {
+        int best = -1;
+        long long best_weight = graph::Path::NO_PATH;
+        for (int i = offsets[owner]; i < offsets[owner + 1]; i++)
+        {
+            if (targets[i] == other && weights[i] < best_weight)
+            {
+                best = middles[i];
+                best_weight = weights[i];
+            }
+        }
+        return best;
+    }
+}
+
+graph::ContractionHierarchy::ContractionHierarchy()
+    : num_of_vertices(0), num_of_shortcuts(0), rank(nullptr),
+      forward_offsets(nullptr), forward_targets(nullptr), forward_weights(nullptr), forward_middles(nullptr),
+      backward_offsets(nullptr), backward_targets(nullptr), backward_weights(nullptr), backward_middles(nullptr)
+{
+}
+
+graph::ContractionHierarchy::ContractionHierarchy(const Graph& g) : ContractionHierarchy()
+{
+    int num_vertices = g.getNumOfVertices();
+    for (int v = 0; v < num_vertices; v++) // Validate before any allocation
+    {
+        for (Edge* e = g.getAdjList()[v]; e != nullptr; e = e->next)
+        {
+            if (e->weight < 0)
+            {
+                throw std::invalid_argument("Contraction hierarchies do not support negative edge weights.");
+            }
+        }
+    }
+
+    Contractor contractor(g);
+    ArcList* upward_out = nullptr; // The final forward arcs of every contracted vertex
+    ArcList* upward_in = nullptr; // The final backward arcs
+    int shortcuts = 0;
+    try // Anything below can run out of memory; rank and the packed arrays go with the destructor, these two do not
+    {
+        upward_out = new ArcList[num_vertices];
+        upward_in = new ArcList[num_vertices];
+        rank = new int[num_vertices]; // Owned from here on: the delegated constructor already ran, so the destructor frees it
+
+        // Lazy updates: a popped vertex is re-evaluated, and goes back in the queue if it is no longer the least important
+        MinHeap queue(num_vertices);
+        for (int v = 0; v < num_vertices; v++)
+        {
+            queue.push(contractor.priority(v), v);
+        }
+
+        int next_rank = 0;
+        while (!queue.isEmpty())
+        {
+            int v = queue.pop();
+            long long current_priority = contractor.priority(v);
+            if (!queue.isEmpty() && current_priority > queue.peekKey())
+            {
+                queue.push(current_priority, v);
+                continue;
+            }
+
+            shortcuts += contractor.contract(v, false);
+            // The arcs still left at v all lead to vertices contracted later, which is what the upward searches follow
+            const ArcList& outgoing = contractor.outArcs(v);
+            for (int i = 0; i < outgoing.size; i++)
+            {
+                upward_out[v].append(outgoing.arcs[i]);
+            }
+            const ArcList& incoming = contractor.inArcs(v);
+            for (int i = 0; i < incoming.size; i++)
+            {
+                upward_in[v].append(incoming.arcs[i]);
+            }
+            contractor.remove(v);
+            rank[v] = next_rank++;
+        }
+
+        packArcs(upward_out, num_vertices, forward_offsets, forward_targets, forward_weights, forward_middles);
+        packArcs(upward_in, num_vertices, backward_offsets, backward_targets, backward_weights, backward_middles);
+    }
+    catch (...)
+    {
+        delete[] upward_out;
+        delete[] upward_in;
+        throw;
+    }
+
+    num_of_vertices = num_vertices;
+    num_of_shortcuts = shortcuts;
+
+    delete[] upward_out;
+    delete[] upward_in;
+}
+
+graph::ContractionHierarchy::~ContractionHierarchy() // Destructor: frees the rank and arc arrays
+{
+    delete[] rank;
+    delete[] forward_offsets;
+    delete[] forward_targets;
+    delete[] forward_weights;
+    delete[] forward_middles;
+    delete[] backward_offsets;
+    delete[] backward_targets;
+    delete[] backward_weights;
+    delete[] backward_middles;
+}
+
+graph::ContractionHierarchy::ContractionHierarchy(ContractionHierarchy&& other) noexcept
+    : num_of_vertices(other.num_of_vertices), num_of_shortcuts(other.num_of_shortcuts), rank(other.rank),
+      forward_offsets(other.forward_offsets), forward_targets(other.forward_targets),
+      forward_weights(other.forward_weights), forward_middles(other.forward_middles),
+      backward_offsets(other.backward_offsets), backward_targets(other.backward_targets),
+      backward_weights(other.backward_weights), backward_middles(other.backward_middles)
+{
+    // Leave other as an empty hierarchy so its destructor frees nothing
+    other.num_of_vertices = 0;
+    other.num_of_shortcuts = 0;
+    other.rank = nullptr;
+    other.forward_offsets = nullptr;
+    other.forward_targets = nullptr;
+    other.forward_weights = nullptr;
+    other.forward_middles = nullptr;
+    other.backward_offsets = nullptr;
+    other.backward_targets = nullptr;
+    other.backward_weights = nullptr;
+    other.backward_middles = nullptr;
+}
+
+void graph::ContractionHierarchy::save(const char* path) const // Header, then the nine arrays as they are in memory
+{
+    int forward_arcs = num_of_vertices > 0 ? forward_offsets[num_of_vertices] : 0;
+    int backward_arcs = num_of_vertices > 0 ? backward_offsets[num_of_vertices] : 0;
+    std::uint64_t vertices = static_cast<std::uint64_t>(num_of_vertices);
+
+    const GraphFileSection sections[9] = {
+        {rank, vertices * sizeof(int)},
+        {forward_offsets, num_of_vertices > 0 ? (vertices + 1) * sizeof(int) : 0},
+        {forward_targets, forward_arcs * sizeof(int)},
+        {forward_weights, forward_arcs * sizeof(long long)},
+        {forward_middles, forward_arcs * sizeof(int)},
+        {backward_offsets, num_of_vertices > 0 ? (vertices + 1) * sizeof(int) : 0},
+        {backward_targets, backward_arcs * sizeof(int)},
+        {backward_weights, backward_arcs * sizeof(long long)},
+        {backward_middles, backward_arcs * sizeof(int)}
+    };
+
+    ContractionHierarchyHeader file_header = {};
+    std::memcpy(file_header.magic, CH_FILE_MAGIC, sizeof(file_header.magic));
+    file_header.version = CH_FILE_VERSION;
+    file_header.num_vertices = vertices;
+    file_header.num_forward_arcs = static_cast<std::uint64_t>(forward_arcs);
+    file_header.num_backward_arcs = static_cast<std::uint64_t>(backward_arcs);
+    file_header.num_shortcuts = static_cast<std::uint64_t>(num_of_shortcuts);
+    writeSectionFile(path, "hierarchy", file_header, sections, 9);
+}
+
+graph::ContractionHierarchy graph::ContractionHierarchy::load(const char* path)
+{
+    MappedFile file(path);
+    ContractionHierarchyHeader file_header = readSectionFileHeader<ContractionHierarchyHeader>(file, "hierarchy", CH_FILE_MAGIC, CH_FILE_VERSION);
+    if (file_header.num_vertices >= INT_MAX || file_header.num_forward_arcs > INT_MAX || file_header.num_backward_arcs > INT_MAX)
+    {
+        throw std::runtime_error("The hierarchy file is too large for int vertex ids.");
+    }
+
+    int vertices = static_cast<int>(file_header.num_vertices);
+    int forward_arcs = static_cast<int>(file_header.num_forward_arcs);
+    int backward_arcs = static_cast<int>(file_header.num_backward_arcs);
+    std::uint64_t offsets_count = vertices > 0 ? static_cast<std::uint64_t>(vertices) + 1 : 0;
+    std::uint64_t section_bytes[9] = {
+        static_cast<std::uint64_t>(vertices) * sizeof(int),
+        offsets_count * sizeof(int),
+        forward_arcs * sizeof(int),
+        forward_arcs * sizeof(long long),
+        forward_arcs * sizeof(int),
+        offsets_count * sizeof(int),
+        backward_arcs * sizeof(int),
+        backward_arcs * sizeof(long long),
+        backward_arcs * sizeof(int)
+    };
+    checkSectionFile(file, "hierarchy", sizeof(file_header), file_header.checksum, section_bytes, 9);
+
+    // Copy the sections into owned arrays; the result outlives the mapping
+    ContractionHierarchy ch;
+    ch.num_of_vertices = vertices;
+    ch.num_of_shortcuts = static_cast<int>(file_header.num_shortcuts);
+    if (vertices == 0) return ch;
+
+    ch.rank = new int[vertices];
+    ch.forward_offsets = new int[vertices + 1];
+    ch.forward_targets = new int[forward_arcs];
+    ch.forward_weights = new long long[forward_arcs];
+    ch.forward_middles = new int[forward_arcs];
+    ch.backward_offsets = new int[vertices + 1];
+    ch.backward_targets = new int[backward_arcs];
+    ch.backward_weights = new long long[backward_arcs];
+    ch.backward_middles = new int[backward_arcs];
+    void* destinations[9] = {ch.rank, ch.forward_offsets, ch.forward_targets, ch.forward_weights, ch.forward_middles,
+                             ch.backward_offsets, ch.backward_targets, ch.backward_weights, ch.backward_middles};
+    copySectionFile(file, sizeof(file_header), section_bytes, destinations, 9);
+
+    // A file that passes the checksum can still have been written wrong; never let a query index out of range
+    auto arcsValid = [vertices](const int* offsets, const int* targets, const int* middles, int arcs)
+    {
+        if (offsets[0] != 0 || offsets[vertices] != arcs) return false;
+        for (int v = 0; v < vertices; v++)
+        {
+            if (offsets[v] > offsets[v + 1]) return false;
+        }
+        for (int i = 0; i < arcs; i++)
+        {
+            if (targets[i] < 0 || targets[i] >= vertices || middles[i] < -1 || middles[i] >= vertices) return false;
+        }
+        return true;
+    };
+    if (!arcsValid(ch.forward_offsets, ch.forward_targets, ch.forward_middles, forward_arcs) ||
+        !arcsValid(ch.backward_offsets, ch.backward_targets, ch.backward_middles, backward_arcs))
+    {
+        throw std::runtime_error("The hierarchy file has arcs outside its vertex range.");
+    }
+    return ch;
+}
+
+long long graph::ContractionHierarchy::distance(int source, int target) const
+{
+    ContractionHierarchyQuery query(*this);
+    return query.distance(source, target);
+}
+
+graph::Path graph::ContractionHierarchy::shortestPath(int source, int target) const
+{
+    ContractionHierarchyQuery query(*this);
+    return query.shortestPath(source, target);
+}
+
+int graph::ContractionHierarchy::getNumOfVertices() const
+{
+    return this->num_of_vertices;
+}
+
+int graph::ContractionHierarchy::getNumOfShortcuts() const
+{
+    return this->num_of_shortcuts;
+}
+
+int graph::ContractionHierarchy::getRank(int vertex) const
+{
+    if (vertex < 0 || vertex >= num_of_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex index.");
+    }
+    return this->rank[vertex];
+}
+
+graph::ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy& ch)
+    : hierarchy(ch), num_touched(0), heaps{MinHeap(64), MinHeap(64)}
+{
+    int num_vertices = ch.num_of_vertices;
+    for (int side = 0; side < 2; side++)
+    {
+        distances[side] = new long long[num_vertices];
+        parents[side] = new int[num_vertices];
+        middles[side] = new int[num_vertices];
+        for (int v = 0; v < num_vertices; v++)
+        {
+            distances[side][v] = Path::NO_PATH;
+            parents[side][v] = -1;
+            middles[side][v] = -1;
+        }
+    }
+    touched = new int[2 * num_vertices]; // Each search touches a vertex at most once
+}
+
+graph::ContractionHierarchyQuery::~ContractionHierarchyQuery() // Destructor: frees the buffers
+{
+    for (int side = 0; side < 2; side++)
+    {
+        delete[] distances[side];
+        delete[] parents[side];
+        delete[] middles[side];
+    }
+    delete[] touched;
+}
+
+void graph::ContractionHierarchyQuery::reset()
+{
+    for (int i = 0; i < num_touched; i++)
+    {
+        int v = touched[i];
+        for (int side = 0; side < 2; side++)
+        {
+            distances[side][v] = Path::NO_PATH;
+            parents[side][v] = -1;
+            middles[side][v] = -1;
+        }
+    }
+    num_touched = 0;
+    heaps[0].clear();
+    heaps[1].clear();
+}
+
+long long graph::ContractionHierarchyQuery::search(int source, int target, int& meeting)
+{
+    const ContractionHierarchy& ch = hierarchy;
+    if (source < 0 || source >= ch.num_of_vertices || target < 0 || target >= ch.num_of_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+
+    reset();
+    // Side 0 goes up the forward arcs from source, side 1 up the backward arcs from target
+    const int* offsets[2] = {ch.forward_offsets, ch.backward_offsets};
+    const int* targets[2] = {ch.forward_targets, ch.backward_targets};
+    const long long* weights[2] = {ch.forward_weights, ch.backward_weights};
+    const int* arc_middles[2] = {ch.forward_middles, ch.backward_middles};
+
+    distances[0][source] = 0;
+    distances[1][target] = 0;
+    touched[num_touched++] = source;
+    touched[num_touched++] = target;
+    heaps[0].push(0, source);
+    heaps[1].push(0, target);
+
+    long long best = Path::NO_PATH;
+    meeting = -1;
+    while (true)
+    {
+        // A search is done once its smallest key cannot improve best: every path it would still find is longer
+        bool forward_active = !heaps[0].isEmpty() && heaps[0].peekKey() < best;
+        bool backward_active = !heaps[1].isEmpty() && heaps[1].peekKey() < best;
+        if (!forward_active && !backward_active) break;
+        int side = forward_active && (!backward_active || heaps[0].peekKey() <= heaps[1].peekKey()) ? 0 : 1;
+        int other = 1 - side;
+
+        long long key = heaps[side].peekKey();
+        int current = heaps[side].pop();
+        if (key > distances[side][current]) continue; // A stale entry
+
+        if (distances[other][current] != Path::NO_PATH && key + distances[other][current] < best)
+        {
+            best = key + distances[other][current];
+            meeting = current;
+        }
+
+        // Stall on demand: the arcs of the other direction at current come from higher ranked vertices;
+        // if one of them already reaches current more cheaply, no shortest up-down path continues from here
+        bool stalled = false;
+        for (int i = offsets[other][current]; i < offsets[other][current + 1]; i++)
+        {
+            long long higher = distances[side][targets[other][i]];
+            if (higher != Path::NO_PATH && higher + weights[other][i] < key)
+            {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) continue;
+
+        for (int i = offsets[side][current]; i < offsets[side][current + 1]; i++)
+        {
+            int neighbor = targets[side][i];
+            long long candidate = key + weights[side][i];
+            if (candidate < distances[side][neighbor])
+            {
+                if (distances[0][neighbor] == Path::NO_PATH && distances[1][neighbor] == Path::NO_PATH)
+                {
+                    touched[num_touched++] = neighbor;
+                }
+                distances[side][neighbor] = candidate;
+                parents[side][neighbor] = current;
+                middles[side][neighbor] = arc_middles[side][i];
+                heaps[side].push(candidate, neighbor);
+            }
+        }
+    }
+    return best;
+}
+
+long long graph::ContractionHierarchyQuery::distance(int source, int target)
+{
+    int meeting = -1;
+    return search(source, target, meeting);
+}
+
+graph::Path graph::ContractionHierarchyQuery::shortestPath(int source, int target)
+{
+    int meeting = -1;
+    long long cost = search(source, target, meeting);
+    if (cost == Path::NO_PATH)
+    {
+        return Path();
+    }
+
+    // The packed up-down path as arcs (from, to, middle): the forward half back from meeting, then the backward half
+    struct PackedArc {
+        int from;
+        int to;
+        int middle;
+    };
+    int forward_count = 0;
+    int backward_count = 0;
+    for (int v = meeting; parents[0][v] != -1; v = parents[0][v]) forward_count++;
+    for (int v = meeting; parents[1][v] != -1; v = parents[1][v]) backward_count++;
+    int packed_count = forward_count + backward_count;
+
+    // Unpacking turns each arc into a stack of arcs, last arc at the bottom, so the path comes out in order
+    int stack_capacity = packed_count > 16 ? packed_count : 16;
+    PackedArc* stack = new PackedArc[stack_capacity];
+    int top = 0;
+    for (int v = meeting; parents[1][v] != -1; v = parents[1][v]) // Pushed from the meeting vertex down, so reversed below
+    {
+        stack[top++] = {v, parents[1][v], middles[1][v]};
+    }
+    for (int i = 0, j = top - 1; i < j; i++, j--)
+    {
+        PackedArc swap = stack[i];
+        stack[i] = stack[j];
+        stack[j] = swap;
+    }
+    for (int v = meeting; parents[0][v] != -1; v = parents[0][v]) // The arc nearest to meeting first, source arc on top
+    {
+        stack[top++] = {parents[0][v], v, middles[0][v]};
+    }
+
+    const ContractionHierarchy& ch = hierarchy;
+    int path_capacity = packed_count + 1;
+    int* path_vertices = new int[path_capacity];
+    int length = 0;
+    path_vertices[length++] = source;
+    while (top > 0)
+    {
+        PackedArc arc = stack[--top];
+        if (arc.middle == -1) // An original edge
+        {
+            if (length == path_capacity)
+            {
+                int* bigger = new int[path_capacity * 2];
+                for (int i = 0; i < length; i++)
+                {
+                    bigger[i] = path_vertices[i];
+                }
+                delete[] path_vertices;
+                path_vertices = bigger;
+                path_capacity *= 2;
+            }
+            path_vertices[length++] = arc.to;
+            continue;
+        }
+
+        // from -> middle is a backward arc of middle, middle -> to a forward arc of middle (middle is ranked below both)
+        if (top + 2 > stack_capacity)
+        {
+            PackedArc* bigger = new PackedArc[stack_capacity * 2];
+            for (int i = 0; i < top; i++)
+            {
+                bigger[i] = stack[i];
+            }
+            delete[] stack;
+            stack = bigger;
+            stack_capacity *= 2;
+        }
+        int m = arc.middle;
+        stack[top++] = {m, arc.to, arcMiddle(ch.forward_offsets, ch.forward_targets, ch.forward_weights, ch.forward_middles, m, arc.to)};
+        stack[top++] = {arc.from, m, arcMiddle(ch.backward_offsets, ch.backward_targets, ch.backward_weights, ch.backward_middles, m, arc.from)};
+    }
+
+    Path path = Path::fromVertices(path_vertices, length, cost);
+    delete[] stack;
+    delete[] path_vertices;
+    return path;
+}
@@ -0,0 +1,250 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "Path.hpp"
+#include "MinHeap.hpp"
+#include <cstdint>
+
+namespace graph {
+
+    constexpr std::uint32_t CH_FILE_VERSION = 1; // Bumped on any incompatible change of the layout
+
+    /**
+     * @brief The fixed-size header at the start of a saved contraction hierarchy.
+     *
+     * The header is followed by nine sections, each zero-padded to a multiple of 8 bytes: the ranks,
+     * then the offsets, targets, weights and middle vertices of the forward arcs, then the same four
+     * arrays for the backward arcs. The checksum (a GraphFileChecksum) covers every section.
+     */
+
+    struct ContractionHierarchyHeader {
+        char magic[8]; // CH_FILE_MAGIC
+        std::uint32_t version; // CH_FILE_VERSION of the writer
+        std::uint32_t byte_order; // GRAPH_FILE_BYTE_ORDER as written by the writer
+        std::uint64_t num_vertices; // Number of vertices
+        std::uint64_t num_forward_arcs; // Number of forward arcs
+        std::uint64_t num_backward_arcs; // Number of backward arcs
+        std::uint64_t num_shortcuts; // Number of shortcuts added by the contraction
+        std::uint64_t checksum; // GraphFileChecksum of the sections
+    };
+
+    static_assert(sizeof(ContractionHierarchyHeader) == 56, "The hierarchy file header must have the same layout everywhere");
+
+    extern const char CH_FILE_MAGIC[8]; // "NPCHIDX" followed by a 0 byte
+
+    /**
+     * @brief A Contraction Hierarchy: a shortest path index built once from a graph, answering s-t queries
+     *        by searching only a tiny part of it.
+     *
+     * Preprocessing contracts the vertices one at a time, least important first (the fewest shortcuts added
+     * per edge removed, spread out by the number of contracted neighbors and the depth reached so far).
+     * Priorities are updated lazily: a popped vertex is re-evaluated before it is contracted. Contracting v removes it
+     * and, for every pair of neighbors u -> v -> w, adds a shortcut u -> w with the cost of the two edges
+     * unless a witness search finds a path from u to w at most as short that avoids v. The contraction order
+     * is the rank of a vertex. Every shortest path then has a shortest path of the same cost that first only
+     * goes up in rank and then only goes down, so a query is two small Dijkstra searches that only follow
+     * edges to higher ranked vertices: forward from the source, and backward from the target.
+     *
+     * The index keeps, for every vertex, its arcs to higher ranked vertices: forward arcs v -> w for the
+     * source side, and backward arcs (edges u -> v of the graph, stored at v) for the target side.
+     * Every arc remembers the vertex it skips (-1 for an original edge), so a path of shortcuts can be
+     * unpacked into the original edges. Weights must be non-negative; distances are 64-bit.
+     *
+     * For many queries use a ContractionHierarchyQuery, which reuses its buffers instead of
+     * allocating them for every query.
+     */
+
+    class ContractionHierarchy
+    {
+
+        private:
+        int num_of_vertices; // Number of vertices
+        int num_of_shortcuts; // Number of shortcuts added during the contraction
+        int* rank; // rank[v] is the position of v in the contraction order
+        int* forward_offsets; // Forward arcs of v are forward_targets[forward_offsets[v] .. forward_offsets[v + 1] - 1]
+        int* forward_targets; // Higher ranked head of every forward arc
+        long long* forward_weights; // Cost of every forward arc
+        int* forward_middles; // The vertex a forward shortcut skips, -1 for an original edge
+        int* backward_offsets; // Backward arcs of v are the edges u -> v of a higher ranked u
+        int* backward_targets; // Higher ranked tail u of every backward arc
+        long long* backward_weights; // Cost of every backward arc
+        int* backward_middles; // The vertex a backward shortcut skips, -1 for an original edge
+
+        ContractionHierarchy(); // An empty hierarchy, filled in by load()
+
+        friend class ContractionHierarchyQuery; // Searches the arc arrays directly
+
+        public:
+
+        /**
+         * @brief Preprocesses a graph into a contraction hierarchy.
+         *
+         * Parallel edges are reduced to the cheapest one, and self loops are dropped. Undirected graphs,
+         * which store each edge in both directions, work as they are.
+         *
+         * @param g The graph to preprocess (non-negative weights).
+         * @throws std::invalid_argument if the graph has a negative edge weight.
+         * @throws std::runtime_error if the hierarchy has more arcs than an int can count.
+         */
+
+        explicit ContractionHierarchy(const Graph& g);
+
+        /**
+         * @brief Destructor. Frees the rank and arc arrays.
+         */
+
+        ~ContractionHierarchy();
+
+        /**
+         * @brief Move constructor. Takes over the arrays of other in O(1), other is left with 0 vertices.
+         */
+
+        ContractionHierarchy(ContractionHierarchy&& other) noexcept;
+
+        ContractionHierarchy(const ContractionHierarchy&) = delete; // The arrays are owned, copying would double-free them
+        ContractionHierarchy& operator=(const ContractionHierarchy&) = delete;
+
+        /**
+         * @brief Writes the hierarchy to a binary file, so preprocessing is done once.
+         * @param path The file to write.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+
+        void save(const char* path) const;
+
+        /**
+         * @brief Reads a hierarchy written by save().
+         * @param path The file to read.
+         * @return The hierarchy.
+         * @throws std::runtime_error if the file cannot be read, is not a hierarchy file of this version,
+         *         fails its checksum or has arcs outside the vertex range.
+         */
+
+        static ContractionHierarchy load(const char* path);
+
+        /**
+         * @brief Returns the cost of a shortest path between two vertices.
+         *
+         * Allocates the query buffers for this call, use a ContractionHierarchyQuery for many queries.
+         *
+         * @param source The first vertex.
+         * @param target The last vertex.
+         * @return The cost, Path::NO_PATH if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        long long distance(int source, int target) const;
+
+        /**
+         * @brief Returns a shortest path between two vertices, unpacked into edges of the original graph.
+         *
+         * Allocates the query buffers for this call, use a ContractionHierarchyQuery for many queries.
+         *
+         * @param source The first vertex.
+         * @param target The last vertex.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        Path shortestPath(int source, int target) const;
+
+        /**
+         * @brief Returns the number of vertices.
+         * @return Number of vertices.
+         */
+
+        int getNumOfVertices() const;
+
+        /**
+         * @brief Returns the number of shortcuts the contraction added.
+         * @return Number of shortcuts.
+         */
+
+        int getNumOfShortcuts() const;
+
+        /**
+         * @brief Returns the position of a vertex in the contraction order.
+         * @param vertex The vertex index.
+         * @return The rank, 0 for the first contracted vertex.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        int getRank(int vertex) const;
+
+    };
+
+    /**
+     * @brief Reusable query buffers for a ContractionHierarchy.
+     *
+     * Distances and parents live in arrays sized once for the whole graph. A query only resets the
+     * vertices it touched, so its cost depends on the size of the two searches, not of the graph.
+     * One query object must not be used by two threads at once; give every thread its own.
+     *
+     * The searches use stall-on-demand: a vertex that is reached more cheaply through a higher ranked
+     * neighbor (which can only happen along a path that is not up-down shortest) is not expanded.
+     */
+
+    class ContractionHierarchyQuery
+    {
+
+        private:
+        const ContractionHierarchy& hierarchy; // The index being searched
+        long long* distances[2]; // Tentative distances of the forward (0) and backward (1) searches
+        int* parents[2]; // The vertex each search reached a vertex from, -1 for its start
+        int* middles[2]; // The middle vertex of the arc to that parent
+        int* touched; // The vertices whose entries must be reset before the next query
+        int num_touched; // Number of entries in touched
+        MinHeap heaps[2]; // Queues of the forward and backward searches
+
+        /**
+         * @brief Runs the two upward searches.
+         * @param meeting Set to the highest vertex of the best up-down path.
+         * @return The cost of the shortest path, Path::NO_PATH if there is none.
+         */
+
+        long long search(int source, int target, int& meeting);
+
+        void reset(); // Clears the entries touched by the previous query
+
+        public:
+
+        /**
+         * @brief Allocates query buffers for a hierarchy.
+         * @param ch The hierarchy to query, must outlive the query object.
+         */
+
+        explicit ContractionHierarchyQuery(const ContractionHierarchy& ch);
+
+        /**
+         * @brief Destructor. Frees the buffers.
+         */
+
+        ~ContractionHierarchyQuery();
+
+        ContractionHierarchyQuery(const ContractionHierarchyQuery&) = delete; // The buffers are owned
+        ContractionHierarchyQuery& operator=(const ContractionHierarchyQuery&) = delete;
+
+        /**
+         * @brief Returns the cost of a shortest path between two vertices.
+         * @param source The first vertex.
+         * @param target The last vertex.
+         * @return The cost, Path::NO_PATH if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        long long distance(int source, int target);
+
+        /**
+         * @brief Returns a shortest path between two vertices, unpacked into edges of the original graph.
+         * @param source The first vertex.
+         * @param target The last vertex.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         */
+
+        Path shortestPath(int source, int target);
+
+    };
+}
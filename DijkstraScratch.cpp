@@ -0,0 +1,107 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "DijkstraScratch.hpp"
+#include "Path.hpp"
+#include <stdexcept>
+
+graph::DijkstraScratch::DijkstraScratch(int vertices) : num_of_vertices(vertices), reached_count(0), source(-1), heap(64)
+{
+    distance = new long long[num_of_vertices];
+    parent = new int[num_of_vertices];
+    settled = new bool[num_of_vertices];
+    order = new int[num_of_vertices];
+    for (int v = 0; v < num_of_vertices; v++) // The only full initialization, later runs reset what they touched
+    {
+        distance[v] = Path::NO_PATH;
+        parent[v] = -1;
+        settled[v] = false;
+    }
+}
+
+graph::DijkstraScratch::~DijkstraScratch() // Destructor: frees the buffers
+{
+    delete[] distance;
+    delete[] parent;
+    delete[] settled;
+    delete[] order;
+}
+
+void graph::DijkstraScratch::run(const CSRGraph& g, int start_vertex)
+{
+    if (g.getNumOfVertices() != num_of_vertices)
+    {
+        throw std::invalid_argument("The graph does not have the number of vertices of the scratch buffers.");
+    }
+    if (start_vertex < 0 || start_vertex >= num_of_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid start vertex");
+    }
+
+    // A full run settles every vertex it gives a distance, so the reached list is exactly what must be reset
+    for (int i = 0; i < reached_count; i++)
+    {
+        int v = order[i];
+        distance[v] = Path::NO_PATH;
+        parent[v] = -1;
+        settled[v] = false;
+    }
+    reached_count = 0;
+    source = start_vertex;
+    heap.clear();
+
+    const int* offsets = g.getOffsets();
+    const int* dest_vertices = g.getDestVertices();
+    const int* weights = g.getWeights();
+
+    distance[start_vertex] = 0;
+    heap.push(0, start_vertex);
+    while (!heap.isEmpty())
+    {
+        int current = heap.pop();
+        if (settled[current]) continue; // A stale entry of an already settled vertex
+        settled[current] = true;
+        order[reached_count++] = current;
+
+        for (int i = offsets[current]; i < offsets[current + 1]; i++)
+        {
+            int neighbor = dest_vertices[i];
+            if (!settled[neighbor] && distance[current] + weights[i] < distance[neighbor])
+            {
+                distance[neighbor] = distance[current] + weights[i];
+                parent[neighbor] = current;
+                heap.push(distance[neighbor], neighbor);
+            }
+        }
+    }
+}
+
+int graph::DijkstraScratch::getNumOfVertices() const
+{
+    return this->num_of_vertices;
+}
+
+int graph::DijkstraScratch::getSource() const
+{
+    return this->source;
+}
+
+const long long* graph::DijkstraScratch::getDistances() const
+{
+    return this->distance;
+}
+
+const int* graph::DijkstraScratch::getParents() const
+{
+    return this->parent;
+}
+
+const int* graph::DijkstraScratch::getOrder() const
+{
+    return this->order;
+}
+
+int graph::DijkstraScratch::getReachedCount() const
+{
+    return this->reached_count;
+}
@@ -0,0 +1,105 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "CSRGraph.hpp"
+#include "MinHeap.hpp"
+
+namespace graph {
+
+    /**
+     * @brief Reusable buffers for running Dijkstra's algorithm from many sources over the same graph.
+     *
+     * The distance, parent and settled arrays are allocated once for the whole graph. A run only writes the
+     * entries of the vertices it reaches, and the next run resets exactly those (from the list of reached
+     * vertices) instead of the whole arrays, so a run from a source with a small reachable part is cheap
+     * even on a huge graph. The results of a run stay readable until the next run.
+     *
+     * One scratch object must not be used by two threads at once; the batch API gives every worker its own.
+     */
+
+    class DijkstraScratch
+    {
+
+        private:
+        int num_of_vertices; // Number of vertices of the graphs this scratch serves
+        long long* distance; // Distance of every vertex from the last source, Path::NO_PATH if unreached
+        int* parent; // Parent of every vertex in the last shortest path tree, -1 for the source and unreached vertices
+        bool* settled; // Whether every vertex was settled by the last run
+        int* order; // The vertices the last run reached, in the order they were settled
+        int reached_count; // Number of entries in order
+        int source; // The source of the last run, -1 before the first
+        MinHeap heap; // Kept between runs, so its array only grows once
+
+        public:
+
+        /**
+         * @brief Allocates the buffers for graphs with a given number of vertices.
+         * @param vertices The number of vertices.
+         */
+
+        DijkstraScratch(int vertices);
+
+        /**
+         * @brief Destructor. Frees the buffers.
+         */
+
+        ~DijkstraScratch();
+
+        DijkstraScratch(const DijkstraScratch&) = delete; // The buffers are owned, copying would double-free them
+        DijkstraScratch& operator=(const DijkstraScratch&) = delete;
+
+        /**
+         * @brief Runs Dijkstra's algorithm (binary heap) from a source, replacing the results of the previous run.
+         * @param g The graph, with getNumOfVertices() vertices and non-negative weights.
+         * @param start_vertex The source vertex.
+         * @throws std::out_of_range if start_vertex is invalid.
+         * @throws std::invalid_argument if g does not have the number of vertices of the scratch.
+         */
+
+        void run(const CSRGraph& g, int start_vertex);
+
+        /**
+         * @brief Returns the number of vertices.
+         * @return Number of vertices.
+         */
+
+        int getNumOfVertices() const;
+
+        /**
+         * @brief Returns the source of the last run.
+         * @return The source vertex, -1 before the first run.
+         */
+
+        int getSource() const;
+
+        /**
+         * @brief Returns the distances from the last source (getNumOfVertices() entries).
+         * @return A pointer to the distance array, Path::NO_PATH for unreached vertices.
+         */
+
+        const long long* getDistances() const;
+
+        /**
+         * @brief Returns the parents in the last shortest path tree (getNumOfVertices() entries).
+         * @return A pointer to the parent array, -1 for the source and unreached vertices.
+         */
+
+        const int* getParents() const;
+
+        /**
+         * @brief Returns the vertices the last run reached, closest first (getReachedCount() entries).
+         * @return A pointer to the order array.
+         */
+
+        const int* getOrder() const;
+
+        /**
+         * @brief Returns the number of vertices the last run reached, the source included.
+         * @return Number of reached vertices.
+         */
+
+        int getReachedCount() const;
+
+    };
+}
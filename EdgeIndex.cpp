@@ -0,0 +1,149 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "EdgeIndex.hpp"
+#include "Graph.hpp"
+
+namespace {
+
+    long long makeKey(int src, int dest) // Packs the vertex pair into one 64-bit key
+    {
+        return (static_cast<long long>(src) << 32) | static_cast<unsigned int>(dest);
+    }
+}
+
+graph::EdgeIndex::EdgeIndex(int expected_entries) : count(0)
+{
+    capacity = 16;
+    while (capacity < expected_entries * 2) // Keep the load factor at or below one half
+    {
+        capacity = capacity * 2;
+    }
+
+    slots = new Slot[capacity];
+    for (int i = 0; i < capacity; i++)
+    {
+        slots[i].edge = nullptr;
+    }
+}
+
+graph::EdgeIndex::~EdgeIndex() // Destructor: frees the table, the edges belong to the graph
+{
+    delete[] slots;
+}
+
+int graph::EdgeIndex::slotOf(long long key) const
+{
+    // splitmix64 finalizer, spreads neighboring vertex ids over the whole table
+    unsigned long long h = static_cast<unsigned long long>(key);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h = h ^ (h >> 31);
+    return static_cast<int>(h & static_cast<unsigned long long>(capacity - 1));
+}
+
+void graph::EdgeIndex::grow()
+{
+    Slot* old_slots = slots;
+    int old_capacity = capacity;
+
+    capacity = capacity * 2;
+    slots = new Slot[capacity];
+    for (int i = 0; i < capacity; i++)
+    {
+        slots[i].edge = nullptr;
+    }
+
+    for (int i = 0; i < old_capacity; i++) // Re-insert every occupied slot into the bigger table
+    {
+        if (old_slots[i].edge != nullptr)
+        {
+            int slot = slotOf(old_slots[i].key);
+            while (slots[slot].edge != nullptr)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            slots[slot] = old_slots[i];
+        }
+    }
+
+    delete[] old_slots;
+}
+
+void graph::EdgeIndex::insert(int src, int dest, Edge* edge)
+{
+    long long key = makeKey(src, dest);
+    int slot = slotOf(key);
+
+    while (slots[slot].edge != nullptr) // Linear probing until the key or an empty slot is found
+    {
+        if (slots[slot].key == key)
+        {
+            slots[slot].edge = edge; // Already indexed, replace the mapping
+            return;
+        }
+        slot = (slot + 1) & (capacity - 1);
+    }
+
+    slots[slot].key = key;
+    slots[slot].edge = edge;
+    count = count + 1;
+
+    if (count * 2 > capacity)
+    {
+        grow();
+    }
+}
+
+graph::Edge* graph::EdgeIndex::find(int src, int dest) const
+{
+    long long key = makeKey(src, dest);
+
+    for (int slot = slotOf(key); slots[slot].edge != nullptr; slot = (slot + 1) & (capacity - 1))
+    {
+        if (slots[slot].key == key)
+        {
+            return slots[slot].edge;
+        }
+    }
+
+    return nullptr; // Reached an empty slot, the key is not in the table
+}
+
+void graph::EdgeIndex::erase(int src, int dest)
+{
+    long long key = makeKey(src, dest);
+    int slot = slotOf(key);
+
+    while (slots[slot].edge != nullptr && slots[slot].key != key)
+    {
+        slot = (slot + 1) & (capacity - 1);
+    }
+
+    if (slots[slot].edge == nullptr) return; // Not indexed, nothing to erase
+
+    // Backward-shift deletion: move later entries of the probe run into the hole,
+    // so lookups never need tombstones
+    int hole = slot;
+    int next = (hole + 1) & (capacity - 1);
+    while (slots[next].edge != nullptr)
+    {
+        int home = slotOf(slots[next].key);
+        // The entry at next may fill the hole only if its home slot is not in (hole, next]
+        bool can_move = (hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (can_move)
+        {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+        next = (next + 1) & (capacity - 1);
+    }
+
+    slots[hole].edge = nullptr;
+    count = count - 1;
+}
+
+int graph::EdgeIndex::size() const
+{
+    return this->count;
+}
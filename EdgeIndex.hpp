@@ -0,0 +1,99 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+
+namespace graph {
+
+    struct Edge; // Defined in Graph.hpp, the index only stores pointers to it
+
+    /**
+     * @brief A hash table mapping a (src, dest) vertex pair to its Edge in the adjacency list.
+     *
+     * Uses open addressing with linear probing and a power-of-two capacity that doubles
+     * when the table is half full, so lookups, inserts and erases are O(1) amortized.
+     */
+
+    class EdgeIndex
+    {
+
+        private:
+
+        /**
+         * @brief One slot of the table. A slot is empty when edge is nullptr.
+         */
+
+        struct Slot {
+            long long key; // (src << 32) | dest
+            Edge* edge; // The indexed edge, or nullptr for an empty slot
+        };
+
+        Slot* slots; // The table itself
+        int capacity; // Number of slots, always a power of two
+        int count; // Number of occupied slots
+
+        /**
+         * @brief Doubles the capacity and re-inserts every entry.
+         */
+
+        void grow();
+
+        /**
+         * @brief Returns the home slot of a key.
+         */
+
+        int slotOf(long long key) const;
+
+        public:
+
+        /**
+         * @brief Constructs an empty index.
+         * @param expected_entries Number of entries to size the table for (default is 16).
+         */
+
+        EdgeIndex(int expected_entries = 16);
+
+        /**
+         * @brief Destructor. Frees the table (the edges are owned by the graph).
+         */
+
+        ~EdgeIndex();
+
+        EdgeIndex(const EdgeIndex&) = delete; // The table is owned, copying would double-free it
+        EdgeIndex& operator=(const EdgeIndex&) = delete;
+
+        /**
+         * @brief Maps (src, dest) to edge, replacing any previous mapping.
+         * @param src Source vertex.
+         * @param dest Destination vertex.
+         * @param edge The edge from src to dest.
+         */
+
+        void insert(int src, int dest, Edge* edge);
+
+        /**
+         * @brief Looks up the edge from src to dest.
+         * @param src Source vertex.
+         * @param dest Destination vertex.
+         * @return The edge, or nullptr if it is not indexed.
+         */
+
+        Edge* find(int src, int dest) const;
+
+        /**
+         * @brief Removes the mapping of (src, dest) if there is one.
+         * @param src Source vertex.
+         * @param dest Destination vertex.
+         */
+
+        void erase(int src, int dest);
+
+        /**
+         * @brief Returns the number of indexed edges.
+         * @return Number of entries.
+         */
+
+        int size() const;
+
+    };
+}
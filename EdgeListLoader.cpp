@@ -0,0 +1,321 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "EdgeListLoader.hpp"
+#include "GraphFile.hpp"
+#include "Parallel.hpp"
+#include <climits>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    const std::size_t MIN_CHUNK_BYTES = 1 << 16; // With the default thread count, no thread gets less than this to parse
+
+    enum class Format
+    {
+        Snap,
+        Dimacs
+    };
+
+    // The edges parsed from one chunk of the file, in file order
+    struct ChunkResult {
+        graph::EdgeTriple* edges = nullptr; // The parsed edges (0-based ids)
+        int count = 0; // Number of parsed edges
+        int capacity = 0; // Size of the edges array
+        long long max_vertex = -1; // Largest vertex id in the chunk (0-based), -1 if there is none
+        long long problem_vertices = -1; // n of the DIMACS problem line, if the chunk has one
+        int problem_lines = 0; // Number of DIMACS problem lines in the chunk
+        const char* error_line = nullptr; // Start of the first malformed line, nullptr if the chunk is fine
+        const char* error_message = nullptr; // What is wrong with it
+        std::exception_ptr failure; // An exception thrown while parsing (out of memory), rethrown after the join
+
+        ChunkResult() = default;
+        ~ChunkResult()
+        {
+            delete[] edges;
+        }
+        ChunkResult(const ChunkResult&) = delete; // The edge array is owned
+        ChunkResult& operator=(const ChunkResult&) = delete;
+    };
+
+    inline bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline void skipBlanks(const char*& p, const char* end)
+    {
+        while (p < end && isBlank(*p)) p++;
+    }
+
+    inline bool atLineEnd(const char* p, const char* end)
+    {
+        return p == end || *p == '\n';
+    }
+
+    inline bool isDigit(char c) // One unsigned compare instead of two
+    {
+        return static_cast<unsigned int>(c - '0') < 10u;
+    }
+
+    // Parses a decimal integer with an optional '-' sign, which must be followed by a blank or the end of the line.
+    // Values saturate just past the int range, so the caller can reject them without overflowing.
+    bool parseInteger(const char*& p, const char* end, long long& value)
+    {
+        skipBlanks(p, end);
+        bool negative = false;
+        if (p < end && *p == '-')
+        {
+            negative = true;
+            p++;
+        }
+        if (p == end || !isDigit(*p)) return false;
+
+        long long result = 0;
+        while (p < end && isDigit(*p))
+        {
+            if (result <= INT_MAX)
+            {
+                result = result * 10 + (*p - '0');
+            }
+            p++;
+        }
+        value = negative ? -result : result;
+        return atLineEnd(p, end) || isBlank(*p);
+    }
+
+    // Appends an edge to the chunk, growing its array geometrically
+    const char* addParsedEdge(ChunkResult& chunk, long long src, long long dest, long long weight)
+    {
+        if (chunk.count == chunk.capacity)
+        {
+            if (chunk.capacity == INT_MAX) return "Too many edges";
+            int bigger_capacity = chunk.capacity < 1024 ? 1024 : (chunk.capacity > INT_MAX / 2 ? INT_MAX : chunk.capacity * 2);
+            graph::EdgeTriple* bigger = new graph::EdgeTriple[bigger_capacity];
+            for (int i = 0; i < chunk.count; i++)
+            {
+                bigger[i] = chunk.edges[i];
+            }
+            delete[] chunk.edges;
+            chunk.edges = bigger;
+            chunk.capacity = bigger_capacity;
+        }
+        chunk.edges[chunk.count++] = {static_cast<int>(src), static_cast<int>(dest), static_cast<int>(weight)};
+        if (src > chunk.max_vertex) chunk.max_vertex = src;
+        if (dest > chunk.max_vertex) chunk.max_vertex = dest;
+        return nullptr;
+    }
+
+    // Parses one non-blank SNAP line starting at p: "src dest [weight]" or a comment. Returns an error message or nullptr.
+    const char* parseSnapLine(const char*& p, const char* end, ChunkResult& chunk)
+    {
+        if (*p == '#' || *p == '%') return nullptr; // Comment
+
+        long long src = 0;
+        long long dest = 0;
+        long long weight = 1;
+        if (!parseInteger(p, end, src) || !parseInteger(p, end, dest)) return "Malformed edge";
+        skipBlanks(p, end);
+        if (!atLineEnd(p, end))
+        {
+            if (!parseInteger(p, end, weight)) return "Malformed edge weight";
+            skipBlanks(p, end);
+            if (!atLineEnd(p, end)) return "Unexpected text after edge";
+        }
+        if (src < 0 || dest < 0 || src >= INT_MAX || dest >= INT_MAX) return "Invalid vertex id";
+        if (weight < INT_MIN || weight > INT_MAX) return "Edge weight out of range";
+        return addParsedEdge(chunk, src, dest, weight);
+    }
+
+    // Parses one non-blank DIMACS line starting at p: "c ...", "p sp n m" or "a u v w". Returns an error message or nullptr.
+    const char* parseDimacsLine(const char*& p, const char* end, ChunkResult& chunk)
+    {
+        char kind = *p;
+        if (kind == 'c') return nullptr; // Comment
+        p++;
+        if (!atLineEnd(p, end) && !isBlank(*p)) return "Unknown line type";
+
+        if (kind == 'p')
+        {
+            skipBlanks(p, end);
+            while (p < end && !isBlank(*p) && *p != '\n') p++; // The problem type ("sp")
+            long long vertices = 0;
+            long long arcs = 0;
+            if (!parseInteger(p, end, vertices) || !parseInteger(p, end, arcs)) return "Malformed problem line";
+            skipBlanks(p, end);
+            if (!atLineEnd(p, end)) return "Unexpected text after problem line";
+            if (vertices < 0 || vertices > INT_MAX) return "Invalid number of vertices";
+            chunk.problem_vertices = vertices;
+            chunk.problem_lines++;
+            return nullptr;
+        }
+        if (kind == 'a')
+        {
+            long long src = 0;
+            long long dest = 0;
+            long long weight = 0;
+            if (!parseInteger(p, end, src) || !parseInteger(p, end, dest) || !parseInteger(p, end, weight)) return "Malformed arc";
+            skipBlanks(p, end);
+            if (!atLineEnd(p, end)) return "Unexpected text after arc";
+            if (src < 1 || dest < 1 || src > INT_MAX || dest > INT_MAX) return "Invalid vertex id";
+            if (weight < INT_MIN || weight > INT_MAX) return "Arc weight out of range";
+            return addParsedEdge(chunk, src - 1, dest - 1, weight);
+        }
+        return "Unknown line type";
+    }
+
+    // Parses the whole lines in [begin, end), stopping at the first malformed one
+    void parseChunk(const char* begin, const char* end, Format format, ChunkResult& chunk)
+    {
+        const char* p = begin;
+        while (p < end)
+        {
+            const char* line = p;
+            skipBlanks(p, end);
+            if (!atLineEnd(p, end)) // Blank lines are skipped
+            {
+                const char* error = format == Format::Snap ? parseSnapLine(p, end, chunk) : parseDimacsLine(p, end, chunk);
+                if (error != nullptr)
+                {
+                    chunk.error_line = line;
+                    chunk.error_message = error;
+                    return;
+                }
+            }
+            while (p < end && *p != '\n') p++; // Skip the rest of the line (comments) and the newline
+            if (p < end) p++;
+        }
+    }
+
+    // Start of chunk c out of num_chunks: the first line that starts at or after c / num_chunks of the file
+    const char* chunkStart(const char* data, std::size_t size, int num_chunks, int c)
+    {
+        if (c == 0) return data;
+        if (c == num_chunks) return data + size;
+        const char* p = data + static_cast<std::size_t>(static_cast<unsigned long long>(size) * c / num_chunks);
+        while (p < data + size && p[-1] != '\n') p++;
+        return p;
+    }
+
+    graph::Graph loadEdgeList(const char* path, Format format, bool is_directed, graph::DuplicatePolicy policy, int num_threads)
+    {
+        graph::MappedFile file(path);
+        const char* data = reinterpret_cast<const char*>(file.getData());
+        std::size_t size = file.getSize();
+
+        int threads = graph::resolveThreadCount(num_threads);
+        if (num_threads < 1 && static_cast<std::size_t>(threads) > size / MIN_CHUNK_BYTES) // Small files are not worth the threads
+        {
+            threads = static_cast<int>(size / MIN_CHUNK_BYTES);
+        }
+        if (static_cast<std::size_t>(threads) > size)
+        {
+            threads = static_cast<int>(size);
+        }
+        if (threads < 1)
+        {
+            threads = 1;
+        }
+
+        // Every thread parses one chunk into its own array, so nothing is shared while parsing
+        ChunkResult* chunks = new ChunkResult[threads];
+        try // Every path out frees the chunks, an exception included
+        {
+            graph::parallelFor(0, threads, threads, [&](int, int first, int last)
+            {
+                for (int c = first; c < last; c++)
+                {
+                    try // parallelFor bodies must not throw
+                    {
+                        parseChunk(chunkStart(data, size, threads, c), chunkStart(data, size, threads, c + 1), format, chunks[c]);
+                    }
+                    catch (...)
+                    {
+                        chunks[c].failure = std::current_exception();
+                    }
+                }
+            });
+
+            for (int c = 0; c < threads; c++)
+            {
+                if (chunks[c].failure != nullptr)
+                {
+                    std::rethrow_exception(chunks[c].failure);
+                }
+            }
+
+            // Check the chunks in file order, so the reported error is the first one in the file
+            std::string error;
+            long long total_edges = 0;
+            long long max_vertex = -1;
+            long long problem_vertices = -1;
+            int problem_lines = 0;
+            for (int c = 0; c < threads && error.empty(); c++)
+            {
+                if (chunks[c].error_line != nullptr)
+                {
+                    long long line_number = 1;
+                    for (const char* p = data; p < chunks[c].error_line; p++)
+                    {
+                        if (*p == '\n') line_number++;
+                    }
+                    error = std::string(chunks[c].error_message) + " at line " + std::to_string(line_number) + " of " + path;
+                }
+                total_edges += chunks[c].count;
+                if (chunks[c].max_vertex > max_vertex) max_vertex = chunks[c].max_vertex;
+                if (chunks[c].problem_lines > 0) problem_vertices = chunks[c].problem_vertices;
+                problem_lines += chunks[c].problem_lines;
+            }
+
+            int num_vertices = static_cast<int>(max_vertex + 1);
+            if (error.empty() && format == Format::Dimacs)
+            {
+                if (problem_lines != 1)
+                {
+                    error = std::string("Expected exactly one problem line in ") + path;
+                }
+                else if (max_vertex >= problem_vertices)
+                {
+                    error = std::string("Arc vertex larger than the number of vertices in ") + path;
+                }
+                num_vertices = static_cast<int>(problem_vertices);
+            }
+            if (error.empty() && (is_directed ? total_edges : 2 * total_edges) > INT_MAX) // GraphBuilder::build stores undirected edges twice
+            {
+                error = std::string("Too many edges in ") + path;
+            }
+            if (!error.empty())
+            {
+                throw std::runtime_error(error);
+            }
+
+            graph::GraphBuilder builder(num_vertices, is_directed);
+            builder.reserve(static_cast<int>(total_edges));
+            for (int c = 0; c < threads; c++) // In file order, so KeepLast keeps the last line of the file
+            {
+                builder.addEdges(chunks[c].edges, chunks[c].count);
+            }
+            delete[] chunks; // The builder has its own copy, free the chunks before build() needs more memory
+            chunks = nullptr;
+            return builder.build(policy);
+        }
+        catch (...)
+        {
+            delete[] chunks;
+            throw;
+        }
+    }
+}
+
+graph::Graph graph::EdgeListLoader::loadSnap(const char* path, bool is_directed, DuplicatePolicy policy, int num_threads)
+{
+    return loadEdgeList(path, Format::Snap, is_directed, policy, num_threads);
+}
+
+graph::Graph graph::EdgeListLoader::loadDimacs(const char* path, DuplicatePolicy policy, int num_threads)
+{
+    return loadEdgeList(path, Format::Dimacs, true, policy, num_threads);
+}
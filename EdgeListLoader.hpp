@@ -0,0 +1,57 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "GraphBuilder.hpp"
+
+namespace graph {
+
+    /**
+     * @brief Loads graphs from text edge-list files.
+     *
+     * The file is mapped into memory (no stream reads), split into one chunk per thread at line boundaries,
+     * and every chunk is parsed in parallel by a hand-written integer scanner into its own edge array.
+     * The arrays are then handed to a GraphBuilder in file order, which builds the Graph in one pass.
+     * Parsing never goes through iostreams, so loading a large file is bounded by reading it.
+     *
+     * Two formats are supported:
+     * - SNAP: one "src dest" or "src dest weight" edge per line, 0-based ids, lines starting with '#' or '%'
+     *   are comments. The number of vertices is the largest id + 1, the weight defaults to 1.
+     * - DIMACS shortest path (.gr): a problem line "p sp n m", arcs "a u v w" with 1-based ids,
+     *   and comment lines starting with 'c'. Arcs are directed.
+     *
+     * Blank lines are skipped in both formats. Weights may be negative, ids and weights must fit an int.
+     */
+
+    class EdgeListLoader
+    {
+
+        public:
+
+        /**
+         * @brief Loads a SNAP-style edge list.
+         * @param path The file to load.
+         * @param is_directed Whether the edges are directed (default is false, each line adds an undirected edge).
+         * @param policy How to resolve an edge listed more than once (default is KeepLast).
+         * @param num_threads Number of parsing threads, values below 1 mean one per hardware thread (default).
+         * @return The loaded graph.
+         * @throws std::runtime_error if the file cannot be read or a line is malformed (the message gives the line number).
+         */
+
+        static Graph loadSnap(const char* path, bool is_directed = false, DuplicatePolicy policy = DuplicatePolicy::KeepLast, int num_threads = 0);
+
+        /**
+         * @brief Loads a DIMACS shortest path (.gr) file as a directed graph.
+         * @param path The file to load.
+         * @param policy How to resolve an arc listed more than once (default is KeepLast).
+         * @param num_threads Number of parsing threads, values below 1 mean one per hardware thread (default).
+         * @return The loaded graph, with vertex v of the file stored as vertex v - 1.
+         * @throws std::runtime_error if the file cannot be read, has no single problem line,
+         *         a line is malformed, or an arc uses a vertex outside 1..n.
+         */
+
+        static Graph loadDimacs(const char* path, DuplicatePolicy policy = DuplicatePolicy::KeepLast, int num_threads = 0);
+
+    };
+}
@@ -0,0 +1,116 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "EdgePool.hpp"
+#include "Graph.hpp"
+
+namespace {
+    const int MAX_SLAB_SIZE = 1 << 16; // Slabs stop doubling at 64K edges (about 1MB each)
+}
+
+graph::EdgePool::EdgePool(int initial_slab_size) : slabs(nullptr), used(0), next_slab_size(initial_slab_size), free_list(nullptr)
+{
+    if (next_slab_size < 1)
+    {
+        next_slab_size = 1;
+    }
+    if (next_slab_size > MAX_SLAB_SIZE) // A bigger block is what reserve() is for
+    {
+        next_slab_size = MAX_SLAB_SIZE;
+    }
+}
+
+graph::EdgePool::~EdgePool() // Destructor: frees every slab, the edges inside them go away with it
+{
+    freeSlabs();
+}
+
+graph::EdgePool::EdgePool(EdgePool&& other) noexcept
+    : slabs(other.slabs), used(other.used), next_slab_size(other.next_slab_size), free_list(other.free_list)
+{
+    // The edges stay where they are, so pointers into them (adjacency lists, edge index) remain valid
+    other.slabs = nullptr;
+    other.used = 0;
+    other.free_list = nullptr;
+}
+
+graph::EdgePool& graph::EdgePool::operator=(EdgePool&& other) noexcept
+{
+    if (this != &other)
+    {
+        freeSlabs();
+
+        slabs = other.slabs;
+        used = other.used;
+        next_slab_size = other.next_slab_size;
+        free_list = other.free_list;
+
+        other.slabs = nullptr;
+        other.used = 0;
+        other.free_list = nullptr;
+    }
+    return *this;
+}
+
+void graph::EdgePool::freeSlabs()
+{
+    while (slabs != nullptr)
+    {
+        Slab* temp = slabs;
+        slabs = slabs->next;
+        delete[] temp->edges;
+        delete temp;
+    }
+}
+
+graph::Edge* graph::EdgePool::allocate(int dest_vertex, int weight, Edge* next)
+{
+    Edge* edge;
+
+    if (free_list != nullptr) // Reuse a released edge first
+    {
+        edge = free_list;
+        free_list = free_list->next;
+    }
+    else
+    {
+        if (slabs == nullptr || used == slabs->capacity) // The newest slab is full, start a new one
+        {
+            slabs = new Slab{new Edge[next_slab_size], next_slab_size, slabs};
+            used = 0;
+            if (next_slab_size < MAX_SLAB_SIZE) // Grow geometrically so large graphs need few slabs
+            {
+                next_slab_size = (next_slab_size * 2 < MAX_SLAB_SIZE) ? next_slab_size * 2 : MAX_SLAB_SIZE;
+            }
+        }
+        edge = &slabs->edges[used++]; // Bump-pointer allocation
+    }
+
+    edge->dest_vertex = dest_vertex;
+    edge->weight = weight;
+    edge->next = next;
+    return edge;
+}
+
+void graph::EdgePool::release(Edge* edge)
+{
+    edge->next = free_list; // Push the edge onto the free list, its memory stays in the slab
+    free_list = edge;
+}
+
+void graph::EdgePool::reserve(int count)
+{
+    if (count < 1) return;
+    slabs = new Slab{new Edge[count], count, slabs}; // next_slab_size is left alone, later slabs stay bounded
+    used = 0;
+}
+
+long long graph::EdgePool::getCapacity() const
+{
+    long long capacity = 0;
+    for (Slab* slab = slabs; slab != nullptr; slab = slab->next)
+    {
+        capacity += slab->capacity;
+    }
+    return capacity;
+}
@@ -0,0 +1,111 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+
+namespace graph {
+
+    struct Edge; // Defined in Graph.hpp, the pool only hands out pointers to it
+
+    /**
+     * @brief A slab allocator for the Edge nodes of a Graph.
+     *
+     * Edges are carved out of large arrays (slabs) with a bump pointer, and edges that are
+     * released go onto a free list (linked through Edge::next) to be reused by the next allocation.
+     * Destroying the pool frees a handful of slabs instead of every edge one by one.
+     */
+
+    class EdgePool
+    {
+
+        private:
+
+        /**
+         * @brief One block of edges, slabs are kept in a singly linked list (newest first).
+         */
+
+        struct Slab {
+            Edge* edges; // The edges of this slab
+            int capacity; // Number of edges in this slab
+            Slab* next; // The previously allocated slab
+        };
+
+        Slab* slabs; // The newest slab, which is the one being bump-allocated from
+        int used; // Number of edges already handed out from the newest slab
+        int next_slab_size; // Capacity of the next slab to allocate (doubles up to a maximum)
+        Edge* free_list; // Released edges waiting to be reused
+
+        /**
+         * @brief Frees every slab and leaves the slab list empty.
+         */
+
+        void freeSlabs();
+
+        public:
+
+        /**
+         * @brief Constructs an empty pool. No memory is allocated until the first edge is requested.
+         * @param initial_slab_size Capacity of the first slab (default is 64, at most 64K).
+         */
+
+        EdgePool(int initial_slab_size = 64);
+
+        /**
+         * @brief Destructor. Frees every slab, which releases all edges handed out by the pool.
+         */
+
+        ~EdgePool();
+
+        /**
+         * @brief Move constructor. Takes over the slabs and free list of other in O(1), other is left empty.
+         */
+
+        EdgePool(EdgePool&& other) noexcept;
+
+        /**
+         * @brief Move assignment. Frees this pool's slabs and takes over the slabs and free list of other.
+         */
+
+        EdgePool& operator=(EdgePool&& other) noexcept;
+
+        EdgePool(const EdgePool&) = delete; // The slabs are owned, copying would double-free them
+        EdgePool& operator=(const EdgePool&) = delete;
+
+        /**
+         * @brief Returns a new edge initialized with the given fields.
+         * @param dest_vertex The destination vertex of the edge.
+         * @param weight The weight of the edge.
+         * @param next The next edge in the adjacency list.
+         * @return A pointer to the edge, owned by the pool.
+         */
+
+        Edge* allocate(int dest_vertex, int weight, Edge* next);
+
+        /**
+         * @brief Returns an edge to the pool so its memory can be reused.
+         * @param edge An edge previously returned by allocate() on this pool.
+         */
+
+        void release(Edge* edge);
+
+        /**
+         * @brief Allocates one slab with room for exactly count edges, so a known number of edges
+         *        (a copied graph) is bump-allocated from a single block.
+         *
+         * The slab sizes after it are not affected, they keep doubling up to 64K edges.
+         * Any room left in the current newest slab is not used.
+         *
+         * @param count Number of edges to make room for, nothing is allocated if it is below 1.
+         */
+
+        void reserve(int count);
+
+        /**
+         * @brief Returns the number of edges the slabs can hold in total.
+         * @return The sum of the slab capacities.
+         */
+
+        long long getCapacity() const;
+
+    };
+}
@@ -4,6 +4,7 @@
 #include "Graph.hpp"
 #include <iostream>
 #include <climits>
+#include <utility> // For std::move
 
 graph::Graph::Graph(int vertices) // Implementing a constructor for the graph
 {
@@ -15,23 +16,99 @@ graph::Graph::Graph(int vertices) // Implementing a constructor for the graph
         adj_list[i] = nullptr; // Initiallizes each entry in the adjacency list to nullptr,
         // meaning "This vertex (adj_list[i]) currently has no neighbours"
     }
+    edge_index = nullptr; // The edge index is off until enableEdgeIndex() is called
 
 }
 
 graph::Graph::~Graph() // Implementing a destructor for the graph
 {
+    delete[] adj_list; // The edges live in edge_pool's slabs, which its own destructor frees
+    delete edge_index;
+
+}
+
+graph::Graph::Graph(Graph&& other) noexcept
+    : num_of_vertices(other.num_of_vertices), adj_list(other.adj_list), edge_pool(std::move(other.edge_pool)), edge_index(other.edge_index)
+{
+    // Leave other as an empty graph with 0 vertices, its destructor then frees nothing
+    other.num_of_vertices = 0;
+    other.adj_list = nullptr;
+    other.edge_index = nullptr;
+}
+
+graph::Graph& graph::Graph::operator=(Graph&& other) noexcept
+{
+    if (this != &other)
+    {
+        delete[] adj_list;
+        delete edge_index;
+
+        num_of_vertices = other.num_of_vertices;
+        adj_list = other.adj_list;
+        edge_pool = std::move(other.edge_pool); // Frees this graph's edges, takes over other's
+        edge_index = other.edge_index;
+
+        other.num_of_vertices = 0;
+        other.adj_list = nullptr;
+        other.edge_index = nullptr;
+    }
+    return *this;
+}
+
+graph::Graph graph::Graph::clone() const
+{
+    int edge_count = 0;
     for (int i = 0; i < num_of_vertices; i++)
     {
-        Edge* current = adj_list[i];
-        while (current != nullptr)
+        for (Edge* edge = adj_list[i]; edge != nullptr; edge = edge->next)
         {
-            Edge* temp = current;
-            current = current->next;
-            delete temp;
+            edge_count++;
+        }
+    }
+
+    Graph copy(num_of_vertices);
+    copy.edge_pool.reserve(edge_count); // One slab that fits every edge
+
+    for (int i = 0; i < num_of_vertices; i++)
+    {
+        Edge** tail = &copy.adj_list[i]; // Append at the tail so the copied list keeps the same order
+        for (Edge* edge = adj_list[i]; edge != nullptr; edge = edge->next)
+        {
+            *tail = copy.edge_pool.allocate(edge->dest_vertex, edge->weight, nullptr);
+            tail = &(*tail)->next;
+        }
+    }
+
+    if (edge_index != nullptr)
+    {
+        copy.enableEdgeIndex();
+    }
+    return copy;
+}
+
+graph::Graph graph::Graph::reversed() const
+{
+    int edge_count = 0;
+    for (int i = 0; i < num_of_vertices; i++)
+    {
+        for (Edge* edge = adj_list[i]; edge != nullptr; edge = edge->next)
+        {
+            edge_count++;
         }
     }
-    delete[] adj_list;
 
+    Graph reverse(num_of_vertices);
+    reverse.edge_pool.reserve(edge_count); // One slab that fits every edge
+
+    for (int i = num_of_vertices - 1; i >= 0; i--) // Prepending from the last source leaves every list sorted by source
+    {
+        for (Edge* edge = adj_list[i]; edge != nullptr; edge = edge->next)
+        {
+            int dest = edge->dest_vertex;
+            reverse.adj_list[dest] = reverse.edge_pool.allocate(i, edge->weight, reverse.adj_list[dest]);
+        }
+    }
+    return reverse;
 }
 
 void graph::Graph::addEdge(int src_vertex, int dest_vertex, int weight)
@@ -46,25 +123,19 @@ void graph::Graph::addEdge(int src_vertex, int dest_vertex, int weight)
     bool updated_dest = false;
 
     // Check if edge from src to dest exists
-    for (Edge* curr = adj_list[src_vertex]; curr != nullptr; curr = curr->next)
+    Edge* src_edge = findEdge(src_vertex, dest_vertex);
+    if (src_edge != nullptr)
     {
-        if (curr->dest_vertex == dest_vertex)
-        {
-            curr->weight = weight;
-            updated_src = true;
-            break;
-        }
+        src_edge->weight = weight;
+        updated_src = true;
     }
 
     // Check if edge from dest to src exists
-    for (Edge* curr = adj_list[dest_vertex]; curr != nullptr; curr = curr->next)
+    Edge* dest_edge = findEdge(dest_vertex, src_vertex);
+    if (dest_edge != nullptr)
     {
-        if (curr->dest_vertex == src_vertex)
-        {
-            curr->weight = weight;
-            updated_dest = true;
-            break;
-        }
+        dest_edge->weight = weight;
+        updated_dest = true;
     }
 
     // The graph is undirected, so we need to create an edge from src_vertex to dest_vertex and another edge from dest_vertex to src_vertex with the same weight
@@ -73,15 +144,23 @@ void graph::Graph::addEdge(int src_vertex, int dest_vertex, int weight)
     // If not found, add new edge from src to dest
     if (!updated_src)
     {
-        Edge* src_to_dest = new Edge{dest_vertex, weight, adj_list[src_vertex]};
+        Edge* src_to_dest = edge_pool.allocate(dest_vertex, weight, adj_list[src_vertex]);
         adj_list[src_vertex] = src_to_dest;
+        if (edge_index != nullptr)
+        {
+            edge_index->insert(src_vertex, dest_vertex, src_to_dest);
+        }
     }
 
     // If not found, add new edge from dest to src
     if (!updated_dest)
     {
-        Edge* dest_to_src = new Edge{src_vertex, weight, adj_list[dest_vertex]};
+        Edge* dest_to_src = edge_pool.allocate(src_vertex, weight, adj_list[dest_vertex]);
         adj_list[dest_vertex] = dest_to_src;
+        if (edge_index != nullptr)
+        {
+            edge_index->insert(dest_vertex, src_vertex, dest_to_src);
+        }
     }
 }
 
@@ -93,17 +172,19 @@ void graph::Graph::addDirectedEdge(int src_vertex, int dest_vertex, int weight)
     }
 
     // Check if the edge already exists
-    for (Edge* curr = adj_list[src_vertex]; curr != nullptr; curr = curr->next)
+    Edge* existing = findEdge(src_vertex, dest_vertex);
+    if (existing != nullptr)
     {
-        if (curr->dest_vertex == dest_vertex)
-        {
-            curr->weight = weight; // Update weight if edge exists
-            return;
-        }
+        existing->weight = weight; // Update weight if edge exists
+        return;
     }
 
-    Edge* src_to_dest = new Edge{dest_vertex, weight, adj_list[src_vertex]};
+    Edge* src_to_dest = edge_pool.allocate(dest_vertex, weight, adj_list[src_vertex]);
     adj_list[src_vertex] = src_to_dest;
+    if (edge_index != nullptr)
+    {
+        edge_index->insert(src_vertex, dest_vertex, src_to_dest);
+    }
     
 }
 
@@ -115,38 +196,47 @@ void graph::Graph::removeEdge(int src, int dest)
         throw std::out_of_range("Invalid vertex index.");
     }
     // Remove dest from src's list of neighbors
-    Edge** current = &adj_list[src]; // A pointer to a pointer to the first neighbor of src
-    while (*current && (*current)->dest_vertex != dest) // Go over src neighbors' list to find dest, while its not empty
-    {
-        current = &((*current)->next);
-    }
-    if (*current)
+    if (!unlinkEdge(src, dest))
     {
-        Edge* to_delete = (*current);
-        *current = (*current)->next;
-        delete to_delete;
+        throw std::runtime_error("The edge does not exist.");
     }
-    else
+
+    // Remove src from dest's list of neighbors
+    if (!unlinkEdge(dest, src))
     {
-        throw std::runtime_error("The edge does not exist.");
+        throw std::runtime_error("The egde does not exist.");
     }
 
-    current = &adj_list[dest]; // A pointer to a pointer to the first neighbor of dest
-    while (*current && (*current)->dest_vertex != src) // Go over dest neighbors' list to find src, while its not empty
+}
+
+bool graph::Graph::unlinkEdge(int src, int dest)
+{
+    Edge** current = &adj_list[src]; // A pointer to a pointer to the first neighbor of src
+    while (*current && (*current)->dest_vertex != dest) // Go over src neighbors' list to find dest, while its not empty
     {
         current = &((*current)->next);
     }
-    if (*current)
+    if (*current == nullptr)
     {
-        Edge* to_delete = (*current);
-        *current = (*current)->next; // Replace whats inside the pointer with the one after it- unlinks the "to_delete" node from the list
-        delete to_delete;
+        return false;
     }
-    else
+
+    Edge* to_delete = (*current);
+    *current = (*current)->next; // Replace whats inside the pointer with the one after it- unlinks the "to_delete" node from the list
+    edge_pool.release(to_delete); // Back to the pool's free list for the next addEdge
+    if (edge_index != nullptr)
     {
-        throw std::runtime_error("The egde does not exist.");
+        edge_index->erase(src, dest);
+        for (Edge* next = *current; next != nullptr; next = next->next) // The next parallel edge is now the first one
+        {
+            if (next->dest_vertex == dest)
+            {
+                edge_index->insert(src, dest, next);
+                break;
+            }
+        }
     }
-
+    return true;
 }
 
 void graph::Graph::printGraph() const
@@ -182,15 +272,68 @@ int graph::Graph::getWeight(int src, int dest) const
         throw std::out_of_range("Invalid vertex. ");
     }
     
-    for (Edge* current = adj_list[src]; current != nullptr; current = current->next)
+    Edge* edge = findEdge(src, dest);
+    if (edge != nullptr)
+    {
+        return edge->weight;
+    }
+
+    return INT_MAX; // The edge doesnt exist, return infinity
+    
+}
+
+graph::Edge* graph::Graph::findEdge(int src, int dest) const
+{
+    if (edge_index != nullptr) // O(1) amortized hash lookup
+    {
+        return edge_index->find(src, dest);
+    }
+
+    for (Edge* current = adj_list[src]; current != nullptr; current = current->next) // Linear scan of src's neighbors
     {
         if (current->dest_vertex == dest)
         {
-            return current->weight;
+            return current;
         }
-        
     }
 
-    return INT_MAX; // The edge doesnt exist, return infinity
-    
+    return nullptr;
+}
+
+void graph::Graph::enableEdgeIndex()
+{
+    if (edge_index != nullptr) return; // Already enabled
+
+    int num_edges = 0;
+    for (int i = 0; i < num_of_vertices; i++)
+    {
+        for (Edge* current = adj_list[i]; current != nullptr; current = current->next)
+        {
+            num_edges++;
+        }
+    }
+
+    edge_index = new EdgeIndex(num_edges);
+    for (int i = 0; i < num_of_vertices; i++)
+    {
+        for (Edge* current = adj_list[i]; current != nullptr; current = current->next)
+        {
+            // If a pair appears twice, keep the edge nearest the head, the same one a linear scan would find
+            if (edge_index->find(i, current->dest_vertex) == nullptr)
+            {
+                edge_index->insert(i, current->dest_vertex, current);
+            }
+        }
+    }
+}
+
+void graph::Graph::disableEdgeIndex()
+{
+    delete edge_index;
+    edge_index = nullptr;
+}
+
+bool graph::Graph::hasEdgeIndex() const
+{
+    return this->edge_index != nullptr;
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #pragma once
 #include <iostream>
+#include "EdgePool.hpp"
+#include "EdgeIndex.hpp"
  
 namespace graph {
 
@@ -26,6 +28,25 @@ namespace graph {
         private:
         int num_of_vertices; // Number of vertices in the graph
         Edge** adj_list; // Array of pointers to adjacency lists for each vertex
+        EdgePool edge_pool; // Owns the memory of every Edge in adj_list
+        EdgeIndex* edge_index; // Optional (src, dest) -> Edge hash index, nullptr when disabled
+
+        /**
+         * @brief Finds the edge from src to dest, using the edge index when it is enabled.
+         * @return The edge, or nullptr if it doesn't exist.
+         */
+
+        Edge* findEdge(int src, int dest) const;
+
+        /**
+         * @brief Unlinks the first edge from src to dest and returns it to the pool. With the edge index on,
+         *        a parallel edge further down the list (from GraphBuilder with KeepAll) takes its place in the index.
+         * @return False if there is no such edge.
+         */
+
+        bool unlinkEdge(int src, int dest);
+
+        friend class GraphBuilder; // Links adjacency lists directly when building a graph in bulk
 
         public:
 
@@ -38,10 +59,50 @@ namespace graph {
 
         /**
          * @brief Destructor to clean up dynamic memory used by the graph.
+         * 
+         * The edges themselves are released in bulk by the edge pool.
          */
 
         ~Graph(); 
 
+        /**
+         * @brief Move constructor. Takes over the adjacency lists, edges and edge index of other in O(1).
+         * 
+         * Other is left as a graph with 0 vertices.
+         */
+
+        Graph(Graph&& other) noexcept;
+
+        /**
+         * @brief Move assignment. Frees this graph and takes over the adjacency lists, edges and edge index of other.
+         */
+
+        Graph& operator=(Graph&& other) noexcept;
+
+        Graph(const Graph&) = delete; // Copying every edge is expensive, use clone() to do it explicitly
+        Graph& operator=(const Graph&) = delete;
+
+        /**
+         * @brief Returns a deep copy of the graph.
+         * 
+         * The adjacency lists keep their order, and the copy has an edge index if this graph has one.
+         * 
+         * @return A new graph with the same vertices and edges.
+         */
+
+        Graph clone() const;
+
+        /**
+         * @brief Returns the reverse (transpose) of the graph: an edge dest -> src with the same weight for every edge src -> dest.
+         * 
+         * The incoming edges of a vertex are its outgoing edges in the reverse graph, which is what a backward search walks.
+         * Each reversed list is ordered by source vertex. An undirected graph stores both directions, so it is its own reverse.
+         * 
+         * @return A new graph with the same vertices and every edge reversed.
+         */
+
+        Graph reversed() const;
+
         /**
          * @brief Adds an undirected edge between two vertices with an optional weight.
          * @param src_vertex Source vertex index.
@@ -102,6 +163,29 @@ namespace graph {
 
         int getWeight(int src, int dest) const;
 
+        /**
+         * @brief Builds a hash index over all current edges and keeps it up to date from now on.
+         * 
+         * With the index enabled, getWeight() and the duplicate checks in addEdge() and addDirectedEdge()
+         * are O(1) amortized instead of a scan over the source vertex's adjacency list.
+         * Calling it when the index is already enabled does nothing.
+         */
+
+        void enableEdgeIndex();
+
+        /**
+         * @brief Drops the edge index and frees its memory, lookups go back to scanning the adjacency lists.
+         */
+
+        void disableEdgeIndex();
+
+        /**
+         * @brief Checks whether the edge index is enabled.
+         * @return true if the edge index is enabled, false otherwise.
+         */
+
+        bool hasEdgeIndex() const;
+
     };
 
     /**
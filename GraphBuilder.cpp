@@ -0,0 +1,193 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "GraphBuilder.hpp"
+#include <climits>
+#include <stdexcept>
+
+namespace {
+
+    // The capacity after growing from capacity to hold at least needed edges: doubled, but never past INT_MAX
+    int grownCapacity(int capacity, long long needed)
+    {
+        long long doubled = capacity < 16 ? 16 : 2LL * capacity;
+        long long grown = needed > doubled ? needed : doubled;
+        return grown > INT_MAX ? INT_MAX : static_cast<int>(grown);
+    }
+
+    // Stable counting sort of edges by src (by_src == true) or by dest, from input into output
+    void countingSort(const graph::EdgeTriple* input, graph::EdgeTriple* output, int count, int num_vertices, bool by_src)
+    {
+        int* position = new int[num_vertices + 1]{0};
+
+        for (int i = 0; i < count; i++) // Count the edges of every key
+        {
+            int key = by_src ? input[i].src : input[i].dest;
+            position[key + 1]++;
+        }
+        for (int v = 0; v < num_vertices; v++) // Prefix sums give the first output slot of every key
+        {
+            position[v + 1] += position[v];
+        }
+        for (int i = 0; i < count; i++) // Scatter in input order, so equal keys keep their relative order
+        {
+            int key = by_src ? input[i].src : input[i].dest;
+            output[position[key]++] = input[i];
+        }
+
+        delete[] position;
+    }
+}
+
+graph::GraphBuilder::GraphBuilder(int vertices, bool is_directed)
+    : num_of_vertices(vertices), directed(is_directed), edges(nullptr), edge_count(0), capacity(0)
+{
+}
+
+graph::GraphBuilder::~GraphBuilder() // Destructor: frees the collected edges
+{
+    delete[] edges;
+}
+
+void graph::GraphBuilder::reserve(int num_edges)
+{
+    if (num_edges <= capacity) return;
+
+    EdgeTriple* bigger = new EdgeTriple[num_edges];
+    for (int i = 0; i < edge_count; i++)
+    {
+        bigger[i] = edges[i];
+    }
+    delete[] edges;
+    edges = bigger;
+    capacity = num_edges;
+}
+
+void graph::GraphBuilder::addEdge(int src_vertex, int dest_vertex, int weight)
+{
+    if (src_vertex < 0 || src_vertex > num_of_vertices - 1 || dest_vertex < 0 || dest_vertex > num_of_vertices - 1)
+    {
+        throw std::out_of_range("Invalid vertex index.");
+    }
+
+    if (edge_count == INT_MAX)
+    {
+        throw std::length_error("A GraphBuilder holds at most INT_MAX edges.");
+    }
+    if (edge_count == capacity) // Grow geometrically so adding edges one by one is amortized O(1)
+    {
+        reserve(grownCapacity(capacity, static_cast<long long>(edge_count) + 1));
+    }
+    edges[edge_count++] = {src_vertex, dest_vertex, weight};
+}
+
+void graph::GraphBuilder::addEdges(const EdgeTriple* batch, int batch_size)
+{
+    long long needed = static_cast<long long>(edge_count) + batch_size;
+    if (needed > INT_MAX) // Checked before the batch is read
+    {
+        throw std::length_error("A GraphBuilder holds at most INT_MAX edges.");
+    }
+    for (int i = 0; i < batch_size; i++) // Validate the whole batch first so a bad edge adds nothing
+    {
+        if (batch[i].src < 0 || batch[i].src > num_of_vertices - 1 || batch[i].dest < 0 || batch[i].dest > num_of_vertices - 1)
+        {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+    }
+
+    if (needed > capacity)
+    {
+        reserve(grownCapacity(capacity, needed));
+    }
+    for (int i = 0; i < batch_size; i++)
+    {
+        edges[edge_count++] = batch[i];
+    }
+}
+
+int graph::GraphBuilder::getNumOfEdges() const
+{
+    return this->edge_count;
+}
+
+graph::Graph graph::GraphBuilder::build(DuplicatePolicy policy) const
+{
+    // Expand undirected edges into both directions. A self-loop gets two copies too, as Graph::addEdge stores it
+    long long expanded_size = directed ? edge_count : 2LL * edge_count;
+    if (expanded_size > INT_MAX) // The sorts and the expanded array count edge entries in int
+    {
+        throw std::length_error("The undirected graph has more than INT_MAX edge entries in both directions.");
+    }
+    int expanded_count = 0;
+    EdgeTriple* expanded = new EdgeTriple[expanded_size];
+    for (int i = 0; i < edge_count; i++)
+    {
+        expanded[expanded_count++] = edges[i];
+        if (!directed)
+        {
+            expanded[expanded_count++] = {edges[i].dest, edges[i].src, edges[i].weight};
+        }
+    }
+
+    // Sort by (src, dest): by dest first, then stably by src. Duplicates stay in insertion order.
+    EdgeTriple* sorted = new EdgeTriple[expanded_count];
+    countingSort(expanded, sorted, expanded_count, num_of_vertices, false);
+    countingSort(sorted, expanded, expanded_count, num_of_vertices, true);
+    delete[] sorted;
+    sorted = expanded;
+
+    // Resolve duplicates in place, each run of equal (src, dest) collapses according to the policy
+    int kept = 0;
+    int i = 0;
+    while (i < expanded_count)
+    {
+        int run_end = i + 1;
+        while (run_end < expanded_count && sorted[run_end].src == sorted[i].src && sorted[run_end].dest == sorted[i].dest)
+        {
+            run_end++;
+        }
+
+        if (policy == DuplicatePolicy::KeepAll)
+        {
+            for (int k = i; k < run_end; k++)
+            {
+                sorted[kept++] = sorted[k];
+            }
+        }
+        else
+        {
+            int chosen = run_end - 1; // KeepLast
+            if (policy == DuplicatePolicy::KeepMin)
+            {
+                chosen = i;
+                for (int k = i + 1; k < run_end; k++)
+                {
+                    if (sorted[k].weight < sorted[chosen].weight)
+                    {
+                        chosen = k;
+                    }
+                }
+            }
+            EdgeTriple edge = sorted[chosen];
+            sorted[kept++] = edge;
+            if (!directed && edge.src == edge.dest) // Both copies of an undirected self-loop stay, the run holds at least two
+            {
+                sorted[kept++] = edge;
+            }
+        }
+
+        i = run_end;
+    }
+
+    // Link the adjacency lists in one backward sweep: prepending in reverse order leaves each list sorted by dest
+    Graph g(num_of_vertices);
+    for (int k = kept - 1; k >= 0; k--)
+    {
+        int src = sorted[k].src;
+        g.adj_list[src] = g.edge_pool.allocate(sorted[k].dest, sorted[k].weight, g.adj_list[src]);
+    }
+
+    delete[] sorted;
+    return g;
+}
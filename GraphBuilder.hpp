@@ -0,0 +1,116 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+
+namespace graph {
+
+    /**
+     * @brief A (src, dest, weight) edge as handed to the GraphBuilder.
+     */
+
+    struct EdgeTriple {
+        int src; // Source vertex
+        int dest; // Destination vertex
+        int weight; // Weight of the edge
+    };
+
+    /**
+     * @brief What to do with several edges between the same pair of vertices.
+     */
+
+    enum class DuplicatePolicy
+    {
+        KeepLast, // Keep the edge added last, like repeated calls to addEdge()
+        KeepMin, // Keep the edge with the smallest weight
+        KeepAll // Keep every edge (parallel edges)
+    };
+
+    /**
+     * @brief Collects a batch of edges and builds a Graph from them in one pass.
+     *
+     * Instead of a duplicate scan and an allocation per addEdge() call, the builder sorts all edges
+     * by (src, dest) with two linear counting sorts, resolves duplicates with a DuplicatePolicy,
+     * and links the adjacency lists in a single sweep. Each resulting adjacency list is ordered
+     * by ascending destination vertex.
+     */
+
+    class GraphBuilder
+    {
+
+        private:
+        int num_of_vertices; // Number of vertices of the graph being built
+        bool directed; // If false, every edge is added in both directions
+        EdgeTriple* edges; // The collected edges, in insertion order
+        int edge_count; // Number of collected edges
+        int capacity; // Size of the edges array
+
+        public:
+
+        /**
+         * @brief Constructs an empty builder.
+         * @param vertices The number of vertices in the graph to build.
+         * @param is_directed Whether edges are directed (default is false, undirected).
+         */
+
+        GraphBuilder(int vertices, bool is_directed = false);
+
+        /**
+         * @brief Destructor. Frees the collected edges.
+         */
+
+        ~GraphBuilder();
+
+        GraphBuilder(const GraphBuilder&) = delete; // The edge array is owned, copying would double-free it
+        GraphBuilder& operator=(const GraphBuilder&) = delete;
+
+        /**
+         * @brief Makes room for at least the given number of edges.
+         * @param num_edges The total number of edges expected.
+         */
+
+        void reserve(int num_edges);
+
+        /**
+         * @brief Adds one edge to the batch.
+         * @param src_vertex Source vertex index.
+         * @param dest_vertex Destination vertex index.
+         * @param weight Weight of the edge (default is 1).
+         * @throws std::out_of_range if any vertex index is invalid.
+         * @throws std::length_error if the builder already holds INT_MAX edges.
+         */
+
+        void addEdge(int src_vertex, int dest_vertex, int weight = 1);
+
+        /**
+         * @brief Adds an array of edges to the batch.
+         * @param batch The edges to add.
+         * @param batch_size Number of edges in the array.
+         * @throws std::out_of_range if any vertex index is invalid (no edge of the batch is added).
+         * @throws std::length_error if the builder would hold more than INT_MAX edges (no edge of the batch is added).
+         */
+
+        void addEdges(const EdgeTriple* batch, int batch_size);
+
+        /**
+         * @brief Returns the number of edges collected so far.
+         * @return Number of edges.
+         */
+
+        int getNumOfEdges() const;
+
+        /**
+         * @brief Builds the graph from the collected edges.
+         *
+         * An undirected self-loop is stored twice, as addEdge() stores it (KeepAll keeps both copies of every one). The builder can be built again or extended afterwards.
+         *
+         * @param policy How to resolve several edges between the same ordered pair (default is KeepLast).
+         * @return The built graph.
+         * @throws std::length_error if an undirected graph has more than INT_MAX edge entries (both directions counted).
+         */
+
+        Graph build(DuplicatePolicy policy = DuplicatePolicy::KeepLast) const;
+
+    };
+}
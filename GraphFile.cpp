@@ -0,0 +1,152 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "GraphFile.hpp"
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char graph::GRAPH_FILE_MAGIC[8] = {'N', 'P', 'C', 'S', 'R', 'G', 'R', '\0'};
+
+graph::GraphFileChecksum::GraphFileChecksum() : state(0xcbf29ce484222325ULL) {} // Starts from the FNV offset basis
+
+void graph::GraphFileChecksum::update(const void* data, std::size_t bytes) // Mixes in one 8-byte word at a time
+{
+    const unsigned char* source = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < bytes; i += 8)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, source + i, bytes - i < 8 ? bytes - i : 8); // The last word is zero-padded
+        state = (state ^ word) * 0x100000001b3ULL;
+        state ^= state >> 29;
+    }
+}
+
+std::uint64_t graph::GraphFileChecksum::getValue() const
+{
+    return state;
+}
+
+graph::MappedFile::MappedFile(const char* path) : data(nullptr), size(0) // Maps the whole file read-only
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error(std::string("Cannot open graph file ") + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw std::runtime_error(std::string("Cannot read graph file ") + path);
+    }
+    size = static_cast<std::size_t>(info.st_size);
+
+    if (size > 0) // mmap rejects an empty range; an empty file fails the header check instead
+    {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error(std::string("Cannot map graph file ") + path);
+        }
+        data = mapping;
+    }
+    close(fd); // The mapping stays valid after the descriptor is closed
+}
+
+graph::MappedFile::~MappedFile() // Destructor: unmaps the file
+{
+    if (data != nullptr)
+    {
+        munmap(data, size);
+    }
+}
+
+const unsigned char* graph::MappedFile::getData() const
+{
+    return static_cast<const unsigned char*>(data);
+}
+
+std::size_t graph::MappedFile::getSize() const
+{
+    return size;
+}
+
+std::uint64_t graph::graphFileSectionsChecksum(const GraphFileSection* sections, int num_sections)
+{
+    GraphFileChecksum checksum;
+    for (int s = 0; s < num_sections; s++)
+    {
+        checksum.update(sections[s].data, sections[s].bytes);
+    }
+    return checksum.getValue();
+}
+
+void graph::writeGraphFileSections(const char* path, const char* kind, const void* file_header, std::size_t header_size,
+                                   const GraphFileSection* sections, int num_sections)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error(std::string("Cannot create ") + kind + " file " + path);
+    }
+    const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    out.write(static_cast<const char*>(file_header), static_cast<std::streamsize>(header_size));
+    for (int s = 0; s < num_sections; s++) // Every section padded to 8 bytes, as the checksum hashes it
+    {
+        if (sections[s].bytes > 0)
+        {
+            out.write(static_cast<const char*>(sections[s].data), static_cast<std::streamsize>(sections[s].bytes));
+        }
+        out.write(padding, static_cast<std::streamsize>(graphFilePadded(sections[s].bytes) - sections[s].bytes));
+    }
+    out.flush();
+    if (!out)
+    {
+        throw std::runtime_error(std::string("Cannot write ") + kind + " file " + path);
+    }
+}
+
+void graph::checkSectionFile(const MappedFile& file, const char* kind, std::size_t header_size, std::uint64_t checksum,
+                             const std::uint64_t* section_bytes, int num_sections)
+{
+    std::uint64_t expected_size = header_size;
+    for (int s = 0; s < num_sections; s++)
+    {
+        expected_size += graphFilePadded(section_bytes[s]);
+    }
+    if (expected_size != file.getSize())
+    {
+        throw std::runtime_error(std::string("The ") + kind + " file is truncated or its sections are corrupted.");
+    }
+
+    GraphFileChecksum file_checksum;
+    const unsigned char* position = file.getData() + header_size;
+    for (int s = 0; s < num_sections; s++)
+    {
+        file_checksum.update(position, section_bytes[s]);
+        position += graphFilePadded(section_bytes[s]);
+    }
+    if (file_checksum.getValue() != checksum)
+    {
+        throw std::runtime_error(std::string("The ") + kind + " file failed its checksum.");
+    }
+}
+
+void graph::copySectionFile(const MappedFile& file, std::size_t header_size, const std::uint64_t* section_bytes,
+                            void* const* destinations, int num_sections)
+{
+    const unsigned char* position = file.getData() + header_size;
+    for (int s = 0; s < num_sections; s++)
+    {
+        if (section_bytes[s] > 0)
+        {
+            std::memcpy(destinations[s], position, section_bytes[s]);
+        }
+        position += graphFilePadded(section_bytes[s]);
+    }
+}
@@ -0,0 +1,502 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "GraphTypes.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace graph {
+
+    constexpr std::uint32_t GRAPH_FILE_VERSION = 1; // Bumped on any incompatible change of the layout
+    constexpr std::uint32_t GRAPH_FILE_BYTE_ORDER = 0x01020304; // Reads back differently on a machine of the other endianness
+
+    /**
+     * @brief The fixed-size header at the start of a binary graph file.
+     *
+     * The header is followed by three sections, each starting on an 8-byte boundary and zero-padded
+     * to a multiple of 8 bytes: the offsets array, the destination array and (if the graph is weighted)
+     * the weight array, stored exactly as in memory. Loading a file is therefore a single mmap.
+     * The checksum covers every byte after the header.
+     */
+
+    struct GraphFileHeader {
+        char magic[8]; // GRAPH_FILE_MAGIC
+        std::uint32_t version; // GRAPH_FILE_VERSION of the writer
+        std::uint32_t byte_order; // GRAPH_FILE_BYTE_ORDER as written by the writer
+        std::uint8_t vertex_id_size; // sizeof(VertexId)
+        std::uint8_t edge_id_size; // sizeof(EdgeId)
+        std::uint8_t weight_size; // sizeof(Weight), 0 for NoWeight
+        std::uint8_t weight_kind; // One of the GraphFileWeightKind values
+        std::uint32_t reserved; // Always 0
+        std::uint64_t num_vertices; // Number of vertices
+        std::uint64_t num_edges; // Number of stored (directed) edge entries
+        std::uint64_t offsets_position; // Byte position of the offsets section in the file
+        std::uint64_t targets_position; // Byte position of the destination section
+        std::uint64_t weights_position; // Byte position of the weight section, 0 for an unweighted graph
+        std::uint64_t checksum; // GraphFileChecksum of the sections
+    };
+
+    static_assert(sizeof(GraphFileHeader) == 72, "The graph file header must have the same layout everywhere");
+
+    extern const char GRAPH_FILE_MAGIC[8]; // "NPCSRGR" followed by a 0 byte
+
+    /**
+     * @brief How the weights of a graph file are interpreted, so a float file is not opened as int.
+     */
+
+    enum GraphFileWeightKind : std::uint8_t {
+        WEIGHT_NONE = 0,
+        WEIGHT_UNSIGNED = 1,
+        WEIGHT_SIGNED = 2,
+        WEIGHT_FLOATING = 3
+    };
+
+    /**
+     * @brief A 64-bit checksum of the sections of a graph file, fed one section at a time.
+     *
+     * The data is hashed as 8-byte words (the last word of a section is zero-padded, as it is in the file),
+     * so hashing the sections one by one gives the same value as hashing the file's section area at once.
+     * It detects corrupted or truncated files; it is not a cryptographic hash.
+     */
+
+    class GraphFileChecksum {
+
+        private:
+        std::uint64_t state; // The running hash
+
+        public:
+        GraphFileChecksum();
+
+        /**
+         * @brief Hashes one section.
+         * @param data The section data.
+         * @param bytes The size of the section in bytes (before padding).
+         */
+
+        void update(const void* data, std::size_t bytes);
+
+        /**
+         * @brief Returns the checksum of everything hashed so far.
+         */
+
+        std::uint64_t getValue() const;
+    };
+
+    /**
+     * @brief A read-only memory mapping of a whole file. Unmapped when destroyed.
+     */
+
+    class MappedFile {
+
+        private:
+        void* data; // Start of the mapping (nullptr for an empty file)
+        std::size_t size; // Size of the file in bytes
+
+        public:
+
+        /**
+         * @brief Maps a file read-only.
+         * @param path The file to map.
+         * @throws std::runtime_error if the file cannot be opened or mapped.
+         */
+
+        explicit MappedFile(const char* path);
+
+        /**
+         * @brief Destructor. Unmaps the file.
+         */
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete; // The mapping is owned, copying would unmap it twice
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Returns the mapped bytes.
+         */
+
+        const unsigned char* getData() const;
+
+        /**
+         * @brief Returns the size of the file in bytes.
+         */
+
+        std::size_t getSize() const;
+    };
+
+    /**
+     * @brief A CSR graph stored in a binary file, opened by mapping the file into memory.
+     *
+     * save() writes a graph in the GraphFileHeader layout. Opening a file maps it and wraps the mapped
+     * sections in a BasicCSRGraph view, so there is no parsing and no copy: startup costs one mmap,
+     * pages are read from disk as the algorithms touch them, and processes opening the same file share
+     * them through the page cache. getGraph() can be passed to every CSR overload in Algorithms.
+     *
+     * Opening checks the header (magic, version, byte order, element types) and that the sections fit
+     * in the file. The checksum covers the whole graph, so checking it reads every page; it is done only
+     * when asked for (verify_checksum, or verifyChecksum() later).
+     *
+     * @tparam VertexId, Weight, EdgeId The element types, as in BasicCSRGraph. They must match the file.
+     */
+
+    template <typename VertexId, typename Weight, typename EdgeId = VertexId>
+    class BasicMappedGraph
+    {
+
+        public:
+        using CSR = BasicCSRGraph<VertexId, Weight, EdgeId>; // The graph type the file is viewed as
+
+        private:
+        MappedFile file; // The mapping, must outlive graph
+        const GraphFileHeader& header; // The header at the start of the mapping
+        CSR graph; // A view over the sections of the mapping
+
+        static const GraphFileHeader& checkHeader(const MappedFile& file, bool verify_checksum);
+
+        template <typename T>
+        const T* section(std::uint64_t position) const
+        {
+            return reinterpret_cast<const T*>(file.getData() + position);
+        }
+
+        public:
+
+        /**
+         * @brief Opens a graph file.
+         * @param path The file to open.
+         * @param verify_checksum If true, also check the checksum of the whole file (reads every page).
+         * @throws std::runtime_error if the file cannot be mapped, is not a graph file of this version,
+         *         was written with other element types, is truncated, or fails the checksum.
+         */
+
+        explicit BasicMappedGraph(const char* path, bool verify_checksum = false)
+            : file(path), header(checkHeader(file, verify_checksum)),
+              graph(static_cast<VertexId>(header.num_vertices), section<EdgeId>(header.offsets_position),
+                    section<VertexId>(header.targets_position),
+                    CSR::HAS_WEIGHTS ? section<Weight>(header.weights_position) : nullptr)
+        {
+        }
+
+        BasicMappedGraph(const BasicMappedGraph&) = delete; // The mapping is owned
+        BasicMappedGraph& operator=(const BasicMappedGraph&) = delete;
+
+        /**
+         * @brief Returns the mapped graph.
+         * @return A CSR view over the mapped file, valid as long as this object.
+         */
+
+        const CSR& getGraph() const
+        {
+            return graph;
+        }
+
+        /**
+         * @brief Returns the format version the file was written with.
+         */
+
+        std::uint32_t getVersion() const
+        {
+            return header.version;
+        }
+
+        /**
+         * @brief Recomputes the checksum of the file and compares it with the one in the header.
+         * @return true if the file is intact.
+         */
+
+        bool verifyChecksum() const
+        {
+            GraphFileChecksum checksum;
+            checksum.update(file.getData() + sizeof(GraphFileHeader), file.getSize() - sizeof(GraphFileHeader));
+            return checksum.getValue() == header.checksum;
+        }
+
+        /**
+         * @brief Writes a CSR graph to a binary graph file.
+         * @param g The graph to write.
+         * @param path The file to create (overwritten if it exists).
+         * @throws std::runtime_error if the file cannot be written.
+         */
+
+        static void save(const CSR& g, const char* path);
+
+        /**
+         * @brief Freezes a graph and writes it to a binary graph file.
+         * @param g The graph to write.
+         * @param path The file to create (overwritten if it exists).
+         * @throws std::runtime_error if the file cannot be written.
+         */
+
+        static void save(const Graph& g, const char* path)
+        {
+            CSR csr(g);
+            save(csr, path);
+        }
+    };
+
+    /**
+     * @brief A graph file over int vertex ids and int weights, viewed as a CSRGraph.
+     */
+
+    using MappedGraph = BasicMappedGraph<int, int>;
+
+    /**
+     * @brief Describes a weight type in the header.
+     */
+
+    template <typename Weight>
+    constexpr std::uint8_t graphFileWeightKind()
+    {
+        if constexpr (!WeightTraits<Weight>::HAS_WEIGHTS)
+        {
+            return WEIGHT_NONE;
+        }
+        else if constexpr (std::is_floating_point<Weight>::value)
+        {
+            return WEIGHT_FLOATING;
+        }
+        else if constexpr (std::is_signed<Weight>::value)
+        {
+            return WEIGHT_SIGNED;
+        }
+        else
+        {
+            return WEIGHT_UNSIGNED;
+        }
+    }
+
+    /**
+     * @brief Rounds a section size up to the 8-byte alignment of the file layout.
+     */
+
+    inline std::uint64_t graphFilePadded(std::uint64_t bytes)
+    {
+        return (bytes + 7) / 8 * 8;
+    }
+
+    /**
+     * @brief One array of a section file: its data and its size in bytes (before padding).
+     */
+
+    struct GraphFileSection {
+        const void* data; // The array, may be nullptr when bytes is 0
+        std::uint64_t bytes; // Size of the array in bytes
+    };
+
+    /**
+     * @brief Returns the GraphFileChecksum of a list of sections, as a section file stores it.
+     */
+
+    std::uint64_t graphFileSectionsChecksum(const GraphFileSection* sections, int num_sections);
+
+    /**
+     * @brief Writes a header of header_size bytes, then every section zero-padded to a multiple of 8 bytes.
+     * @param kind The file type named in error messages ("graph", "hierarchy", "landmark").
+     * @throws std::runtime_error if the file cannot be written.
+     */
+
+    void writeGraphFileSections(const char* path, const char* kind, const void* file_header, std::size_t header_size,
+                                const GraphFileSection* sections, int num_sections);
+
+    /**
+     * @brief Writes a section file: the layout of graph files and of the saved indexes (ContractionHierarchy, LandmarkIndex).
+     *
+     * The file is a fixed header followed by the sections, each zero-padded to 8 bytes. Header is the header
+     * struct of the index, with magic, version, byte_order and checksum fields. The caller fills in the magic,
+     * the version and its own counts; the byte order and the checksum of the sections are filled in here.
+     *
+     * @param path The file to write.
+     * @param kind The file type named in error messages ("graph", "hierarchy", "landmark").
+     * @param file_header The header to write.
+     * @param sections The arrays to write after the header, in order.
+     * @param num_sections Number of sections.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+
+    template <typename Header>
+    void writeSectionFile(const char* path, const char* kind, Header file_header, const GraphFileSection* sections, int num_sections)
+    {
+        file_header.byte_order = GRAPH_FILE_BYTE_ORDER;
+        file_header.checksum = graphFileSectionsChecksum(sections, num_sections);
+        writeGraphFileSections(path, kind, &file_header, sizeof(file_header), sections, num_sections);
+    }
+
+    /**
+     * @brief Reads the header of a section file and checks its magic, version and byte order.
+     *
+     * The counts in the header are not checked; compute the section sizes from them (after checking they
+     * fit the index), then call checkSectionFile() before allocating anything.
+     *
+     * @param file The mapped file.
+     * @param kind The file type named in error messages ("hierarchy", "landmark").
+     * @param magic The magic the header must start with.
+     * @param version The version the header must have.
+     * @return A copy of the header.
+     * @throws std::runtime_error if the file is too small, or has another magic, version or byte order.
+     */
+
+    template <typename Header>
+    Header readSectionFileHeader(const MappedFile& file, const char* kind, const char* magic, std::uint32_t version)
+    {
+        Header file_header;
+        if (file.getSize() < sizeof(file_header))
+        {
+            throw std::runtime_error(std::string("Not a ") + kind + " file: too small.");
+        }
+        std::memcpy(&file_header, file.getData(), sizeof(file_header));
+        if (std::memcmp(file_header.magic, magic, sizeof(file_header.magic)) != 0)
+        {
+            throw std::runtime_error(std::string("Not a ") + kind + " file: bad magic.");
+        }
+        if (file_header.version != version)
+        {
+            throw std::runtime_error(std::string("Unsupported ") + kind + " file version " + std::to_string(file_header.version) + ".");
+        }
+        if (file_header.byte_order != GRAPH_FILE_BYTE_ORDER)
+        {
+            throw std::runtime_error(std::string("The ") + kind + " file was written on a machine of different endianness.");
+        }
+        return file_header;
+    }
+
+    /**
+     * @brief Checks that a section file holds exactly the given sections after its header, and that they
+     *        pass the checksum stored in the header.
+     * @param file The mapped file.
+     * @param kind The file type named in error messages ("hierarchy", "landmark").
+     * @param header_size Size of the header in bytes.
+     * @param checksum The checksum from the header.
+     * @param section_bytes Size of every section in bytes (before padding), as the header describes them.
+     * @param num_sections Number of sections.
+     * @throws std::runtime_error if the file has another size or fails its checksum.
+     */
+
+    void checkSectionFile(const MappedFile& file, const char* kind, std::size_t header_size, std::uint64_t checksum,
+                          const std::uint64_t* section_bytes, int num_sections);
+
+    /**
+     * @brief Copies the sections of a file checked by checkSectionFile() into arrays that outlive the mapping.
+     * @param file The mapped file.
+     * @param header_size Size of the header in bytes.
+     * @param section_bytes Size of every section in bytes (before padding).
+     * @param destinations One array of section_bytes[s] bytes for every section.
+     * @param num_sections Number of sections.
+     */
+
+    void copySectionFile(const MappedFile& file, std::size_t header_size, const std::uint64_t* section_bytes,
+                         void* const* destinations, int num_sections);
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+void graph::BasicMappedGraph<VertexId, Weight, EdgeId>::save(const CSR& g, const char* path) // Header, then the three arrays as they are in memory
+{
+    std::uint64_t n = static_cast<std::uint64_t>(g.getNumOfVertices());
+    std::uint64_t m = static_cast<std::uint64_t>(g.getNumOfEdges());
+    std::uint64_t offsets_bytes = (n + 1) * sizeof(EdgeId);
+    std::uint64_t targets_bytes = m * sizeof(VertexId);
+    std::uint64_t weights_bytes = CSR::HAS_WEIGHTS ? m * sizeof(Weight) : 0;
+
+    GraphFileHeader file_header;
+    std::memset(&file_header, 0, sizeof(file_header));
+    std::memcpy(file_header.magic, GRAPH_FILE_MAGIC, sizeof(file_header.magic));
+    file_header.version = GRAPH_FILE_VERSION;
+    file_header.vertex_id_size = sizeof(VertexId);
+    file_header.edge_id_size = sizeof(EdgeId);
+    file_header.weight_size = CSR::HAS_WEIGHTS ? sizeof(Weight) : 0;
+    file_header.weight_kind = graphFileWeightKind<Weight>();
+    file_header.num_vertices = n;
+    file_header.num_edges = m;
+    file_header.offsets_position = sizeof(GraphFileHeader);
+    file_header.targets_position = file_header.offsets_position + graphFilePadded(offsets_bytes);
+    file_header.weights_position = CSR::HAS_WEIGHTS ? file_header.targets_position + graphFilePadded(targets_bytes) : 0;
+
+    const GraphFileSection sections[3] = {
+        {g.getOffsets(), offsets_bytes},
+        {g.getDestVertices(), targets_bytes},
+        {g.getWeights(), weights_bytes} // Left out of an unweighted file
+    };
+    writeSectionFile(path, "graph", file_header, sections, CSR::HAS_WEIGHTS ? 3 : 2);
+}
+
+template <typename VertexId, typename Weight, typename EdgeId>
+const graph::GraphFileHeader& graph::BasicMappedGraph<VertexId, Weight, EdgeId>::checkHeader(const MappedFile& file, bool verify_checksum) // Validates the header before any section is touched
+{
+    if (file.getSize() < sizeof(GraphFileHeader))
+    {
+        throw std::runtime_error("Not a graph file: too small.");
+    }
+    const GraphFileHeader& file_header = *reinterpret_cast<const GraphFileHeader*>(file.getData());
+
+    if (std::memcmp(file_header.magic, GRAPH_FILE_MAGIC, sizeof(file_header.magic)) != 0)
+    {
+        throw std::runtime_error("Not a graph file: bad magic.");
+    }
+    if (file_header.version != GRAPH_FILE_VERSION)
+    {
+        throw std::runtime_error("Unsupported graph file version " + std::to_string(file_header.version) + ".");
+    }
+    if (file_header.byte_order != GRAPH_FILE_BYTE_ORDER)
+    {
+        throw std::runtime_error("The graph file was written on a machine of different endianness.");
+    }
+    if (file_header.vertex_id_size != sizeof(VertexId) || file_header.edge_id_size != sizeof(EdgeId) ||
+        file_header.weight_size != (CSR::HAS_WEIGHTS ? sizeof(Weight) : 0) || file_header.weight_kind != graphFileWeightKind<Weight>())
+    {
+        throw std::runtime_error("The graph file was written with different vertex, edge or weight types.");
+    }
+
+    // The counts must fit the element types, and the sections must lie inside the file where the layout puts them
+    std::uint64_t n = file_header.num_vertices;
+    std::uint64_t m = file_header.num_edges;
+    if (n > static_cast<std::uint64_t>(std::numeric_limits<VertexId>::max()) ||
+        m > static_cast<std::uint64_t>(std::numeric_limits<EdgeId>::max()))
+    {
+        throw std::runtime_error("The graph file is too large for its vertex or edge types.");
+    }
+    // Bounded by the file size first, so a corrupt count cannot wrap the section sizes below around 2^64
+    std::uint64_t size = file.getSize();
+    if (n >= size / sizeof(EdgeId) || m > size / sizeof(VertexId) || (CSR::HAS_WEIGHTS && m > size / (CSR::HAS_WEIGHTS ? sizeof(Weight) : 1)))
+    {
+        throw std::runtime_error("The graph file is truncated or its sections are corrupted.");
+    }
+    std::uint64_t end = sizeof(GraphFileHeader);
+    bool layout_ok = file_header.offsets_position == end;
+    end += graphFilePadded((n + 1) * sizeof(EdgeId));
+    layout_ok = layout_ok && file_header.targets_position == end;
+    end += graphFilePadded(m * sizeof(VertexId));
+    if (CSR::HAS_WEIGHTS)
+    {
+        layout_ok = layout_ok && file_header.weights_position == end;
+        end += graphFilePadded(m * sizeof(Weight));
+    }
+    if (!layout_ok || end != file.getSize())
+    {
+        throw std::runtime_error("The graph file is truncated or its sections are corrupted.");
+    }
+
+    const EdgeId* offsets = reinterpret_cast<const EdgeId*>(file.getData() + file_header.offsets_position);
+    if (offsets[0] != 0 || static_cast<std::uint64_t>(offsets[n]) != m)
+    {
+        throw std::runtime_error("The graph file is truncated or its sections are corrupted.");
+    }
+
+    if (verify_checksum)
+    {
+        GraphFileChecksum checksum;
+        checksum.update(file.getData() + sizeof(GraphFileHeader), file.getSize() - sizeof(GraphFileHeader));
+        if (checksum.getValue() != file_header.checksum)
+        {
+            throw std::runtime_error("The graph file failed its checksum.");
+        }
+    }
+
+    return file_header;
+}
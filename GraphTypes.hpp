@@ -0,0 +1,64 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include <type_traits>
+#include <limits>
+
+namespace graph {
+
+    /**
+     * @brief Weight type of an unweighted graph.
+     *
+     * A graph templated on NoWeight stores no weight array at all, and every edge counts as length 1.
+     */
+
+    struct NoWeight {};
+
+    /**
+     * @brief Properties of an edge weight type, used by the templated graphs and algorithms.
+     *
+     * Distance is the type path lengths are summed in: 64-bit integers for integral weights, so long paths
+     * of large weights do not overflow, and double for floating point weights.
+     */
+
+    template <typename Weight>
+    struct WeightTraits {
+        static_assert(std::is_arithmetic<Weight>::value, "Weight must be an arithmetic type or NoWeight");
+
+        static constexpr bool HAS_WEIGHTS = true; // The graph stores a weight per edge
+        using Distance = typename std::conditional<std::is_floating_point<Weight>::value, double, long long>::type;
+
+        static Distance length(Weight weight) // The length an edge of this weight adds to a path
+        {
+            return static_cast<Distance>(weight);
+        }
+    };
+
+    template <>
+    struct WeightTraits<NoWeight> {
+        static constexpr bool HAS_WEIGHTS = false;
+        using Distance = long long; // Number of edges on the path
+
+        static Distance length(NoWeight)
+        {
+            return 1;
+        }
+    };
+
+    /**
+     * @brief Checks whether vertex is a valid index in a graph of num_vertices vertices.
+     *
+     * Works for signed and unsigned vertex id types (an unsigned id is never negative).
+     */
+
+    template <typename VertexId>
+    bool isValidVertex(VertexId vertex, VertexId num_vertices)
+    {
+        if constexpr (std::is_signed<VertexId>::value)
+        {
+            if (vertex < 0) return false;
+        }
+        return vertex < num_vertices;
+    }
+}
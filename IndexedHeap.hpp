@@ -0,0 +1,254 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include <stdexcept>
+
+/**
+ * @brief An indexed d-ary min-heap over the items 0 .. num_items - 1, with decrease-key.
+ *
+ * Every item is in the heap at most once. A position array maps each item to its slot,
+ * so decreaseKey() and contains() are O(1) to locate and O(log_d n) to restore the heap.
+ * Items are ordered by key, and by item index for equal keys.
+ *
+ * @tparam Arity Number of children per node (2 is a binary heap). Wider heaps are shallower,
+ * which makes decrease-key cheaper and pop more expensive.
+ */
+
+template <int Arity>
+class IndexedHeap {
+
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+    private:
+
+    int* heap; // heap[slot] is the item stored at that slot, heap[0] is the minimum
+    int* position; // position[item] is the slot of item, or -1 if it is not in the heap
+    int* keys; // keys[item] is the current key of item
+    int capacity; // Number of items (valid items are 0 .. capacity - 1)
+    int count; // Current number of items in the heap
+
+    bool less(int a, int b) const // Returns true if item a must come before item b
+    {
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    }
+
+    void place(int item, int slot) // Stores item at slot and records its position
+    {
+        heap[slot] = item;
+        position[item] = slot;
+    }
+
+    void siftUp(int slot) // Moves the item at slot up until its parent is smaller
+    {
+        int item = heap[slot];
+        while (slot > 0 && less(item, heap[(slot - 1) / Arity]))
+        {
+            place(heap[(slot - 1) / Arity], slot);
+            slot = (slot - 1) / Arity;
+        }
+        place(item, slot);
+    }
+
+    void siftDown(int slot) // Moves the item at slot down until all its children are larger
+    {
+        int item = heap[slot];
+        while (true)
+        {
+            int first_child = slot * Arity + 1;
+            if (first_child >= count) break;
+
+            int best = first_child; // The smallest of up to Arity children
+            int last_child = (first_child + Arity < count) ? first_child + Arity : count;
+            for (int child = first_child + 1; child < last_child; child++)
+            {
+                if (less(heap[child], heap[best]))
+                {
+                    best = child;
+                }
+            }
+
+            if (!less(heap[best], item)) break;
+            place(heap[best], slot);
+            slot = best;
+        }
+        place(item, slot);
+    }
+
+    void checkItem(int item) const
+    {
+        if (item < 0 || item >= capacity)
+        {
+            throw std::out_of_range("Invalid heap item.");
+        }
+    }
+
+    public:
+
+    /**
+     * @brief Constructs an empty heap for the items 0 .. num_items - 1.
+     * @param num_items Number of distinct items the heap can hold.
+     */
+
+    IndexedHeap(int num_items) : capacity(num_items), count(0)
+    {
+        heap = new int[capacity];
+        position = new int[capacity];
+        keys = new int[capacity];
+        for (int i = 0; i < capacity; i++)
+        {
+            position[i] = -1;
+        }
+    }
+
+    /**
+     * @brief Destructor. Frees the heap, position and key arrays.
+     */
+
+    ~IndexedHeap()
+    {
+        delete[] heap;
+        delete[] position;
+        delete[] keys;
+    }
+
+    IndexedHeap(const IndexedHeap&) = delete; // The arrays are owned, copying would double-free them
+    IndexedHeap& operator=(const IndexedHeap&) = delete;
+
+    /**
+     * @brief Inserts an item that is not in the heap.
+     * @param item The item to insert.
+     * @param key Its key.
+     * @throws std::out_of_range if the item index is invalid.
+     * @throws std::logic_error if the item is already in the heap.
+     */
+
+    void push(int item, int key)
+    {
+        checkItem(item);
+        if (position[item] != -1)
+        {
+            throw std::logic_error("The item is already in the heap.");
+        }
+        keys[item] = key;
+        place(item, count);
+        count = count + 1;
+        siftUp(count - 1);
+    }
+
+    /**
+     * @brief Lowers the key of an item in the heap.
+     * @param item The item to update.
+     * @param key The new key, which must not be larger than the current one.
+     * @throws std::out_of_range if the item index is invalid.
+     * @throws std::logic_error if the item is not in the heap or the key would increase.
+     */
+
+    void decreaseKey(int item, int key)
+    {
+        checkItem(item);
+        if (position[item] == -1 || key > keys[item])
+        {
+            throw std::logic_error("decreaseKey() needs an item in the heap and a key that does not increase.");
+        }
+        keys[item] = key;
+        siftUp(position[item]);
+    }
+
+    /**
+     * @brief Inserts the item, or lowers its key if it is already in the heap with a larger key.
+     * @param item The item to insert or update.
+     * @param key The key.
+     * @return true if the heap changed, false if the item was already in it with a key at most key.
+     * @throws std::out_of_range if the item index is invalid.
+     */
+
+    bool pushOrDecrease(int item, int key)
+    {
+        checkItem(item);
+        if (position[item] == -1)
+        {
+            push(item, key);
+            return true;
+        }
+        if (key < keys[item])
+        {
+            decreaseKey(item, key);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Removes and returns the item with the smallest key.
+     * @return The removed item.
+     * @throws std::underflow_error if the heap is empty.
+     */
+
+    int pop()
+    {
+        if (isEmpty())
+        {
+            throw std::underflow_error("The heap is empty.");
+        }
+
+        int item = heap[0];
+        position[item] = -1;
+        count = count - 1;
+        if (count > 0)
+        {
+            place(heap[count], 0);
+            siftDown(0);
+        }
+        return item;
+    }
+
+    /**
+     * @brief Returns the smallest key without removing its item.
+     * @return The smallest key in the heap.
+     * @throws std::underflow_error if the heap is empty.
+     */
+
+    int peekKey() const
+    {
+        if (isEmpty())
+        {
+            throw std::underflow_error("The heap is empty.");
+        }
+        return keys[heap[0]];
+    }
+
+    /**
+     * @brief Checks whether an item is currently in the heap.
+     * @param item The item to check.
+     * @return true if the item is in the heap, false otherwise.
+     * @throws std::out_of_range if the item index is invalid.
+     */
+
+    bool contains(int item) const
+    {
+        checkItem(item);
+        return position[item] != -1;
+    }
+
+    /**
+     * @brief Checks if the heap is empty.
+     * @return true if the heap is empty, false otherwise.
+     */
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Returns the number of items in the heap.
+     * @return Number of items.
+     */
+
+    int size() const
+    {
+        return count;
+    }
+
+};
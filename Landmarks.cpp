@@ -0,0 +1,320 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "Landmarks.hpp"
+#include "Algorithms.hpp"
+#include "GraphFile.hpp"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+const char graph::LANDMARK_FILE_MAGIC[8] = {'N', 'P', 'A', 'L', 'T', 'I', 'X', '\0'};
+
+namespace {
+
+    // A vertex that is not a landmark yet, preferring the lowest id (used when a strategy has no better choice)
+    int firstFreeVertex(const bool* is_landmark, int num_vertices)
+    {
+        for (int v = 0; v < num_vertices; v++)
+        {
+            if (!is_landmark[v]) return v;
+        }
+        return -1;
+    }
+
+    // Farthest: the vertex farthest from its closest landmark; a vertex no landmark reaches comes first
+    int farthestVertex(const long long* closest, const bool* is_landmark, int num_vertices)
+    {
+        int best = -1;
+        for (int v = 0; v < num_vertices; v++)
+        {
+            if (is_landmark[v]) continue;
+            if (best == -1 || closest[v] > closest[best]) best = v; // Unreached vertices have Path::NO_PATH, the largest value
+        }
+        return best;
+    }
+}
+
+graph::LandmarkIndex::LandmarkIndex() : num_of_vertices(0), num_of_landmarks(0), landmarks(nullptr), from_landmark(nullptr), to_landmark(nullptr) {}
+
+graph::LandmarkIndex::LandmarkIndex(const Graph& g, int num_landmarks, LandmarkStrategy strategy) : LandmarkIndex()
+{
+    int num_vertices = g.getNumOfVertices();
+    if (num_landmarks < 1 || num_landmarks > num_vertices)
+    {
+        throw std::invalid_argument("The number of landmarks must be between 1 and the number of vertices.");
+    }
+    for (int v = 0; v < num_vertices; v++) // A negative weight would break the triangle inequality bounds
+    {
+        for (Edge* e = g.getAdjList()[v]; e != nullptr; e = e->next)
+        {
+            if (e->weight < 0)
+            {
+                throw std::invalid_argument("Landmark bounds do not support negative edge weights.");
+            }
+        }
+    }
+
+    Graph reverse = g.reversed(); // Distances to a landmark are distances from it in the reverse graph
+    long long table_size = static_cast<long long>(num_vertices) * num_landmarks;
+
+    // The destructor frees these if a search below throws, since the empty constructor has already run
+    num_of_vertices = num_vertices;
+    num_of_landmarks = num_landmarks; // The row length of the tables; round l only reads the first l columns
+    landmarks = new int[num_landmarks];
+    from_landmark = new long long[table_size];
+    to_landmark = new long long[table_size];
+
+    // Allocated inside the try, so the catch frees whichever of them exist when one runs out of memory
+    bool* is_landmark = nullptr;
+    long long* closest = nullptr; // Farthest: the distance from the nearest landmark so far
+    long long* slack = nullptr; // Avoid: how far the current bound from the root falls short, per vertex
+    int* best_child = nullptr; // Avoid: the child with the largest uncovered subtree
+    bool* covered = nullptr; // Avoid: whether a subtree already contains a landmark
+    unsigned int seed = 12345; // Avoid: picks the tree roots, fixed so the same graph always gets the same landmarks
+
+    try
+    {
+        is_landmark = new bool[num_vertices]{false};
+        closest = new long long[num_vertices];
+        slack = new long long[num_vertices];
+        best_child = new int[num_vertices];
+        covered = new bool[num_vertices];
+
+        // Farthest starts from the vertex farthest from vertex 0; Avoid falls back to the same rule when every subtree is covered
+        TraversalTree start_tree = Algorithms::dijkstraTree(g, 0);
+        for (int v = 0; v < num_vertices; v++)
+        {
+            closest[v] = start_tree.getDistances()[v];
+        }
+
+        for (int l = 0; l < num_landmarks; l++)
+        {
+            int landmark = -1;
+            if (strategy == LandmarkStrategy::Farthest)
+            {
+                landmark = farthestVertex(closest, is_landmark, num_vertices);
+            }
+            else
+            {
+                seed = seed * 1103515245 + 12345;
+                int root = static_cast<int>((seed >> 8) % static_cast<unsigned int>(num_vertices));
+                TraversalTree tree = Algorithms::dijkstraTree(g, root);
+                const int* parent = tree.getParents();
+                const int* order = tree.getOrder();
+                int reached = tree.getReachedCount();
+
+                // The subtree weight of v sums how much the landmarks underestimate d(root, u) over its vertices u.
+                // Children come after their parent in Dijkstra order, so walking it backwards finishes every subtree first.
+                for (int i = 0; i < reached; i++)
+                {
+                    int v = order[i];
+                    slack[v] = tree.getDistances()[v] - bound(l, root, v);
+                    best_child[v] = -1;
+                    covered[v] = is_landmark[v];
+                }
+                for (int i = reached - 1; i >= 0; i--)
+                {
+                    int v = order[i];
+                    if (covered[v]) slack[v] = 0; // A subtree with a landmark is already well covered
+                    int p = parent[v];
+                    if (p == -1) continue;
+                    if (covered[v])
+                    {
+                        covered[p] = true;
+                        continue;
+                    }
+                    slack[p] += slack[v];
+                    if (best_child[p] == -1 || slack[v] > slack[best_child[p]]) best_child[p] = v;
+                }
+
+                int heaviest = -1; // Descend from the heaviest uncovered vertex to a leaf, far from every landmark
+                for (int i = 0; i < reached; i++)
+                {
+                    int v = order[i];
+                    if (!covered[v] && (heaviest == -1 || slack[v] > slack[heaviest])) heaviest = v;
+                }
+                if (heaviest != -1)
+                {
+                    landmark = heaviest;
+                    while (best_child[landmark] != -1 && !covered[best_child[landmark]])
+                    {
+                        landmark = best_child[landmark];
+                    }
+                }
+                if (landmark == -1 || is_landmark[landmark])
+                {
+                    landmark = farthestVertex(closest, is_landmark, num_vertices);
+                }
+            }
+            if (landmark == -1) landmark = firstFreeVertex(is_landmark, num_vertices);
+
+            landmarks[l] = landmark;
+            is_landmark[landmark] = true;
+            TraversalTree forward = Algorithms::dijkstraTree(g, landmark);
+            TraversalTree backward = Algorithms::dijkstraTree(reverse, landmark);
+            const long long* from_distances = forward.getDistances();
+            const long long* to_distances = backward.getDistances();
+            for (int v = 0; v < num_vertices; v++)
+            {
+                from_landmark[static_cast<long long>(v) * num_landmarks + l] = from_distances[v];
+                to_landmark[static_cast<long long>(v) * num_landmarks + l] = to_distances[v];
+                if (l == 0 || from_distances[v] < closest[v]) closest[v] = from_distances[v];
+            }
+        }
+    }
+    catch (...)
+    {
+        delete[] is_landmark;
+        delete[] closest;
+        delete[] slack;
+        delete[] best_child;
+        delete[] covered;
+        throw;
+    }
+
+    delete[] is_landmark;
+    delete[] closest;
+    delete[] slack;
+    delete[] best_child;
+    delete[] covered;
+}
+
+graph::LandmarkIndex::~LandmarkIndex() // Destructor: frees the landmarks and tables
+{
+    delete[] landmarks;
+    delete[] from_landmark;
+    delete[] to_landmark;
+}
+
+graph::LandmarkIndex::LandmarkIndex(LandmarkIndex&& other) noexcept
+    : num_of_vertices(other.num_of_vertices), num_of_landmarks(other.num_of_landmarks), landmarks(other.landmarks),
+      from_landmark(other.from_landmark), to_landmark(other.to_landmark)
+{
+    // Leave other as an empty index so its destructor frees nothing
+    other.num_of_vertices = 0;
+    other.num_of_landmarks = 0;
+    other.landmarks = nullptr;
+    other.from_landmark = nullptr;
+    other.to_landmark = nullptr;
+}
+
+long long graph::LandmarkIndex::bound(int count, int from, int to) const
+{
+    const long long* from_row = from_landmark + static_cast<long long>(from) * num_of_landmarks;
+    const long long* to_row = from_landmark + static_cast<long long>(to) * num_of_landmarks;
+    const long long* from_back = to_landmark + static_cast<long long>(from) * num_of_landmarks;
+    const long long* to_back = to_landmark + static_cast<long long>(to) * num_of_landmarks;
+    long long best = 0;
+    for (int l = 0; l < count; l++)
+    {
+        if (from_row[l] != Path::NO_PATH && to_row[l] != Path::NO_PATH && to_row[l] - from_row[l] > best)
+        {
+            best = to_row[l] - from_row[l]; // d(L, to) <= d(L, from) + d(from, to)
+        }
+        if (from_back[l] != Path::NO_PATH && to_back[l] != Path::NO_PATH && from_back[l] - to_back[l] > best)
+        {
+            best = from_back[l] - to_back[l]; // d(from, L) <= d(from, to) + d(to, L)
+        }
+    }
+    return best;
+}
+
+void graph::LandmarkIndex::save(const char* path) const // Header, then the landmarks and both tables as they are in memory
+{
+    std::uint64_t table_bytes = static_cast<std::uint64_t>(num_of_vertices) * num_of_landmarks * sizeof(long long);
+    const GraphFileSection sections[3] = {
+        {landmarks, static_cast<std::uint64_t>(num_of_landmarks) * sizeof(int)},
+        {from_landmark, table_bytes},
+        {to_landmark, table_bytes}
+    };
+
+    LandmarkFileHeader file_header = {};
+    std::memcpy(file_header.magic, LANDMARK_FILE_MAGIC, sizeof(file_header.magic));
+    file_header.version = LANDMARK_FILE_VERSION;
+    file_header.num_vertices = static_cast<std::uint64_t>(num_of_vertices);
+    file_header.num_landmarks = static_cast<std::uint64_t>(num_of_landmarks);
+    writeSectionFile(path, "landmark", file_header, sections, 3);
+}
+
+graph::LandmarkIndex graph::LandmarkIndex::load(const char* path)
+{
+    MappedFile file(path);
+    LandmarkFileHeader file_header = readSectionFileHeader<LandmarkFileHeader>(file, "landmark", LANDMARK_FILE_MAGIC, LANDMARK_FILE_VERSION);
+    if (file_header.num_vertices > INT_MAX || file_header.num_landmarks > file_header.num_vertices)
+    {
+        throw std::runtime_error("The landmark file has an invalid number of vertices or landmarks.");
+    }
+
+    int vertices = static_cast<int>(file_header.num_vertices);
+    int count = static_cast<int>(file_header.num_landmarks);
+    std::uint64_t table_bytes = static_cast<std::uint64_t>(vertices) * count * sizeof(long long);
+    std::uint64_t section_bytes[3] = {static_cast<std::uint64_t>(count) * sizeof(int), table_bytes, table_bytes};
+    checkSectionFile(file, "landmark", sizeof(file_header), file_header.checksum, section_bytes, 3);
+
+    LandmarkIndex index;
+    index.num_of_vertices = vertices;
+    index.num_of_landmarks = count;
+    index.landmarks = new int[count];
+    index.from_landmark = new long long[static_cast<long long>(vertices) * count];
+    index.to_landmark = new long long[static_cast<long long>(vertices) * count];
+    void* destinations[3] = {index.landmarks, index.from_landmark, index.to_landmark};
+    copySectionFile(file, sizeof(file_header), section_bytes, destinations, 3);
+
+    for (int l = 0; l < count; l++)
+    {
+        if (index.landmarks[l] < 0 || index.landmarks[l] >= vertices)
+        {
+            throw std::runtime_error("The landmark file has landmarks outside its vertex range.");
+        }
+    }
+    return index;
+}
+
+long long graph::LandmarkIndex::lowerBound(int from, int to) const
+{
+    if (from < 0 || from >= num_of_vertices || to < 0 || to >= num_of_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex index.");
+    }
+    return bound(num_of_landmarks, from, to);
+}
+
+graph::Path graph::LandmarkIndex::shortestPath(const Graph& g, int source, int target) const
+{
+    if (g.getNumOfVertices() != num_of_vertices)
+    {
+        throw std::invalid_argument("The graph does not have the vertices of the landmark index.");
+    }
+    if (target < 0 || target >= num_of_vertices) // Checked before the heuristic reads the target's row
+    {
+        throw std::out_of_range("Invalid vertex. ");
+    }
+    return Algorithms::aStar(g, source, target, LandmarkHeuristic(*this, target));
+}
+
+int graph::LandmarkIndex::getNumOfVertices() const
+{
+    return this->num_of_vertices;
+}
+
+int graph::LandmarkIndex::getNumOfLandmarks() const
+{
+    return this->num_of_landmarks;
+}
+
+const int* graph::LandmarkIndex::getLandmarks() const
+{
+    return this->landmarks;
+}
+
+graph::LandmarkHeuristic::LandmarkHeuristic(const LandmarkIndex& index, int target)
+    : from_landmark(index.from_landmark), to_landmark(index.to_landmark), num_of_landmarks(index.num_of_landmarks)
+{
+    if (target < 0 || target >= index.num_of_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex index.");
+    }
+    target_from = from_landmark + static_cast<long long>(target) * num_of_landmarks;
+    target_to = to_landmark + static_cast<long long>(target) * num_of_landmarks;
+}
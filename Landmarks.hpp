@@ -0,0 +1,219 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "Path.hpp"
+#include <cstdint>
+
+namespace graph {
+
+    constexpr std::uint32_t LANDMARK_FILE_VERSION = 1; // Bumped on any incompatible change of the layout
+
+    /**
+     * @brief The fixed-size header at the start of a saved landmark index.
+     *
+     * The header is followed by three sections, each zero-padded to a multiple of 8 bytes: the landmark
+     * vertices, the distances from every landmark and the distances to every landmark, both tables stored
+     * vertex by vertex as in memory. The checksum (a GraphFileChecksum) covers every section.
+     */
+
+    struct LandmarkFileHeader {
+        char magic[8]; // LANDMARK_FILE_MAGIC
+        std::uint32_t version; // LANDMARK_FILE_VERSION of the writer
+        std::uint32_t byte_order; // GRAPH_FILE_BYTE_ORDER as written by the writer
+        std::uint64_t num_vertices; // Number of vertices
+        std::uint64_t num_landmarks; // Number of landmarks
+        std::uint64_t checksum; // GraphFileChecksum of the sections
+    };
+
+    static_assert(sizeof(LandmarkFileHeader) == 40, "The landmark file header must have the same layout everywhere");
+
+    extern const char LANDMARK_FILE_MAGIC[8]; // "NPALTIX" followed by a 0 byte
+
+    /**
+     * @brief How the landmarks of a LandmarkIndex are chosen.
+     */
+
+    enum class LandmarkStrategy
+    {
+        Farthest, // Each new landmark is the vertex farthest from the landmarks chosen so far
+        Avoid // Each new landmark sits in the part of a shortest path tree the current landmarks bound worst
+    };
+
+    /**
+     * @brief An ALT (A*, Landmarks, Triangle inequality) distance oracle: exact distances from and to a few
+     *        landmark vertices, which give a lower bound on the distance between any two vertices.
+     *
+     * For a landmark L, d(L, t) - d(L, v) and d(v, L) - d(t, L) are both at most d(v, t) by the triangle
+     * inequality. The largest of these over all landmarks guides A* (see LandmarkHeuristic) far better than
+     * a bound from coordinates, and needs no geometry. The tables are two contiguous arrays with the
+     * distances of one vertex next to each other, so a bound reads one short run of memory per vertex.
+     *
+     * Preprocessing is one forward and one backward Dijkstra per landmark, much lighter than a contraction
+     * hierarchy. The bounds stay valid when edge weights only go up, so a graph whose weights keep
+     * increasing (congestion) can be queried with the old tables; lower weights need a rebuild.
+     */
+
+    class LandmarkIndex
+    {
+
+        private:
+        int num_of_vertices; // Number of vertices
+        int num_of_landmarks; // Number of landmarks
+        int* landmarks; // The landmark vertices
+        long long* from_landmark; // from_landmark[v * num_of_landmarks + l] is d(landmarks[l], v), Path::NO_PATH if unreachable
+        long long* to_landmark; // to_landmark[v * num_of_landmarks + l] is d(v, landmarks[l]), Path::NO_PATH if unreachable
+
+        LandmarkIndex(); // An empty index, filled in by load()
+
+        // The lower bound on d(from, to) from the first count landmarks
+        long long bound(int count, int from, int to) const;
+
+        friend class LandmarkHeuristic; // Reads the tables directly
+
+        public:
+
+        /**
+         * @brief Chooses landmarks and computes the distances from and to each of them with dijkstraTree().
+         * @param g The graph (non-negative weights).
+         * @param num_landmarks The number of landmarks, between 1 and the number of vertices (16 is typical).
+         * @param strategy How to choose the landmarks (default is Avoid).
+         * @throws std::invalid_argument if num_landmarks is out of range or the graph has a negative weight.
+         */
+
+        LandmarkIndex(const Graph& g, int num_landmarks, LandmarkStrategy strategy = LandmarkStrategy::Avoid);
+
+        /**
+         * @brief Destructor. Frees the landmarks and the distance tables.
+         */
+
+        ~LandmarkIndex();
+
+        /**
+         * @brief Move constructor. Takes over the arrays of other in O(1), other is left empty.
+         */
+
+        LandmarkIndex(LandmarkIndex&& other) noexcept;
+
+        LandmarkIndex(const LandmarkIndex&) = delete; // The arrays are owned, copying would double-free them
+        LandmarkIndex& operator=(const LandmarkIndex&) = delete;
+
+        /**
+         * @brief Writes the landmarks and tables to a binary file.
+         * @param path The file to write.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+
+        void save(const char* path) const;
+
+        /**
+         * @brief Reads an index written by save().
+         * @param path The file to read.
+         * @return The index.
+         * @throws std::runtime_error if the file cannot be read, is not a landmark file of this version,
+         *         fails its checksum or has landmarks outside the vertex range.
+         */
+
+        static LandmarkIndex load(const char* path);
+
+        /**
+         * @brief Returns a lower bound on the distance between two vertices.
+         * @param from The first vertex.
+         * @param to The last vertex.
+         * @return A value at most d(from, to) (0 when no landmark gives a bound).
+         * @throws std::out_of_range if a vertex index is invalid.
+         */
+
+        long long lowerBound(int from, int to) const;
+
+        /**
+         * @brief Finds a shortest path with A* guided by the landmark bounds.
+         * @param g The graph the index was built for, or the same graph with some weights increased.
+         * @param source The first vertex of the path.
+         * @param target The last vertex of the path.
+         * @return The path and its cost, or an empty path if target is not reachable from source.
+         * @throws std::out_of_range if source or target is invalid.
+         * @throws std::invalid_argument if g does not have the number of vertices of the index.
+         */
+
+        Path shortestPath(const Graph& g, int source, int target) const;
+
+        /**
+         * @brief Returns the number of vertices.
+         * @return Number of vertices.
+         */
+
+        int getNumOfVertices() const;
+
+        /**
+         * @brief Returns the number of landmarks.
+         * @return Number of landmarks.
+         */
+
+        int getNumOfLandmarks() const;
+
+        /**
+         * @brief Returns the landmark vertices, in the order they were chosen (getNumOfLandmarks() entries).
+         * @return A pointer to the landmark array.
+         */
+
+        const int* getLandmarks() const;
+
+    };
+
+    /**
+     * @brief A* heuristic from a LandmarkIndex: the best triangle inequality bound towards one target.
+     *
+     * The bound of each landmark is consistent, so their maximum is too, as aStar() requires.
+     * The target's distances are looked up once, so a call only reads the row of the vertex.
+     */
+
+    class LandmarkHeuristic
+    {
+
+        private:
+        const long long* from_landmark; // The distance tables of the index
+        const long long* to_landmark;
+        const long long* target_from; // d(L, target) for every landmark L
+        const long long* target_to; // d(target, L) for every landmark L
+        int num_of_landmarks;
+
+        public:
+
+        /**
+         * @brief Constructs the heuristic towards one target.
+         * @param index The landmark index, must outlive the heuristic.
+         * @param target The target vertex of the search.
+         * @throws std::out_of_range if the target is invalid.
+         */
+
+        LandmarkHeuristic(const LandmarkIndex& index, int target);
+
+        /**
+         * @brief Estimates the cost from a vertex to the target.
+         * @param vertex The vertex index (not checked).
+         * @return A lower bound on the cost of any path from vertex to the target.
+         */
+
+        long long operator()(int vertex) const
+        {
+            const long long* from_vertex = from_landmark + static_cast<long long>(vertex) * num_of_landmarks;
+            const long long* to_vertex = to_landmark + static_cast<long long>(vertex) * num_of_landmarks;
+            long long best = 0;
+            for (int l = 0; l < num_of_landmarks; l++)
+            {
+                if (from_vertex[l] != Path::NO_PATH && target_from[l] != Path::NO_PATH && target_from[l] - from_vertex[l] > best)
+                {
+                    best = target_from[l] - from_vertex[l];
+                }
+                if (to_vertex[l] != Path::NO_PATH && target_to[l] != Path::NO_PATH && to_vertex[l] - target_to[l] > best)
+                {
+                    best = to_vertex[l] - target_to[l];
+                }
+            }
+            return best;
+        }
+
+    };
+}
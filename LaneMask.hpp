@@ -0,0 +1,149 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief A fixed set of Lanes bits (64, 256 or 512), one per concurrent search of a bit-parallel traversal.
+ *
+ * The operations work on all the words at once. Builds with AVX2 (-mavx2) or AVX-512 (-mavx512f) do a
+ * 256 or 512 bit mask in one instruction; other builds use the word loop, which the compiler unrolls.
+ * The results are the same either way, the tests check them against a word loop of their own:
+ *     make clean && make test CXXFLAGS="-std=c++17 -Wall -Wextra -pedantic -g -pthread -mavx2 -mavx512f"
+ * (on a CPU with AVX-512; drop -mavx512f to test the AVX2 path alone).
+ *
+ * @tparam Lanes Number of bits, 64, 256 or 512.
+ */
+
+template <int Lanes>
+struct LaneMask {
+
+    static_assert(Lanes == 64 || Lanes == 256 || Lanes == 512, "A lane mask has 64, 256 or 512 lanes");
+
+    static constexpr int WORDS = Lanes / 64; // Number of 64-bit words
+
+    unsigned long long words[WORDS]; // Lane i is bit (i % 64) of words[i / 64]
+
+    /**
+     * @brief Clears every lane.
+     */
+
+    void clear()
+    {
+        for (int i = 0; i < WORDS; i++)
+        {
+            words[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Sets one lane.
+     * @param lane The lane index (not checked).
+     */
+
+    void set(int lane)
+    {
+        words[lane >> 6] |= 1ULL << (lane & 63);
+    }
+
+    /**
+     * @brief Checks whether any lane is set.
+     * @return True if at least one lane is set.
+     */
+
+    bool any() const
+    {
+        unsigned long long combined = 0;
+        for (int i = 0; i < WORDS; i++)
+        {
+            combined |= words[i];
+        }
+        return combined != 0;
+    }
+
+    /**
+     * @brief Sets every lane that is set in other (this |= other).
+     * @param other The lanes to add.
+     */
+
+    void orWith(const LaneMask& other)
+    {
+#if defined(__AVX512F__)
+        if constexpr (Lanes == 512)
+        {
+            _mm512_storeu_si512(words, _mm512_or_si512(_mm512_loadu_si512(words), _mm512_loadu_si512(other.words)));
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (Lanes == 256)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other.words));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), _mm256_or_si256(a, b));
+            return;
+        }
+#endif
+        for (int i = 0; i < WORDS; i++)
+        {
+            words[i] |= other.words[i];
+        }
+    }
+
+    /**
+     * @brief Keeps only the lanes that are set here and not in other (this &= ~other).
+     * @param other The lanes to remove.
+     * @return True if any lane is left set.
+     */
+
+    bool andNot(const LaneMask& other)
+    {
+#if defined(__AVX512F__)
+        if constexpr (Lanes == 512)
+        {
+            // The zero-masked form: _mm512_andnot_si512 starts from an undefined register, which GCC warns about
+            __m512i result = _mm512_maskz_andnot_epi64(0xFF, _mm512_loadu_si512(other.words), _mm512_loadu_si512(words));
+            _mm512_storeu_si512(words, result);
+            return _mm512_test_epi64_mask(result, result) != 0;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (Lanes == 256)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other.words));
+            __m256i result = _mm256_andnot_si256(b, a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), result);
+            return !_mm256_testz_si256(result, result);
+        }
+#endif
+        unsigned long long combined = 0;
+        for (int i = 0; i < WORDS; i++)
+        {
+            words[i] &= ~other.words[i];
+            combined |= words[i];
+        }
+        return combined != 0;
+    }
+
+    /**
+     * @brief Calls visit(lane) for every set lane, lowest first.
+     * @param visit A callable taking the lane index.
+     */
+
+    template <typename Visit>
+    void forEachLane(Visit visit) const
+    {
+        for (int i = 0; i < WORDS; i++)
+        {
+            for (unsigned long long bits = words[i]; bits != 0; bits &= bits - 1) // Drops the lowest set bit
+            {
+                visit(i * 64 + __builtin_ctzll(bits));
+            }
+        }
+    }
+
+};
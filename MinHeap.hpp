@@ -0,0 +1,201 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief A binary min-heap of (key, vertex) entries, used as a priority queue with lazy deletion.
+ *
+ * Entries are ordered by key, and by vertex for equal keys. There is no decrease-key:
+ * a vertex whose key improves is pushed again, and callers skip the stale entries when they pop them.
+ * The array grows automatically, so the number of pushes is not bounded by the initial capacity.
+ *
+ * @tparam Key Type of the priorities (a distance type).
+ * @tparam Vertex Type of the vertex carried by each entry.
+ */
+
+template <typename Key, typename Vertex>
+class BasicMinHeap {
+
+    private:
+
+    /**
+     * @brief One heap entry.
+     */
+
+    struct Entry {
+        Key key; // The priority (smaller comes first)
+        Vertex vertex; // The vertex carried by this entry
+    };
+
+    Entry* entries; // The heap array, entries[0] is the minimum
+    std::size_t capacity; // Size of the entries array
+    std::size_t count; // Current number of entries in the heap
+
+    /**
+     * @brief Returns true if entry a must come before entry b.
+     */
+
+    static bool less(const Entry& a, const Entry& b) // Orders by key, then by vertex so ties are deterministic
+    {
+        return a.key < b.key || (a.key == b.key && a.vertex < b.vertex);
+    }
+
+    public:
+
+    /**
+     * @brief Constructs an empty heap.
+     * @param initial_capacity Number of entries to allocate up front (grows when exceeded).
+     */
+
+    BasicMinHeap(std::size_t initial_capacity) : capacity(initial_capacity > 0 ? initial_capacity : 1), count(0)
+    {
+        entries = new Entry[capacity];
+    }
+
+    /**
+     * @brief Destructor. Frees the entries array.
+     */
+
+    ~BasicMinHeap()
+    {
+        delete[] entries;
+    }
+
+    BasicMinHeap(const BasicMinHeap&) = delete; // The entries array is owned, copying would double-free it
+    BasicMinHeap& operator=(const BasicMinHeap&) = delete;
+
+    /**
+     * @brief Adds an entry to the heap.
+     * @param key The priority of the entry.
+     * @param vertex The vertex carried by the entry.
+     */
+
+    void push(Key key, Vertex vertex) // Appends the entry and sifts it up
+    {
+        if (count == capacity) // Double the array when full
+        {
+            std::size_t bigger_capacity = capacity * 2 + 1; // Never 0, even if the optimizer cannot prove capacity > 0
+            Entry* bigger = new Entry[bigger_capacity];
+            for (std::size_t i = 0; i < count; i++)
+            {
+                bigger[i] = entries[i];
+            }
+            delete[] entries;
+            entries = bigger;
+            capacity = bigger_capacity;
+        }
+
+        Entry entry{key, vertex};
+        std::size_t i = count;
+        count = count + 1;
+        while (i > 0 && less(entry, entries[(i - 1) / 2])) // Move parents down until the entry's place is found
+        {
+            entries[i] = entries[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        entries[i] = entry;
+    }
+
+    /**
+     * @brief Removes the minimum entry and returns its vertex.
+     * @return The vertex of the removed entry.
+     * @throws std::underflow_error if the heap is empty.
+     */
+
+    Vertex pop() // Removes the root, moves the last entry to the root and sifts it down
+    {
+        if (isEmpty())
+        {
+            throw std::underflow_error("The heap is empty.");
+        }
+
+        Vertex vertex = entries[0].vertex;
+        count = count - 1;
+        Entry last = entries[count];
+
+        std::size_t i = 0;
+        while (2 * i + 1 < count)
+        {
+            std::size_t child = 2 * i + 1;
+            if (child + 1 < count && less(entries[child + 1], entries[child])) // Pick the smaller child
+            {
+                child = child + 1;
+            }
+            if (!less(entries[child], last)) break;
+            entries[i] = entries[child];
+            i = child;
+        }
+        entries[i] = last;
+
+        return vertex;
+    }
+
+    /**
+     * @brief Returns the key of the minimum entry without removing it.
+     * @return The smallest key in the heap.
+     * @throws std::underflow_error if the heap is empty.
+     */
+
+    Key peekKey() const
+    {
+        if (isEmpty())
+        {
+            throw std::underflow_error("The heap is empty.");
+        }
+        return entries[0].key;
+    }
+
+    /**
+     * @brief Returns the vertex of the minimum entry without removing it.
+     * @return The vertex with the smallest key.
+     * @throws std::underflow_error if the heap is empty.
+     */
+
+    Vertex peekVertex() const
+    {
+        if (isEmpty())
+        {
+            throw std::underflow_error("The heap is empty.");
+        }
+        return entries[0].vertex;
+    }
+
+    /**
+     * @brief Removes all entries, keeping the allocated array.
+     */
+
+    void clear()
+    {
+        count = 0;
+    }
+
+    /**
+     * @brief Checks if the heap is empty.
+     * @return true if the heap is empty, false otherwise.
+     */
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Returns the number of entries in the heap.
+     * @return Number of entries.
+     */
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+};
+
+/**
+ * @brief The heap used by the int Dijkstra: 64-bit distances, int vertices.
+ */
+
+using MinHeap = BasicMinHeap<long long, int>;
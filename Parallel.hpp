@@ -0,0 +1,254 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace graph {
+
+    /**
+     * @brief Resolves a requested thread count: values below 1 mean "one per hardware thread".
+     * @param requested The number of threads asked for by the caller.
+     * @return The number of threads to use (at least 1).
+     */
+
+    inline int resolveThreadCount(int requested)
+    {
+        if (requested > 0)
+        {
+            return requested;
+        }
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        return hardware > 0 ? hardware : 1;
+    }
+
+    /**
+     * @brief Splits [begin, end) into contiguous chunks and runs body on each chunk in its own thread.
+     *
+     * body(thread_index, chunk_begin, chunk_end) is called once per thread, the calling thread runs chunk 0.
+     * Returns after every chunk is done. body must not throw.
+     *
+     * @param begin First index of the range.
+     * @param end One past the last index of the range.
+     * @param num_threads Number of threads (chunks) to use, at most one per index.
+     * @param body The work for one chunk.
+     */
+
+    template <typename Body>
+    void parallelFor(int begin, int end, int num_threads, Body body)
+    {
+        int length = end - begin;
+        if (length <= 0) return;
+        if (num_threads > length)
+        {
+            num_threads = length;
+        }
+        if (num_threads <= 1)
+        {
+            body(0, begin, end);
+            return;
+        }
+
+        std::thread* workers = new std::thread[num_threads - 1];
+        for (int t = 1; t < num_threads; t++)
+        {
+            int chunk_begin = begin + static_cast<int>(static_cast<long long>(length) * t / num_threads);
+            int chunk_end = begin + static_cast<int>(static_cast<long long>(length) * (t + 1) / num_threads);
+            workers[t - 1] = std::thread(body, t, chunk_begin, chunk_end);
+        }
+
+        body(0, begin, begin + static_cast<int>(static_cast<long long>(length) / num_threads));
+
+        for (int t = 0; t < num_threads - 1; t++)
+        {
+            workers[t].join();
+        }
+        delete[] workers;
+    }
+
+    /**
+     * @brief A fixed set of threads that stay alive across many parallelFor() calls.
+     *
+     * Algorithms that run a parallel step per phase (a BFS level, a delta-stepping bucket) would otherwise
+     * start and join new threads for every phase. The team starts its threads once; between phases they wait
+     * on a barrier, and the calling thread is member 0 of the team. Only the calling thread may use the team.
+     */
+
+    class ThreadTeam
+    {
+
+        private:
+        int size; // Number of members, the calling thread included
+        std::thread* workers; // Members 1 .. size - 1
+        std::mutex lock; // Guards the barrier state
+        std::condition_variable released; // Signalled when the last member reaches the barrier
+        int parties; // Number of members the barrier waits for
+        int waiting; // Number of members at the barrier
+        unsigned long long generation; // Counts the completed barriers, so a woken member knows it was released
+
+        // The current phase, written by member 0 before the barrier that starts it
+        void (*job)(void* body, int thread_index, int chunk_begin, int chunk_end); // Calls the type-erased body
+        void* job_body;
+        int job_begin;
+        int job_length;
+        int job_threads; // Members with an index below this get a chunk, the others only pass the barriers
+        bool stopping; // Set by the destructor, the members return instead of running a phase
+
+        template <typename Body>
+        static void callBody(void* body, int thread_index, int chunk_begin, int chunk_end)
+        {
+            (*static_cast<Body*>(body))(thread_index, chunk_begin, chunk_end);
+        }
+
+        void runChunk(int t) // Member t's share of the current phase, split like the free parallelFor()
+        {
+            if (t >= job_threads) return;
+            int chunk_begin = job_begin + static_cast<int>(static_cast<long long>(job_length) * t / job_threads);
+            int chunk_end = job_begin + static_cast<int>(static_cast<long long>(job_length) * (t + 1) / job_threads);
+            job(job_body, t, chunk_begin, chunk_end);
+        }
+
+        void sync() // Waits until every member reaches it; what a member wrote before is visible to all after
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            unsigned long long arrived_in = generation;
+            waiting++;
+            if (waiting == parties)
+            {
+                waiting = 0;
+                generation++;
+                released.notify_all();
+                return;
+            }
+            released.wait(guard, [this, arrived_in] { return generation != arrived_in; });
+        }
+
+        void workerLoop(int t)
+        {
+            while (true)
+            {
+                sync(); // Phase start
+                if (stopping) return;
+                runChunk(t);
+                sync(); // Phase end
+            }
+        }
+
+        void stop() // Releases the members from the phase-start barrier and joins the started ones
+        {
+            stopping = true;
+            sync();
+            for (int t = 0; t < parties - 1; t++)
+            {
+                workers[t].join();
+            }
+        }
+
+        public:
+
+        /**
+         * @brief Starts the threads of the team.
+         * @param num_threads Number of members, the calling thread included (values below 1 count as 1).
+         * @throws std::system_error if a thread cannot be started (the started ones are stopped first).
+         */
+
+        explicit ThreadTeam(int num_threads)
+            : size(num_threads > 1 ? num_threads : 1), workers(nullptr), parties(1), waiting(0), generation(0),
+              job(nullptr), job_body(nullptr), job_begin(0), job_length(0), job_threads(0), stopping(false)
+        {
+            if (size == 1) return;
+            workers = new std::thread[size - 1];
+            for (int t = 1; t < size; t++)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    parties++; // Counted before it starts, so the started members cannot pass the barrier alone
+                }
+                try
+                {
+                    workers[t - 1] = std::thread(&ThreadTeam::workerLoop, this, t);
+                }
+                catch (...)
+                {
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        parties--;
+                    }
+                    stop();
+                    delete[] workers;
+                    throw;
+                }
+            }
+        }
+
+        /**
+         * @brief Destructor. Stops and joins the threads.
+         */
+
+        ~ThreadTeam()
+        {
+            if (size > 1)
+            {
+                stop();
+            }
+            delete[] workers;
+        }
+
+        ThreadTeam(const ThreadTeam&) = delete; // The threads point at this team
+        ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+        /**
+         * @brief Returns the number of members.
+         * @return Number of threads, the calling thread included.
+         */
+
+        int getSize() const
+        {
+            return size;
+        }
+
+        /**
+         * @brief Splits [begin, end) into contiguous chunks and runs body on each chunk on a member of the team.
+         *
+         * Works like the free parallelFor(), without starting threads: body(thread_index, chunk_begin, chunk_end)
+         * is called once per chunk, the calling thread runs chunk 0. Returns after every chunk is done.
+         * body must not throw.
+         *
+         * @param begin First index of the range.
+         * @param end One past the last index of the range.
+         * @param num_threads Number of chunks, at most one per index and one per member.
+         * @param body The work for one chunk.
+         */
+
+        template <typename Body>
+        void parallelFor(int begin, int end, int num_threads, Body body)
+        {
+            int length = end - begin;
+            if (length <= 0) return;
+            if (num_threads > length)
+            {
+                num_threads = length;
+            }
+            if (num_threads > size)
+            {
+                num_threads = size;
+            }
+            if (num_threads <= 1) // The members stay parked
+            {
+                body(0, begin, end);
+                return;
+            }
+
+            job = &callBody<Body>;
+            job_body = &body;
+            job_begin = begin;
+            job_length = length;
+            job_threads = num_threads;
+            sync(); // Phase start
+            runChunk(0);
+            sync(); // Phase end
+        }
+    };
+}
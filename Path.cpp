@@ -0,0 +1,126 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "Path.hpp"
+#include <stdexcept>
+
+graph::Path::Path() : vertices(nullptr), length(0), cost(NO_PATH) {}
+
+graph::Path::Path(const int* parent, int target, long long total_cost) : vertices(nullptr), length(0), cost(total_cost)
+{
+    if (cost == NO_PATH) return; // The target was not reached
+
+    for (int v = target; v != -1; v = parent[v]) // Count the vertices first, so the array is allocated once
+    {
+        length++;
+    }
+    vertices = new int[length];
+    int index = length;
+    for (int v = target; v != -1; v = parent[v]) // The walk goes backwards, fill the array from the end
+    {
+        vertices[--index] = v;
+    }
+}
+
+graph::Path::Path(const int* forward_parent, const int* backward_next, int meeting, long long total_cost)
+    : vertices(nullptr), length(0), cost(total_cost)
+{
+    if (cost == NO_PATH) return; // The searches never met
+
+    int before = 0; // Vertices from the source up to and including the meeting vertex
+    for (int v = meeting; v != -1; v = forward_parent[v])
+    {
+        before++;
+    }
+    length = before;
+    for (int v = backward_next[meeting]; v != -1; v = backward_next[v])
+    {
+        length++;
+    }
+
+    vertices = new int[length];
+    int index = before;
+    for (int v = meeting; v != -1; v = forward_parent[v]) // The forward half is walked backwards, fill it from the meeting vertex down
+    {
+        vertices[--index] = v;
+    }
+    index = before;
+    for (int v = backward_next[meeting]; v != -1; v = backward_next[v])
+    {
+        vertices[index++] = v;
+    }
+}
+
+graph::Path graph::Path::fromVertices(const int* path_vertices, int count, long long total_cost)
+{
+    Path path;
+    if (count == 0 || total_cost == NO_PATH) return path;
+
+    path.vertices = new int[count];
+    for (int i = 0; i < count; i++)
+    {
+        path.vertices[i] = path_vertices[i];
+    }
+    path.length = count;
+    path.cost = total_cost;
+    return path;
+}
+
+graph::Path::~Path() // Destructor: frees the vertex array
+{
+    delete[] vertices;
+}
+
+graph::Path::Path(Path&& other) noexcept : vertices(other.vertices), length(other.length), cost(other.cost)
+{
+    // Leave other as a valid "not found" result so its destructor frees nothing
+    other.vertices = nullptr;
+    other.length = 0;
+    other.cost = NO_PATH;
+}
+
+graph::Path& graph::Path::operator=(Path&& other) noexcept
+{
+    if (this != &other)
+    {
+        delete[] vertices;
+
+        vertices = other.vertices;
+        length = other.length;
+        cost = other.cost;
+
+        other.vertices = nullptr;
+        other.length = 0;
+        other.cost = NO_PATH;
+    }
+    return *this;
+}
+
+bool graph::Path::isFound() const
+{
+    return this->length > 0;
+}
+
+long long graph::Path::getCost() const
+{
+    return this->cost;
+}
+
+int graph::Path::getLength() const
+{
+    return this->length;
+}
+
+int graph::Path::getVertex(int index) const
+{
+    if (index < 0 || index >= length)
+    {
+        throw std::out_of_range("Invalid path index.");
+    }
+    return this->vertices[index];
+}
+
+const int* graph::Path::getVertices() const
+{
+    return this->vertices;
+}
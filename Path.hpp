@@ -0,0 +1,123 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include <limits>
+
+namespace graph {
+
+    /**
+     * @brief The result of a point-to-point shortest path query: the vertices of the path and its total cost.
+     *
+     * The vertices run from the source to the target, both included. A query whose target cannot be reached
+     * returns an empty path (isFound() is false) with cost NO_PATH.
+     */
+
+    class Path
+    {
+
+        public:
+        static constexpr long long NO_PATH = std::numeric_limits<long long>::max(); // Cost of a path that was not found
+
+        private:
+        int* vertices; // The vertices of the path, source first
+        int length; // Number of vertices on the path (0 if not found)
+        long long cost; // Sum of the edge weights along the path
+
+        public:
+
+        /**
+         * @brief Constructs an empty result: no path was found.
+         */
+
+        Path();
+
+        /**
+         * @brief Builds the path to a target by following a parent array back to the root.
+         * @param parent parent[v] is the vertex before v on the path, -1 for the source.
+         * @param target The last vertex of the path.
+         * @param total_cost The cost of the path, NO_PATH if the target was not reached (parent is then not read).
+         */
+
+        Path(const int* parent, int target, long long total_cost);
+
+        /**
+         * @brief Joins the two halves of a bidirectional search at the vertex where they meet.
+         * @param forward_parent forward_parent[v] is the vertex before v on the path, -1 for the source.
+         * @param backward_next backward_next[v] is the vertex after v on the path, -1 for the target.
+         * @param meeting A vertex on the path reached by both searches.
+         * @param total_cost The cost of the path, NO_PATH if the searches did not meet (the arrays are then not read).
+         */
+
+        Path(const int* forward_parent, const int* backward_next, int meeting, long long total_cost);
+
+        /**
+         * @brief Builds a path from its vertices listed in order.
+         * @param path_vertices The vertices, source first (copied).
+         * @param count The number of vertices, 0 for a path that was not found.
+         * @param total_cost The cost of the path, NO_PATH if it was not found.
+         * @return The path.
+         */
+
+        static Path fromVertices(const int* path_vertices, int count, long long total_cost);
+
+        /**
+         * @brief Destructor. Frees the vertex array.
+         */
+
+        ~Path();
+
+        /**
+         * @brief Move constructor. Takes over the vertex array of other in O(1), other is left empty.
+         */
+
+        Path(Path&& other) noexcept;
+
+        /**
+         * @brief Move assignment. Frees this path's array and takes over the array of other.
+         */
+
+        Path& operator=(Path&& other) noexcept;
+
+        Path(const Path&) = delete; // The array is owned, copying would double-free it
+        Path& operator=(const Path&) = delete;
+
+        /**
+         * @brief Checks whether a path was found.
+         * @return true if the target is reachable from the source.
+         */
+
+        bool isFound() const;
+
+        /**
+         * @brief Returns the total cost of the path.
+         * @return The sum of the edge weights, or NO_PATH.
+         */
+
+        long long getCost() const;
+
+        /**
+         * @brief Returns the number of vertices on the path (one more than its number of edges).
+         * @return Number of vertices, 0 if no path was found.
+         */
+
+        int getLength() const;
+
+        /**
+         * @brief Returns one vertex of the path.
+         * @param index The position on the path, 0 is the source.
+         * @return The vertex at that position.
+         * @throws std::out_of_range if the index is not on the path.
+         */
+
+        int getVertex(int index) const;
+
+        /**
+         * @brief Returns the vertices of the path, source first (getLength() entries).
+         * @return A pointer to the vertex array (nullptr if no path was found).
+         */
+
+        const int* getVertices() const;
+
+    };
+}
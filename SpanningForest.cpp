@@ -0,0 +1,111 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "SpanningForest.hpp"
+#include <stdexcept>
+
+graph::SpanningForest::SpanningForest(int vertices) : num_of_vertices(vertices), edge_count(0), total_weight(0)
+{
+    int max_edges = num_of_vertices > 1 ? num_of_vertices - 1 : 0; // A forest never has more than n - 1 edges
+    sources = new int[max_edges];
+    destinations = new int[max_edges];
+    weights = new int[max_edges];
+}
+
+graph::SpanningForest::~SpanningForest() // Destructor: frees the edge arrays
+{
+    delete[] sources;
+    delete[] destinations;
+    delete[] weights;
+}
+
+graph::SpanningForest::SpanningForest(SpanningForest&& other) noexcept
+    : num_of_vertices(other.num_of_vertices), sources(other.sources), destinations(other.destinations),
+      weights(other.weights), edge_count(other.edge_count), total_weight(other.total_weight)
+{
+    // Leave other as a valid empty forest so its destructor frees nothing
+    other.num_of_vertices = 0;
+    other.sources = nullptr;
+    other.destinations = nullptr;
+    other.weights = nullptr;
+    other.edge_count = 0;
+    other.total_weight = 0;
+}
+
+graph::SpanningForest& graph::SpanningForest::operator=(SpanningForest&& other) noexcept
+{
+    if (this != &other)
+    {
+        delete[] sources;
+        delete[] destinations;
+        delete[] weights;
+
+        num_of_vertices = other.num_of_vertices;
+        sources = other.sources;
+        destinations = other.destinations;
+        weights = other.weights;
+        edge_count = other.edge_count;
+        total_weight = other.total_weight;
+
+        other.num_of_vertices = 0;
+        other.sources = nullptr;
+        other.destinations = nullptr;
+        other.weights = nullptr;
+        other.edge_count = 0;
+        other.total_weight = 0;
+    }
+    return *this;
+}
+
+void graph::SpanningForest::addEdge(int src, int dest, int weight)
+{
+    if (edge_count >= num_of_vertices - 1)
+    {
+        throw std::overflow_error("A spanning forest has at most n - 1 edges.");
+    }
+    sources[edge_count] = src;
+    destinations[edge_count] = dest;
+    weights[edge_count] = weight;
+    edge_count = edge_count + 1;
+    total_weight = total_weight + weight;
+}
+
+int graph::SpanningForest::getNumOfVertices() const
+{
+    return this->num_of_vertices;
+}
+
+int graph::SpanningForest::getNumOfEdges() const
+{
+    return this->edge_count;
+}
+
+long long graph::SpanningForest::getTotalWeight() const
+{
+    return this->total_weight;
+}
+
+const int* graph::SpanningForest::getSources() const
+{
+    return this->sources;
+}
+
+const int* graph::SpanningForest::getDestinations() const
+{
+    return this->destinations;
+}
+
+const int* graph::SpanningForest::getWeights() const
+{
+    return this->weights;
+}
+
+graph::Graph graph::SpanningForest::toGraph() const
+{
+    Graph mst(num_of_vertices);
+    for (int i = 0; i < edge_count; i++)
+    {
+        mst.addEdge(sources[i], destinations[i], weights[i]);
+    }
+    return mst;
+}
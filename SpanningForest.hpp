@@ -0,0 +1,117 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+
+namespace graph {
+
+    /**
+     * @brief The result of a minimum spanning tree algorithm (Prim, Kruskal, Borůvka) as a flat edge list.
+     *
+     * Holds the undirected edges of the spanning tree (or forest) in the order the algorithm chose them,
+     * along with their total weight. toGraph() converts it into the undirected Graph the algorithms used to return.
+     */
+
+    class SpanningForest
+    {
+
+        private:
+        int num_of_vertices; // Number of vertices of the spanned graph
+        int* sources; // sources[i] is one end of edge i
+        int* destinations; // destinations[i] is the other end of edge i
+        int* weights; // weights[i] is the weight of edge i
+        int edge_count; // Number of edges in the forest (at most num_of_vertices - 1)
+        long long total_weight; // Sum of the edge weights
+
+        public:
+
+        /**
+         * @brief Constructs an empty forest over the given number of vertices.
+         * @param vertices The number of vertices of the spanned graph.
+         */
+
+        SpanningForest(int vertices);
+
+        /**
+         * @brief Destructor. Frees the edge arrays.
+         */
+
+        ~SpanningForest();
+
+        /**
+         * @brief Move constructor. Takes over the arrays of other in O(1), other is left empty.
+         */
+
+        SpanningForest(SpanningForest&& other) noexcept;
+
+        /**
+         * @brief Move assignment. Frees this forest's arrays and takes over the arrays of other.
+         */
+
+        SpanningForest& operator=(SpanningForest&& other) noexcept;
+
+        SpanningForest(const SpanningForest&) = delete; // The arrays are owned, copying would double-free them
+        SpanningForest& operator=(const SpanningForest&) = delete;
+
+        /**
+         * @brief Appends an edge to the forest. Used by the algorithms as they accept edges.
+         * @param src One end of the edge.
+         * @param dest The other end of the edge.
+         * @param weight The weight of the edge.
+         * @throws std::overflow_error if the forest already has num_of_vertices - 1 edges.
+         */
+
+        void addEdge(int src, int dest, int weight);
+
+        /**
+         * @brief Returns the number of vertices of the spanned graph.
+         * @return Number of vertices.
+         */
+
+        int getNumOfVertices() const;
+
+        /**
+         * @brief Returns the number of edges in the forest.
+         * @return Number of edges.
+         */
+
+        int getNumOfEdges() const;
+
+        /**
+         * @brief Returns the sum of the edge weights.
+         * @return The total weight of the forest.
+         */
+
+        long long getTotalWeight() const;
+
+        /**
+         * @brief Returns one end of every edge (getNumOfEdges() entries).
+         * @return A pointer to the source array.
+         */
+
+        const int* getSources() const;
+
+        /**
+         * @brief Returns the other end of every edge (getNumOfEdges() entries).
+         * @return A pointer to the destination array.
+         */
+
+        const int* getDestinations() const;
+
+        /**
+         * @brief Returns the weight of every edge (getNumOfEdges() entries).
+         * @return A pointer to the weight array.
+         */
+
+        const int* getWeights() const;
+
+        /**
+         * @brief Builds the forest as an undirected graph, adding the edges in the order they were chosen.
+         * @return An undirected graph representing the MST (or forest).
+         */
+
+        Graph toGraph() const;
+
+    };
+}
@@ -0,0 +1,304 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "GraphTypes.hpp"
+#include <stdexcept>
+#include <limits>
+
+namespace graph {
+
+    /**
+     * @brief The result of a traversal (BFS, DFS, Dijkstra) stored as flat per-vertex arrays.
+     *
+     * For every vertex it holds its parent in the tree, the weight of the edge from the parent,
+     * and its distance from the root (number of edges for BFS and DFS, total weight for Dijkstra).
+     * It also records the order in which vertices were reached. Roots and unreached vertices
+     * have parent NO_PARENT (-1 for int ids); unreached vertices have distance UNREACHED.
+     *
+     * The algorithms fill the arrays directly, which is much cheaper than building a Graph.
+     * toGraph() converts the result into the rooted tree Graph the algorithms used to return.
+     *
+     * @tparam VertexId Integral type of vertex ids, as in BasicCSRGraph.
+     * @tparam Weight Type of edge weights, as in BasicCSRGraph. With NoWeight no parent weight array is stored.
+     */
+
+    template <typename VertexId, typename Weight>
+    class BasicTraversalTree
+    {
+
+        public:
+        using Distance = typename WeightTraits<Weight>::Distance; // Type of the distances from the root
+
+        static constexpr bool HAS_WEIGHTS = WeightTraits<Weight>::HAS_WEIGHTS;
+        static constexpr Distance UNREACHED = std::numeric_limits<Distance>::max(); // Distance of a vertex the traversal did not reach
+        static constexpr VertexId NO_PARENT = static_cast<VertexId>(-1); // Parent of roots and unreached vertices
+
+        private:
+        VertexId num_of_vertices; // Number of vertices of the traversed graph
+        VertexId* parent; // parent[v] is v's parent in the tree, NO_PARENT for roots and unreached vertices
+        Weight* parent_weight; // parent_weight[v] is the weight of the edge parent[v] -> v (nullptr for NoWeight)
+        Distance* distance; // distance[v] from the root of v's tree, UNREACHED if v was not reached
+        VertexId* order; // The reached vertices, in the order the traversal reached them
+        VertexId reached_count; // Number of valid entries in order
+
+        friend class Algorithms; // The algorithms fill the arrays directly
+
+        /**
+         * @brief Records that the traversal reached vertex (appends it to the order).
+         */
+
+        void discover(VertexId vertex, VertexId parent_vertex, Weight weight, Distance vertex_distance)
+        {
+            parent[vertex] = parent_vertex;
+            if constexpr (HAS_WEIGHTS)
+            {
+                parent_weight[vertex] = weight;
+            }
+            distance[vertex] = vertex_distance;
+            order[reached_count++] = vertex;
+        }
+
+        void checkVertex(VertexId vertex) const
+        {
+            if (!isValidVertex(vertex, num_of_vertices))
+            {
+                throw std::out_of_range("Invalid vertex. ");
+            }
+        }
+
+        void release() // Frees the arrays
+        {
+            delete[] parent;
+            delete[] parent_weight;
+            delete[] distance;
+            delete[] order;
+        }
+
+        void stealFrom(BasicTraversalTree& other) // Takes over the arrays of other and leaves it empty
+        {
+            num_of_vertices = other.num_of_vertices;
+            parent = other.parent;
+            parent_weight = other.parent_weight;
+            distance = other.distance;
+            order = other.order;
+            reached_count = other.reached_count;
+
+            // Leave other as a valid empty result so its destructor frees nothing
+            other.num_of_vertices = 0;
+            other.parent = nullptr;
+            other.parent_weight = nullptr;
+            other.distance = nullptr;
+            other.order = nullptr;
+            other.reached_count = 0;
+        }
+
+        public:
+
+        /**
+         * @brief Constructs an empty result where no vertex is reached yet.
+         * @param vertices The number of vertices of the traversed graph.
+         */
+
+        BasicTraversalTree(VertexId vertices) : num_of_vertices(vertices), reached_count(0)
+        {
+            parent = new VertexId[num_of_vertices];
+            parent_weight = HAS_WEIGHTS ? new Weight[num_of_vertices] : nullptr;
+            distance = new Distance[num_of_vertices];
+            order = new VertexId[num_of_vertices];
+
+            for (VertexId v = 0; v < num_of_vertices; v++) // Nothing is reached yet
+            {
+                parent[v] = NO_PARENT;
+                if constexpr (HAS_WEIGHTS)
+                {
+                    parent_weight[v] = 0;
+                }
+                distance[v] = UNREACHED;
+            }
+        }
+
+        /**
+         * @brief Destructor. Frees the per-vertex arrays.
+         */
+
+        ~BasicTraversalTree()
+        {
+            release();
+        }
+
+        /**
+         * @brief Move constructor. Takes over the arrays of other in O(1), other is left empty.
+         */
+
+        BasicTraversalTree(BasicTraversalTree&& other) noexcept
+        {
+            stealFrom(other);
+        }
+
+        /**
+         * @brief Move assignment. Frees this result's arrays and takes over the arrays of other.
+         */
+
+        BasicTraversalTree& operator=(BasicTraversalTree&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                stealFrom(other);
+            }
+            return *this;
+        }
+
+        BasicTraversalTree(const BasicTraversalTree&) = delete; // The arrays are owned, copying would double-free them
+        BasicTraversalTree& operator=(const BasicTraversalTree&) = delete;
+
+        /**
+         * @brief Returns the number of vertices of the traversed graph.
+         * @return Number of vertices.
+         */
+
+        VertexId getNumOfVertices() const
+        {
+            return num_of_vertices;
+        }
+
+        /**
+         * @brief Returns the number of vertices the traversal reached.
+         * @return Number of reached vertices.
+         */
+
+        VertexId getReachedCount() const
+        {
+            return reached_count;
+        }
+
+        /**
+         * @brief Returns the parent of a vertex.
+         * @param vertex The vertex index.
+         * @return The parent, or NO_PARENT for a root or an unreached vertex.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        VertexId getParent(VertexId vertex) const
+        {
+            checkVertex(vertex);
+            return parent[vertex];
+        }
+
+        /**
+         * @brief Returns the weight of the edge from a vertex's parent to the vertex. Only available with weights.
+         * @param vertex The vertex index.
+         * @return The weight, or 0 for a root or an unreached vertex.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        Weight getParentWeight(VertexId vertex) const
+        {
+            static_assert(HAS_WEIGHTS, "An unweighted traversal has no parent weights");
+            checkVertex(vertex);
+            return parent_weight[vertex];
+        }
+
+        /**
+         * @brief Returns the distance of a vertex from the root of its tree.
+         * @param vertex The vertex index.
+         * @return The distance, or UNREACHED.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        Distance getDistance(VertexId vertex) const
+        {
+            checkVertex(vertex);
+            return distance[vertex];
+        }
+
+        /**
+         * @brief Checks whether the traversal reached a vertex.
+         * @param vertex The vertex index.
+         * @return true if the vertex was reached, false otherwise.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        bool isReached(VertexId vertex) const
+        {
+            return getDistance(vertex) != UNREACHED;
+        }
+
+        /**
+         * @brief Returns the whole parent array (num_of_vertices entries).
+         * @return A pointer to the parent array.
+         */
+
+        const VertexId* getParents() const
+        {
+            return parent;
+        }
+
+        /**
+         * @brief Returns the whole parent weight array (num_of_vertices entries).
+         * @return A pointer to the parent weight array, nullptr for NoWeight.
+         */
+
+        const Weight* getParentWeights() const
+        {
+            return parent_weight;
+        }
+
+        /**
+         * @brief Returns the whole distance array (num_of_vertices entries).
+         * @return A pointer to the distance array.
+         */
+
+        const Distance* getDistances() const
+        {
+            return distance;
+        }
+
+        /**
+         * @brief Returns the reached vertices in the order they were reached (getReachedCount() entries).
+         * @return A pointer to the order array.
+         */
+
+        const VertexId* getOrder() const
+        {
+            return order;
+        }
+
+        /**
+         * @brief Builds the tree as a directed graph, with an edge parent[v] -> v for every non-root reached vertex.
+         *
+         * Edges are added in the order the vertices were reached. Ids and weights are converted to int
+         * (edges of a NoWeight tree get weight 1), so the tree must fit a Graph.
+         *
+         * @return A rooted tree (or forest) as a directed graph.
+         */
+
+        Graph toGraph() const
+        {
+            Graph tree(static_cast<int>(num_of_vertices));
+            for (VertexId k = 0; k < reached_count; k++) // Same insertion order as the traversal, so adjacency lists match
+            {
+                VertexId v = order[k];
+                if (parent[v] != NO_PARENT)
+                {
+                    int weight = 1;
+                    if constexpr (HAS_WEIGHTS)
+                    {
+                        weight = static_cast<int>(parent_weight[v]);
+                    }
+                    tree.addDirectedEdge(static_cast<int>(parent[v]), static_cast<int>(v), weight);
+                }
+            }
+            return tree;
+        }
+
+    };
+
+    /**
+     * @brief The traversal result over int vertex ids and int weights, with 64-bit distances.
+     */
+
+    using TraversalTree = BasicTraversalTree<int, int>;
+}
@@ -0,0 +1,71 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#include "VertexCoordinates.hpp"
+
+graph::VertexCoordinates::VertexCoordinates(int vertices) : num_of_vertices(vertices)
+{
+    xs = new double[num_of_vertices];
+    ys = new double[num_of_vertices];
+    for (int i = 0; i < num_of_vertices; i++)
+    {
+        xs[i] = 0;
+        ys[i] = 0;
+    }
+}
+
+graph::VertexCoordinates::~VertexCoordinates() // Destructor: frees the coordinate arrays
+{
+    delete[] xs;
+    delete[] ys;
+}
+
+graph::VertexCoordinates::VertexCoordinates(VertexCoordinates&& other) noexcept
+    : num_of_vertices(other.num_of_vertices), xs(other.xs), ys(other.ys)
+{
+    other.num_of_vertices = 0;
+    other.xs = nullptr;
+    other.ys = nullptr;
+}
+
+void graph::VertexCoordinates::checkVertex(int vertex) const
+{
+    if (vertex < 0 || vertex >= num_of_vertices) // Bounds check
+    {
+        throw std::out_of_range("Invalid vertex index.");
+    }
+}
+
+void graph::VertexCoordinates::setCoordinates(int vertex, double x, double y)
+{
+    checkVertex(vertex);
+    xs[vertex] = x;
+    ys[vertex] = y;
+}
+
+double graph::VertexCoordinates::getX(int vertex) const
+{
+    checkVertex(vertex);
+    return this->xs[vertex];
+}
+
+double graph::VertexCoordinates::getY(int vertex) const
+{
+    checkVertex(vertex);
+    return this->ys[vertex];
+}
+
+int graph::VertexCoordinates::getNumOfVertices() const
+{
+    return this->num_of_vertices;
+}
+
+const double* graph::VertexCoordinates::getXs() const
+{
+    return this->xs;
+}
+
+const double* graph::VertexCoordinates::getYs() const
+{
+    return this->ys;
+}
@@ -0,0 +1,221 @@
+// Noga Peled
+// nogapeled19@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace graph {
+
+    /**
+     * @brief The position of every vertex of a graph in the plane, stored alongside the graph.
+     *
+     * Geometric graphs (road networks, grids) use the positions to guide A* towards the target.
+     * The x and y coordinates are kept in two flat arrays indexed by vertex, 0 for every vertex until set.
+     */
+
+    class VertexCoordinates
+    {
+
+        private:
+        int num_of_vertices; // Number of vertices
+        double* xs; // x coordinate of every vertex
+        double* ys; // y coordinate of every vertex
+
+        void checkVertex(int vertex) const;
+
+        public:
+
+        /**
+         * @brief Constructs the coordinates of a graph, every vertex at the origin.
+         * @param vertices The number of vertices.
+         */
+
+        VertexCoordinates(int vertices);
+
+        /**
+         * @brief Destructor. Frees the coordinate arrays.
+         */
+
+        ~VertexCoordinates();
+
+        /**
+         * @brief Move constructor. Takes over the arrays of other in O(1), other is left with 0 vertices.
+         */
+
+        VertexCoordinates(VertexCoordinates&& other) noexcept;
+
+        VertexCoordinates(const VertexCoordinates&) = delete; // The arrays are owned, copying would double-free them
+        VertexCoordinates& operator=(const VertexCoordinates&) = delete;
+
+        /**
+         * @brief Sets the position of a vertex.
+         * @param vertex The vertex index.
+         * @param x The x coordinate.
+         * @param y The y coordinate.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        void setCoordinates(int vertex, double x, double y);
+
+        /**
+         * @brief Returns the x coordinate of a vertex.
+         * @param vertex The vertex index.
+         * @return The x coordinate.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        double getX(int vertex) const;
+
+        /**
+         * @brief Returns the y coordinate of a vertex.
+         * @param vertex The vertex index.
+         * @return The y coordinate.
+         * @throws std::out_of_range if the vertex index is invalid.
+         */
+
+        double getY(int vertex) const;
+
+        /**
+         * @brief Returns the number of vertices.
+         * @return Number of vertices.
+         */
+
+        int getNumOfVertices() const;
+
+        /**
+         * @brief Returns the x coordinates of all vertices (getNumOfVertices() entries), for unchecked access in heuristics.
+         * @return A pointer to the x coordinate array.
+         */
+
+        const double* getXs() const;
+
+        /**
+         * @brief Returns the y coordinates of all vertices (getNumOfVertices() entries), for unchecked access in heuristics.
+         * @return A pointer to the y coordinate array.
+         */
+
+        const double* getYs() const;
+
+    };
+
+    /**
+     * @brief A* heuristic: the straight-line distance from a vertex to the target, times a scale.
+     *
+     * The estimate is a lower bound on the remaining cost (and consistent, as A* needs) as long as every edge
+     * weighs at least scale times the straight-line length between its ends, e.g. scale = 1 when the weights
+     * are lengths, or the smallest cost per unit of length otherwise. It is rounded down to an integer cost.
+     * The call is defined inline here so aStar() can inline it into its loop.
+     */
+
+    class EuclideanHeuristic
+    {
+
+        private:
+        const double* xs; // x coordinates of the vertices
+        const double* ys; // y coordinates of the vertices
+        double target_x; // Position of the target
+        double target_y;
+        double scale; // Lowest edge cost per unit of length
+
+        public:
+
+        /**
+         * @brief Constructs the heuristic towards one target.
+         * @param g The graph the search runs on; the coordinates must have one position per vertex of it.
+         * @param coordinates The positions of the vertices, must outlive the heuristic.
+         * @param target The target vertex of the search.
+         * @param cost_per_unit The lowest edge cost per unit of length (default is 1).
+         * @throws std::invalid_argument if the coordinates do not have the vertices of g, or cost_per_unit is negative.
+         * @throws std::out_of_range if the target is invalid.
+         */
+
+        EuclideanHeuristic(const Graph& g, const VertexCoordinates& coordinates, int target, double cost_per_unit = 1.0)
+            : xs(coordinates.getXs()), ys(coordinates.getYs()), target_x(0), target_y(0), scale(cost_per_unit)
+        {
+            if (coordinates.getNumOfVertices() != g.getNumOfVertices()) // operator() reads the positions unchecked
+            {
+                throw std::invalid_argument("The coordinates do not have the vertices of the graph.");
+            }
+            if (cost_per_unit < 0)
+            {
+                throw std::invalid_argument("The cost per unit of length must not be negative.");
+            }
+            target_x = coordinates.getX(target);
+            target_y = coordinates.getY(target);
+        }
+
+        /**
+         * @brief Estimates the cost from a vertex to the target.
+         * @param vertex The vertex index (not checked, aStar() only passes vertices of the graph).
+         * @return A lower bound on the cost of any path from vertex to the target.
+         */
+
+        long long operator()(int vertex) const
+        {
+            double dx = xs[vertex] - target_x;
+            double dy = ys[vertex] - target_y;
+            return static_cast<long long>(std::sqrt(dx * dx + dy * dy) * scale);
+        }
+
+    };
+
+    /**
+     * @brief A* heuristic: the Manhattan (grid) distance from a vertex to the target, times a scale.
+     *
+     * Tighter than the Euclidean distance on graphs that only move along the axes, such as grids,
+     * where every edge weighs at least scale times the Manhattan length between its ends.
+     * It is rounded down to an integer cost.
+     */
+
+    class ManhattanHeuristic
+    {
+
+        private:
+        const double* xs; // x coordinates of the vertices
+        const double* ys; // y coordinates of the vertices
+        double target_x; // Position of the target
+        double target_y;
+        double scale; // Lowest edge cost per unit of length
+
+        public:
+
+        /**
+         * @brief Constructs the heuristic towards one target.
+         * @param g The graph the search runs on; the coordinates must have one position per vertex of it.
+         * @param coordinates The positions of the vertices, must outlive the heuristic.
+         * @param target The target vertex of the search.
+         * @param cost_per_unit The lowest edge cost per unit of length (default is 1).
+         * @throws std::invalid_argument if the coordinates do not have the vertices of g, or cost_per_unit is negative.
+         * @throws std::out_of_range if the target is invalid.
+         */
+
+        ManhattanHeuristic(const Graph& g, const VertexCoordinates& coordinates, int target, double cost_per_unit = 1.0)
+            : xs(coordinates.getXs()), ys(coordinates.getYs()), target_x(0), target_y(0), scale(cost_per_unit)
+        {
+            if (coordinates.getNumOfVertices() != g.getNumOfVertices()) // operator() reads the positions unchecked
+            {
+                throw std::invalid_argument("The coordinates do not have the vertices of the graph.");
+            }
+            if (cost_per_unit < 0)
+            {
+                throw std::invalid_argument("The cost per unit of length must not be negative.");
+            }
+            target_x = coordinates.getX(target);
+            target_y = coordinates.getY(target);
+        }
+
+        /**
+         * @brief Estimates the cost from a vertex to the target.
+         * @param vertex The vertex index (not checked, aStar() only passes vertices of the graph).
+         * @return A lower bound on the cost of any path from vertex to the target.
+         */
+
+        long long operator()(int vertex) const
+        {
+            return static_cast<long long>((std::fabs(xs[vertex] - target_x) + std::fabs(ys[vertex] - target_y)) * scale);
+        }
+
+    };
+}
@@ -5,13 +5,66 @@
 #include "doctest.h"
 #include "Graph.hpp"
 #include "Algorithms.hpp"
+#include "CSRGraph.hpp"
+#include "EdgePool.hpp"
+#include "EdgeIndex.hpp"
+#include "GraphBuilder.hpp"
 #include "Queue.hpp"
 #include "UnionFind.hpp"
+#include "MinHeap.hpp"
+#include "IndexedHeap.hpp"
+#include "BucketQueue.hpp"
+#include "Bitmap.hpp"
+#include "TraversalTree.hpp"
+#include "SpanningForest.hpp"
+#include "GraphFile.hpp"
+#include "EdgeListLoader.hpp"
+#include "ContractionHierarchy.hpp"
+#include "Landmarks.hpp"
+#include "Parallel.hpp"
+#include <atomic>
 #include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
 
 using namespace graph;
 
+// Advances a linear congruential generator and returns its next value in 0 .. bound - 1, the same on every run
+static int nextRandom(unsigned int& seed, int bound) {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<int>((seed >> 8) % static_cast<unsigned int>(bound));
+}
+
+// m random edges over n vertices with weights in min_weight .. max_weight, self-loops included
+static std::vector<EdgeTriple> randomEdges(int n, int m, unsigned int seed, int max_weight, int min_weight = 1) {
+    std::vector<EdgeTriple> edges;
+    for (int i = 0; i < m; i++) {
+        int u = nextRandom(seed, n);
+        int v = nextRandom(seed, n);
+        edges.push_back({u, v, min_weight + nextRandom(seed, max_weight - min_weight + 1)});
+    }
+    return edges;
+}
+
+// A graph of randomEdges(), added one by one with addEdge() or addDirectedEdge(); self-loops are dropped unless asked for
+static Graph randomGraph(int n, int m, unsigned int seed, int max_weight, int min_weight = 1, bool is_directed = false, bool self_loops = false) {
+    Graph g(n);
+    for (const EdgeTriple& e : randomEdges(n, m, seed, max_weight, min_weight)) {
+        if (e.src == e.dest && !self_loops) continue;
+        if (is_directed) {
+            g.addDirectedEdge(e.src, e.dest, e.weight);
+        } else {
+            g.addEdge(e.src, e.dest, e.weight);
+        }
+    }
+    return g;
+}
+
 // Graph Tests 
 
 TEST_CASE("Graph construction and vertex count") {
@@ -88,6 +141,325 @@ TEST_CASE("Graph getWeight invalid vertex") {
     CHECK_THROWS_AS(g.getWeight(0, 5), std::out_of_range);
 }
 
+TEST_CASE("Graph move steals the edges") {
+    Graph g(3);
+    g.addEdge(0, 1, 5);
+    g.enableEdgeIndex();
+    Edge* head = g.getAdjList()[0];
+    Graph moved(std::move(g));
+    CHECK(moved.getAdjList()[0] == head); // No edge was copied
+    CHECK(moved.getWeight(1, 0) == 5);
+    CHECK(moved.hasEdgeIndex());
+    CHECK(g.getNumOfVertices() == 0);
+    CHECK_FALSE(g.hasEdgeIndex());
+
+    Graph other(2);
+    other.addEdge(0, 1, 7);
+    other = std::move(moved);
+    CHECK(other.getNumOfVertices() == 3);
+    CHECK(other.getWeight(0, 1) == 5);
+    other.addEdge(1, 2, 9); // The pool keeps working after a move
+    CHECK(other.getWeight(2, 1) == 9);
+    g = Graph(4); // A moved-from graph can be assigned again
+    g.addEdge(2, 3, 1);
+    CHECK(g.getWeight(3, 2) == 1);
+}
+
+TEST_CASE("Graph clone is a deep copy") {
+    Graph g(4);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 2);
+    g.addDirectedEdge(3, 0, 3);
+    Graph copy = g.clone();
+    for (int u = 0; u < 4; u++) { // Same lists in the same order, but separate edges
+        Edge* a = g.getAdjList()[u];
+        Edge* b = copy.getAdjList()[u];
+        while (a != nullptr && b != nullptr) {
+            CHECK(a != b);
+            CHECK(a->dest_vertex == b->dest_vertex);
+            CHECK(a->weight == b->weight);
+            a = a->next;
+            b = b->next;
+        }
+        CHECK(a == nullptr);
+        CHECK(b == nullptr);
+    }
+    CHECK_FALSE(copy.hasEdgeIndex());
+    copy.removeEdge(0, 1);
+    CHECK(g.getWeight(0, 1) == 1);
+    g.enableEdgeIndex();
+    CHECK(g.clone().hasEdgeIndex());
+}
+
+TEST_CASE("Graph accepts new edges after clone") {
+    Graph g(1000);
+    for (int v = 0; v + 1 < 1000; v++) g.addEdge(v, v + 1, v % 7);
+    Graph copy = g.clone();
+    copy.addDirectedEdge(5, 500, 9);
+    copy.addEdge(999, 0, 4);
+    CHECK(copy.getWeight(5, 500) == 9);
+    CHECK(copy.getWeight(0, 999) == 4);
+    CHECK(copy.getWeight(998, 999) == 998 % 7);
+    CHECK(g.getWeight(5, 500) == INT_MAX);
+}
+
+TEST_CASE("Graphs in a std::vector") {
+    std::vector<Graph> graphs;
+    for (int i = 0; i < 20; i++) { // Reallocations move the graphs
+        graphs.push_back(Graph(i + 2));
+        graphs.back().addEdge(0, i + 1, i);
+    }
+    graphs.push_back(Algorithms::bfs(graphs[5], 0));
+    for (int i = 0; i < 20; i++) {
+        CHECK(graphs[i].getNumOfVertices() == i + 2);
+        CHECK(graphs[i].getWeight(i + 1, 0) == i);
+    }
+    CHECK(graphs[20].getWeight(0, 6) == 5);
+}
+
+// EdgePool Tests 
+
+TEST_CASE("EdgePool allocates initialized edges") {
+    EdgePool pool(2);
+    Edge* first = pool.allocate(1, 10, nullptr);
+    Edge* second = pool.allocate(2, 20, first);
+    Edge* third = pool.allocate(3, 30, second); // Spills into a second slab
+    CHECK(first->dest_vertex == 1);
+    CHECK(first->weight == 10);
+    CHECK(second->next == first);
+    CHECK(third->next == second);
+    CHECK(third->dest_vertex == 3);
+}
+
+TEST_CASE("EdgePool reserve keeps later slabs small") {
+    const int count = 200000;
+    EdgePool pool;
+    pool.reserve(count);
+    CHECK(pool.getCapacity() == count);
+    for (int i = 0; i < count; i++) pool.allocate(i, i, nullptr);
+    CHECK(pool.getCapacity() == count); // Every edge came from the reserved slab
+    pool.allocate(0, 0, nullptr);
+    CHECK(pool.getCapacity() == count + 64); // The next slab has the default size, not another count
+    pool.reserve(0);
+    CHECK(pool.getCapacity() == count + 64);
+    EdgePool huge(1 << 20);
+    huge.allocate(0, 0, nullptr);
+    CHECK(huge.getCapacity() == 1 << 16); // Slabs are capped at 64K edges
+}
+
+TEST_CASE("EdgePool reuses released edges") {
+    EdgePool pool;
+    Edge* edge = pool.allocate(1, 5, nullptr);
+    pool.release(edge);
+    Edge* reused = pool.allocate(4, 8, nullptr);
+    CHECK(reused == edge);
+    CHECK(reused->dest_vertex == 4);
+    CHECK(reused->weight == 8);
+    CHECK(reused->next == nullptr);
+}
+
+TEST_CASE("Graph add after remove reuses pooled edges") {
+    Graph g(3);
+    g.addEdge(0, 1, 2);
+    g.removeEdge(0, 1);
+    g.addEdge(1, 2, 6);
+    CHECK(g.getWeight(0, 1) == INT_MAX);
+    CHECK(g.getWeight(1, 2) == 6);
+    CHECK(g.getWeight(2, 1) == 6);
+}
+
+// EdgeIndex Tests 
+
+TEST_CASE("EdgeIndex insert, find and erase") {
+    EdgeIndex index;
+    Edge a{1, 3, nullptr};
+    Edge b{2, 4, nullptr};
+    index.insert(0, 1, &a);
+    index.insert(0, 2, &b);
+    CHECK(index.size() == 2);
+    CHECK(index.find(0, 1) == &a);
+    CHECK(index.find(1, 0) == nullptr);
+    index.insert(0, 1, &b); // Replaces the mapping
+    CHECK(index.size() == 2);
+    CHECK(index.find(0, 1) == &b);
+    index.erase(0, 1);
+    index.erase(5, 5); // Not indexed, no effect
+    CHECK(index.size() == 1);
+    CHECK(index.find(0, 1) == nullptr);
+    CHECK(index.find(0, 2) == &b);
+}
+
+TEST_CASE("EdgeIndex keeps every key reachable across growth and erases") {
+    EdgeIndex index(1);
+    Edge edge{0, 0, nullptr};
+    for (int i = 0; i < 1000; i++) {
+        index.insert(i % 7, i, &edge);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        index.erase(i % 7, i);
+    }
+    CHECK(index.size() == 500);
+    for (int i = 0; i < 1000; i++) {
+        CHECK((index.find(i % 7, i) != nullptr) == (i % 2 == 1));
+    }
+}
+
+TEST_CASE("Graph with edge index behaves like without") {
+    Graph g(5);
+    g.addEdge(0, 1, 4);
+    g.enableEdgeIndex();
+    CHECK(g.hasEdgeIndex());
+    CHECK(g.getWeight(0, 1) == 4);
+    g.addEdge(0, 1, 9); // Updates the existing edge through the index
+    g.addDirectedEdge(2, 3, 6);
+    g.addEdge(3, 4, 1);
+    CHECK(g.getWeight(1, 0) == 9);
+    CHECK(g.getWeight(2, 3) == 6);
+    CHECK(g.getWeight(3, 2) == INT_MAX);
+    int degree = 0;
+    for (Edge* e = g.getAdjList()[0]; e != nullptr; e = e->next) {
+        degree++;
+    }
+    CHECK(degree == 1);
+    g.removeEdge(3, 4);
+    CHECK(g.getWeight(3, 4) == INT_MAX);
+    CHECK(g.getWeight(4, 3) == INT_MAX);
+    g.disableEdgeIndex();
+    CHECK(!g.hasEdgeIndex());
+    CHECK(g.getWeight(0, 1) == 9);
+}
+
+TEST_CASE("Graph edge index on a high-degree hub") {
+    Graph g(2001);
+    g.enableEdgeIndex();
+    for (int i = 1; i <= 2000; i++) {
+        g.addEdge(0, i, i);
+    }
+    for (int i = 1; i <= 2000; i++) {
+        g.addEdge(0, i, i + 1); // Every call hits the existing edge
+    }
+    CHECK(g.getWeight(0, 1500) == 1501);
+    CHECK(g.getWeight(1500, 0) == 1501);
+    Graph tree = Algorithms::dijkstra(g, 0);
+    CHECK(tree.getWeight(0, 2000) == 2001);
+}
+
+// GraphBuilder Tests 
+
+TEST_CASE("GraphBuilder builds an undirected graph") {
+    GraphBuilder builder(4);
+    builder.addEdge(0, 1, 2);
+    builder.addEdge(2, 0, 5);
+    builder.addEdge(3, 3, 1);
+    Graph g = builder.build();
+    CHECK(builder.getNumOfEdges() == 3);
+    CHECK(g.getWeight(0, 1) == 2);
+    CHECK(g.getWeight(1, 0) == 2);
+    CHECK(g.getWeight(0, 2) == 5);
+    CHECK(g.getWeight(2, 0) == 5);
+    CHECK(g.getWeight(3, 3) == 1);
+    REQUIRE(g.getAdjList()[3]->next != nullptr); // Self-loop stored twice, like addEdge does
+    CHECK(g.getAdjList()[3]->next->dest_vertex == 3);
+    CHECK(g.getAdjList()[3]->next->next == nullptr);
+    CHECK(g.getAdjList()[0]->dest_vertex == 1); // Lists are sorted by destination
+    CHECK(g.getAdjList()[0]->next->dest_vertex == 2);
+}
+
+TEST_CASE("GraphBuilder duplicate policies") {
+    EdgeTriple batch[] = {{0, 1, 7}, {1, 2, 4}, {0, 1, 3}, {0, 1, 5}};
+    GraphBuilder builder(3, true);
+    builder.addEdges(batch, 4);
+
+    Graph last = builder.build(DuplicatePolicy::KeepLast);
+    CHECK(last.getWeight(0, 1) == 5);
+    CHECK(last.getAdjList()[0]->next == nullptr);
+
+    Graph min = builder.build(DuplicatePolicy::KeepMin);
+    CHECK(min.getWeight(0, 1) == 3);
+    CHECK(min.getWeight(1, 0) == INT_MAX); // Directed builder
+
+    Graph all = builder.build(DuplicatePolicy::KeepAll);
+    int count = 0;
+    for (Edge* e = all.getAdjList()[0]; e != nullptr; e = e->next) {
+        count++;
+    }
+    CHECK(count == 3);
+    CHECK(all.getWeight(1, 2) == 4);
+}
+
+TEST_CASE("removeEdge on parallel edges keeps the edge index in sync") {
+    EdgeTriple batch[] = {{0, 1, 5}, {0, 1, 7}};
+    GraphBuilder builder(2);
+    builder.addEdges(batch, 2);
+    for (bool indexed : {false, true}) {
+        Graph g = builder.build(DuplicatePolicy::KeepAll);
+        if (indexed) g.enableEdgeIndex();
+        CHECK(g.getWeight(0, 1) == 5);
+        g.removeEdge(0, 1);
+        CHECK(g.getWeight(0, 1) == 7); // The remaining parallel edge, found with or without the index
+        CHECK(g.getWeight(1, 0) == 7);
+        g.addEdge(0, 1, 9); // Updates the remaining edge instead of adding a third
+        CHECK(g.getAdjList()[0]->next == nullptr);
+        CHECK(g.getAdjList()[0]->weight == 9);
+        g.removeEdge(0, 1);
+        CHECK(g.getWeight(0, 1) == INT_MAX);
+        CHECK(g.getAdjList()[1] == nullptr);
+    }
+}
+
+TEST_CASE("GraphBuilder matches repeated addEdge") {
+    Graph incremental(6);
+    GraphBuilder builder(6);
+    int edges[][3] = {{0, 1, 2}, {0, 2, 4}, {1, 2, 1}, {1, 3, 7}, {2, 4, 3}, {3, 4, 2}, {3, 5, 1}, {4, 5, 5}, {1, 0, 6}};
+    for (auto& e : edges) {
+        incremental.addEdge(e[0], e[1], e[2]);
+        builder.addEdge(e[0], e[1], e[2]);
+    }
+    Graph bulk = builder.build();
+    for (int u = 0; u < 6; u++) {
+        for (int v = 0; v < 6; v++) {
+            CHECK(bulk.getWeight(u, v) == incremental.getWeight(u, v));
+        }
+    }
+    bulk.removeEdge(0, 1); // Built edges come from the graph's pool like any other
+    CHECK(bulk.getWeight(1, 0) == INT_MAX);
+}
+
+TEST_CASE("GraphBuilder self-loops behave like addEdge") {
+    GraphBuilder builder(3);
+    builder.addEdge(1, 1, 6);
+    builder.addEdge(1, 1, 2);
+    builder.addEdge(0, 1, 3);
+    for (DuplicatePolicy policy : {DuplicatePolicy::KeepLast, DuplicatePolicy::KeepMin}) {
+        Graph g = builder.build(policy);
+        CHECK(g.getWeight(1, 1) == 2);
+        g.removeEdge(1, 1); // Removes both copies, nothing is left to report missing
+        CHECK(g.getWeight(1, 1) == INT_MAX);
+        CHECK(g.getWeight(1, 0) == 3);
+        CHECK_THROWS_AS(g.removeEdge(1, 1), std::runtime_error);
+    }
+    Graph incremental(3);
+    incremental.addEdge(2, 2, 4);
+    GraphBuilder single(3);
+    single.addEdge(2, 2, 4);
+    Graph bulk = single.build();
+    int built_copies = 0, added_copies = 0;
+    for (Edge* e = bulk.getAdjList()[2]; e != nullptr; e = e->next) built_copies++;
+    for (Edge* e = incremental.getAdjList()[2]; e != nullptr; e = e->next) added_copies++;
+    CHECK(built_copies == added_copies);
+}
+
+TEST_CASE("GraphBuilder invalid edges") {
+    GraphBuilder builder(2);
+    CHECK_THROWS_AS(builder.addEdge(0, 2), std::out_of_range);
+    EdgeTriple batch[] = {{0, 1, 1}, {-1, 0, 1}};
+    CHECK_THROWS_AS(builder.addEdges(batch, 2), std::out_of_range);
+    CHECK(builder.getNumOfEdges() == 0);
+    builder.addEdge(0, 1);
+    CHECK_THROWS_AS(builder.addEdges(batch, INT_MAX), std::length_error); // Rejected by size, the batch is not read
+    CHECK(builder.getNumOfEdges() == 1);
+}
+
 // Queue Tests 
 
 TEST_CASE("Queue basic operations") {
@@ -123,6 +495,124 @@ TEST_CASE("Queue capacity") {
     CHECK(q.cap() == 5);
 }
 
+// MinHeap Tests 
+
+TEST_CASE("MinHeap pops in key order") {
+    MinHeap heap(2);
+    heap.push(5, 0);
+    heap.push(1, 1);
+    heap.push(3, 2);
+    heap.push(1, 0); // Same key as vertex 1, smaller vertex comes first
+    heap.push(4, 3); // Grows past the initial capacity
+    CHECK(heap.size() == 5);
+    CHECK(heap.peekKey() == 1);
+    CHECK(heap.peekVertex() == 0);
+    CHECK(heap.pop() == 0);
+    CHECK(heap.pop() == 1);
+    CHECK(heap.pop() == 2);
+    CHECK(heap.pop() == 3);
+    CHECK(heap.pop() == 0);
+    CHECK(heap.isEmpty());
+}
+
+TEST_CASE("MinHeap underflow and clear") {
+    MinHeap heap(1);
+    CHECK_THROWS_AS(heap.pop(), std::underflow_error);
+    CHECK_THROWS_AS(heap.peekKey(), std::underflow_error);
+    heap.push(1, 1);
+    heap.clear();
+    CHECK(heap.isEmpty());
+}
+
+// IndexedHeap Tests 
+
+TEST_CASE("IndexedHeap push, decreaseKey and pop") {
+    IndexedHeap<4> heap(6);
+    heap.push(0, 9);
+    heap.push(1, 4);
+    heap.push(2, 7);
+    heap.push(5, 4);
+    CHECK(heap.contains(2));
+    CHECK(!heap.contains(3));
+    heap.decreaseKey(2, 1);
+    CHECK(heap.peekKey() == 1);
+    CHECK(heap.pushOrDecrease(0, 2));
+    CHECK(!heap.pushOrDecrease(5, 8)); // Larger key, no change
+    CHECK(heap.pop() == 2);
+    CHECK(heap.pop() == 0);
+    CHECK(heap.pop() == 1); // Equal keys pop by item index
+    CHECK(heap.pop() == 5);
+    CHECK(heap.isEmpty());
+    CHECK(!heap.contains(2));
+}
+
+TEST_CASE("IndexedHeap invalid operations") {
+    IndexedHeap<2> heap(2);
+    CHECK_THROWS_AS(heap.pop(), std::underflow_error);
+    CHECK_THROWS_AS(heap.push(2, 1), std::out_of_range);
+    heap.push(1, 5);
+    CHECK_THROWS_AS(heap.push(1, 3), std::logic_error);
+    CHECK_THROWS_AS(heap.decreaseKey(1, 6), std::logic_error);
+    CHECK_THROWS_AS(heap.decreaseKey(0, 1), std::logic_error);
+}
+
+// BucketQueue Tests 
+
+TEST_CASE("BucketQueue pops in key order with decrease-key") {
+    BucketQueue queue(6, 5);
+    CHECK(queue.pushOrDecrease(0, 3));
+    CHECK(queue.pushOrDecrease(1, 5));
+    CHECK(queue.pushOrDecrease(2, 0));
+    CHECK(queue.pushOrDecrease(1, 1));
+    CHECK_FALSE(queue.pushOrDecrease(0, 4)); // Larger key, no change
+    CHECK(queue.contains(1));
+    CHECK_FALSE(queue.contains(3));
+    CHECK(queue.size() == 3);
+    CHECK(queue.pop() == 2);
+    CHECK(queue.pop() == 1);
+    CHECK(queue.getCurrentKey() == 1);
+    CHECK(queue.pushOrDecrease(4, 6)); // Keys wrap around the buckets
+    CHECK(queue.pushOrDecrease(5, 1)); // Equal to the last popped key
+    CHECK(queue.pop() == 5);
+    CHECK(queue.pop() == 0);
+    CHECK(queue.pop() == 4);
+    CHECK(queue.getCurrentKey() == 6);
+    CHECK(queue.isEmpty());
+}
+
+TEST_CASE("BucketQueue invalid operations") {
+    BucketQueue queue(3, 4);
+    CHECK_THROWS_AS(queue.pop(), std::underflow_error);
+    CHECK_THROWS_AS(queue.pushOrDecrease(3, 1), std::out_of_range);
+    CHECK_THROWS_AS(queue.pushOrDecrease(0, 5), std::invalid_argument); // More than max_step above the last pop
+    queue.pushOrDecrease(0, 2);
+    queue.pop();
+    CHECK_THROWS_AS(queue.pushOrDecrease(1, 1), std::invalid_argument); // Below the last popped key
+}
+
+// Bitmap Tests 
+
+TEST_CASE("Bitmap set, reset and count") {
+    Bitmap bits(130);
+    CHECK(bits.size() == 130);
+    CHECK(bits.count() == 0);
+    bits.set(0);
+    bits.set(64);
+    bits.set(129);
+    CHECK(bits.test(64));
+    CHECK(!bits.test(63));
+    CHECK(bits.count() == 3);
+    bits.reset(64);
+    CHECK(!bits.test(64));
+    Bitmap other(130);
+    other.set(5);
+    bits.swap(other);
+    CHECK(bits.test(5));
+    CHECK(other.test(129));
+    bits.clear();
+    CHECK(bits.count() == 0);
+}
+
 // UnionFind Tests 
 
 TEST_CASE("UnionFind basic operations") {
@@ -163,6 +653,56 @@ TEST_CASE("UnionFind invalid index") {
     CHECK_THROWS_AS(uf.unite(0, 3), std::out_of_range);
 }
 
+// ThreadTeam Tests 
+
+TEST_CASE("ThreadTeam runs every phase on the same threads") {
+    ThreadTeam team(4);
+    CHECK(team.getSize() == 4);
+    const int n = 1000;
+    std::vector<int> hits(n, 0);
+    std::vector<int> total(4, 0);
+    for (int phase = 0; phase < 200; phase++) { // Each phase sees what the previous one wrote
+        int threads = 1 + phase % 4;
+        team.parallelFor(0, n, threads, [&](int t, int first, int last) {
+            for (int i = first; i < last; i++) {
+                hits[i]++;
+            }
+            total[t] += last - first;
+        });
+    }
+    for (int i = 0; i < n; i++) {
+        CHECK(hits[i] == 200);
+    }
+    CHECK(total[0] + total[1] + total[2] + total[3] == 200 * n);
+    CHECK(total[3] > 0);
+
+    std::vector<int> chunk_begin(4, -1); // doctest checks are not thread-safe, the workers only record
+    std::vector<int> chunk_end(4, -1);
+    team.parallelFor(5, 7, 4, [&](int t, int first, int last) { // At most one chunk per index
+        chunk_begin[t] = first;
+        chunk_end[t] = last;
+    });
+    CHECK(chunk_begin[0] == 5);
+    CHECK(chunk_end[0] == 6);
+    CHECK(chunk_begin[1] == 6);
+    CHECK(chunk_end[1] == 7);
+    CHECK(chunk_begin[2] == -1);
+    int empty_calls = 0;
+    team.parallelFor(3, 3, 4, [&](int, int, int) { empty_calls++; });
+    CHECK(empty_calls == 0);
+
+    ThreadTeam alone(0); // The calling thread only
+    CHECK(alone.getSize() == 1);
+    int calls = 0;
+    alone.parallelFor(0, 10, 8, [&](int t, int first, int last) {
+        CHECK(t == 0);
+        CHECK(first == 0);
+        CHECK(last == 10);
+        calls++;
+    });
+    CHECK(calls == 1);
+}
+
 // Algorithms Tests 
 
 TEST_CASE("BFS returns valid tree") {
@@ -237,4 +777,1529 @@ TEST_CASE("Kruskal minimum spanning tree") {
     g.addEdge(3, 0, 4);
     Graph mst = Algorithms::kruskal(g);
     CHECK(mst.getNumOfVertices() == 4);
-}
\ No newline at end of file
+}
+
+// CSRGraph Tests 
+
+TEST_CASE("CSRGraph freeze keeps edges and weights") {
+    Graph g(4);
+    g.addEdge(0, 1, 3);
+    g.addEdge(0, 2, 5);
+    g.addDirectedEdge(3, 1, 7);
+    CSRGraph csr(g);
+    CHECK(csr.getNumOfVertices() == 4);
+    CHECK(csr.getNumOfEdges() == 5);
+    CHECK(csr.getDegree(0) == 2);
+    CHECK(csr.getDegree(3) == 1);
+    CHECK(csr.getWeight(0, 2) == 5);
+    CHECK(csr.getWeight(2, 0) == 5);
+    CHECK(csr.getWeight(3, 1) == 7);
+    CHECK(csr.getWeight(1, 3) == INT_MAX);
+    CHECK_THROWS_AS(csr.getWeight(0, 4), std::out_of_range);
+}
+
+TEST_CASE("CSRGraph keeps adjacency list order") {
+    Graph g(3);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 2);
+    CSRGraph csr(g);
+    const int* offsets = csr.getOffsets();
+    int i = offsets[0];
+    for (Edge* e = g.getAdjList()[0]; e != nullptr; e = e->next, i++) {
+        CHECK(csr.getDestVertices()[i] == e->dest_vertex);
+        CHECK(csr.getWeights()[i] == e->weight);
+    }
+    CHECK(i == offsets[1]);
+}
+
+TEST_CASE("Algorithms on CSRGraph match the Graph versions") {
+    Graph g(6);
+    g.addEdge(0, 1, 2);
+    g.addEdge(0, 2, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(1, 3, 7);
+    g.addEdge(2, 4, 3);
+    g.addEdge(3, 4, 2);
+    g.addEdge(3, 5, 1);
+    g.addEdge(4, 5, 5);
+    CSRGraph csr(g);
+
+    Graph bfs_list = Algorithms::bfs(g, 0);
+    Graph bfs_csr = Algorithms::bfs(csr, 0);
+    Graph dfs_list = Algorithms::dfs(g, 0);
+    Graph dfs_csr = Algorithms::dfs(csr, 0);
+    Graph dijkstra_list = Algorithms::dijkstra(g, 0);
+    Graph dijkstra_csr = Algorithms::dijkstra(csr, 0);
+    Graph prim_list = Algorithms::prim(g);
+    Graph prim_csr = Algorithms::prim(csr);
+    Graph kruskal_list = Algorithms::kruskal(g);
+    Graph kruskal_csr = Algorithms::kruskal(csr);
+
+    for (int u = 0; u < 6; u++) {
+        for (int v = 0; v < 6; v++) {
+            CHECK(bfs_list.getWeight(u, v) == bfs_csr.getWeight(u, v));
+            CHECK(dfs_list.getWeight(u, v) == dfs_csr.getWeight(u, v));
+            CHECK(dijkstra_list.getWeight(u, v) == dijkstra_csr.getWeight(u, v));
+            CHECK(prim_list.getWeight(u, v) == prim_csr.getWeight(u, v));
+            CHECK(kruskal_list.getWeight(u, v) == kruskal_csr.getWeight(u, v));
+        }
+    }
+}
+
+TEST_CASE("CSRGraph BFS from invalid vertex") {
+    Graph g(2);
+    CSRGraph csr(g);
+    CHECK_THROWS_AS(Algorithms::bfs(csr, 2), std::out_of_range);
+}
+
+TEST_CASE("Dijkstra engines produce the same tree") {
+    const int n = 60;
+    Graph g = randomGraph(n, 240, 7, 5, 1, false, true); // Small weights so that ties are common
+    CSRGraph csr(g);
+
+    Graph linear = Algorithms::dijkstra(g, 3, DijkstraEngine::LinearScan);
+    Graph heap = Algorithms::dijkstra(g, 3, DijkstraEngine::BinaryHeap);
+    Graph csr_linear = Algorithms::dijkstra(csr, 3, DijkstraEngine::LinearScan);
+    Graph csr_heap = Algorithms::dijkstra(csr, 3);
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            CHECK(heap.getWeight(u, v) == linear.getWeight(u, v));
+            CHECK(csr_linear.getWeight(u, v) == linear.getWeight(u, v));
+            CHECK(csr_heap.getWeight(u, v) == linear.getWeight(u, v));
+        }
+    }
+}
+
+TEST_CASE("primHeap matches prim for every arity") {
+    const int n = 50;
+    Graph g = randomGraph(n, 200, 11, 4, 1, false, true);
+    CSRGraph csr(g);
+
+    Graph expected = Algorithms::prim(g);
+    Graph binary = Algorithms::primHeap<2>(g);
+    Graph quad = Algorithms::primHeap(g);
+    Graph octal = Algorithms::primHeap<8>(csr);
+    Graph wide = Algorithms::primHeap<16>(csr);
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            CHECK(binary.getWeight(u, v) == expected.getWeight(u, v));
+            CHECK(quad.getWeight(u, v) == expected.getWeight(u, v));
+            CHECK(octal.getWeight(u, v) == expected.getWeight(u, v));
+            CHECK(wide.getWeight(u, v) == expected.getWeight(u, v));
+        }
+    }
+}
+
+TEST_CASE("Kruskal sorts negative and large weights") {
+    Graph g(5);
+    g.addEdge(0, 1, 1000000);
+    g.addEdge(1, 2, -5);
+    g.addEdge(2, 3, 70000);
+    g.addEdge(3, 4, -300);
+    g.addEdge(0, 4, 2);
+    g.addEdge(0, 2, 999999);
+    Graph mst = Algorithms::kruskal(g);
+    CHECK(mst.getWeight(1, 2) == -5);
+    CHECK(mst.getWeight(3, 4) == -300);
+    CHECK(mst.getWeight(0, 4) == 2);
+    CHECK(mst.getWeight(2, 3) == 70000);
+    CHECK(mst.getWeight(0, 1) == INT_MAX);
+    CHECK(mst.getWeight(0, 2) == INT_MAX);
+}
+
+TEST_CASE("Kruskal on a large sparse graph") {
+    const int n = 70000; // Past the size where the n choose 2 buffer overflowed
+    Graph g(n);
+    for (int i = 0; i + 1 < n; i++) {
+        g.addEdge(i, i + 1, (i * 7919) % 1000);
+    }
+    g.addEdge(0, n - 1, 5000); // Closes a cycle, the heaviest edge must be dropped
+    Graph mst = Algorithms::kruskal(g);
+    CHECK(mst.getWeight(0, n - 1) == INT_MAX);
+    CHECK(mst.getWeight(n - 2, n - 1) == ((n - 2) * 7919) % 1000);
+    CSRGraph csr(g);
+    Graph csr_mst = Algorithms::kruskal(csr);
+    CHECK(csr_mst.getWeight(0, n - 1) == INT_MAX);
+    CHECK(csr_mst.getWeight(12345, 12346) == (12345 * 7919) % 1000);
+}
+
+TEST_CASE("Boruvka matches Kruskal") {
+    const int n = 80;
+    Graph g = randomGraph(n, 300, 5, 3, -2, false, true); // Many ties and some negative weights
+    CSRGraph csr(g);
+
+    Graph expected = Algorithms::kruskal(g);
+    Graph single = Algorithms::boruvka(g, 1);
+    Graph threaded = Algorithms::boruvka(g, 4);
+    Graph csr_threaded = Algorithms::boruvka(csr, 3);
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            CHECK(single.getWeight(u, v) == expected.getWeight(u, v));
+            CHECK(threaded.getWeight(u, v) == expected.getWeight(u, v));
+            CHECK(csr_threaded.getWeight(u, v) == expected.getWeight(u, v));
+        }
+    }
+}
+
+TEST_CASE("Boruvka on disconnected graph") {
+    Graph g(5);
+    g.addEdge(0, 1, 3);
+    g.addEdge(3, 4, 1);
+    Graph mst = Algorithms::boruvka(g);
+    CHECK(mst.getWeight(0, 1) == 3);
+    CHECK(mst.getWeight(4, 3) == 1);
+    CHECK(mst.getWeight(1, 2) == INT_MAX);
+}
+
+// Returns the depth of every vertex in a rooted tree (-1 if unreachable from root)
+static void treeDepths(const Graph& tree, int root, int* depth) {
+    int n = tree.getNumOfVertices();
+    for (int i = 0; i < n; i++) {
+        depth[i] = -1;
+    }
+    depth[root] = 0;
+    Queue queue(n);
+    queue.enqueue(root);
+    while (!queue.isEmpty()) {
+        int current = queue.dequeue();
+        for (Edge* e = tree.getAdjList()[current]; e != nullptr; e = e->next) {
+            depth[e->dest_vertex] = depth[current] + 1;
+            queue.enqueue(e->dest_vertex);
+        }
+    }
+}
+
+TEST_CASE("Direction-optimizing BFS gives BFS depths") {
+    const int n = 400;
+    Graph g = randomGraph(n, 3000, 3, 3, 1, false, true); // Dense enough for the bottom-up steps to kick in
+    for (int i = 380; i + 1 < n; i++) { // A tail that forces a switch back to top-down
+        g.addEdge(i, i + 1, 2);
+    }
+
+    Graph expected = Algorithms::bfs(g, 0);
+    Graph optimized = Algorithms::bfsDirectionOptimizing(g, 0);
+    Graph always_bottom_up = Algorithms::bfsDirectionOptimizing(g, 0, 1, 1000000);
+    int expected_depth[n];
+    int optimized_depth[n];
+    int bottom_up_depth[n];
+    treeDepths(expected, 0, expected_depth);
+    treeDepths(optimized, 0, optimized_depth);
+    treeDepths(always_bottom_up, 0, bottom_up_depth);
+    for (int v = 0; v < n; v++) {
+        CHECK(optimized_depth[v] == expected_depth[v]);
+        CHECK(bottom_up_depth[v] == expected_depth[v]);
+    }
+    for (int u = 0; u < n; u++) { // Every tree edge is an edge of g with the same weight
+        for (Edge* e = optimized.getAdjList()[u]; e != nullptr; e = e->next) {
+            CHECK(g.getWeight(u, e->dest_vertex) == e->weight);
+        }
+    }
+}
+
+TEST_CASE("Direction-optimizing BFS invalid arguments") {
+    Graph g(3);
+    CHECK_THROWS_AS(Algorithms::bfsDirectionOptimizing(g, 3), std::out_of_range);
+    CHECK_THROWS_AS(Algorithms::bfsDirectionOptimizing(g, 0, 0, 18), std::invalid_argument);
+}
+
+TEST_CASE("Parallel BFS gives BFS depths") {
+    const int n = 5000;
+    Graph g = randomGraph(n, 20000, 17, 4, 1, false, true);
+    CSRGraph csr(g);
+
+    Graph expected = Algorithms::bfs(csr, 7);
+    Graph parallel = Algorithms::bfsParallel(csr, 7, 4);
+    Graph single = Algorithms::bfsParallel(g, 7, 1);
+    int* expected_depth = new int[n];
+    int* parallel_depth = new int[n];
+    int* single_depth = new int[n];
+    treeDepths(expected, 7, expected_depth);
+    treeDepths(parallel, 7, parallel_depth);
+    treeDepths(single, 7, single_depth);
+    for (int v = 0; v < n; v++) {
+        CHECK(parallel_depth[v] == expected_depth[v]);
+        CHECK(single_depth[v] == expected_depth[v]);
+    }
+    for (int u = 0; u < n; u++) { // Every tree edge is an edge of g with the same weight
+        for (Edge* e = parallel.getAdjList()[u]; e != nullptr; e = e->next) {
+            CHECK(csr.getWeight(u, e->dest_vertex) == e->weight);
+        }
+    }
+    delete[] expected_depth;
+    delete[] parallel_depth;
+    delete[] single_depth;
+}
+
+TEST_CASE("Parallel BFS from invalid vertex") {
+    Graph g(2);
+    CHECK_THROWS_AS(Algorithms::bfsParallel(g, -1), std::out_of_range);
+}
+
+TEST_CASE("DFS keeps the recursive visit order") {
+    Graph g(7);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 2);
+    g.addEdge(1, 3, 3);
+    g.addEdge(2, 3, 4);
+    g.addEdge(3, 4, 5);
+    g.addEdge(5, 6, 6);
+    Graph tree = Algorithms::dfs(g, 0);
+    // Lists are most-recent-first: 0 -> 2 -> 3 -> 4, then 3 -> 1 (1 is reached through 3, not 0)
+    CHECK(tree.getWeight(0, 2) == 2);
+    CHECK(tree.getWeight(2, 3) == 4);
+    CHECK(tree.getWeight(3, 4) == 5);
+    CHECK(tree.getWeight(3, 1) == 3);
+    CHECK(tree.getWeight(0, 1) == INT_MAX);
+    CHECK(tree.getWeight(5, 6) == 6); // Second tree of the forest
+    CSRGraph csr(g);
+    Graph csr_tree = Algorithms::dfs(csr, 0);
+    for (int u = 0; u < 7; u++) {
+        for (int v = 0; v < 7; v++) {
+            CHECK(csr_tree.getWeight(u, v) == tree.getWeight(u, v));
+        }
+    }
+}
+
+TEST_CASE("DFS on a long chain does not overflow the stack") {
+    const int n = 300000;
+    GraphBuilder builder(n);
+    for (int i = 0; i + 1 < n; i++) {
+        builder.addEdge(i, i + 1, 1);
+    }
+    Graph g = builder.build();
+    Graph tree = Algorithms::dfs(g, 0);
+    CHECK(tree.getWeight(0, 1) == 1);
+    CHECK(tree.getWeight(n - 2, n - 1) == 1);
+    CHECK(tree.getWeight(n - 1, n - 2) == INT_MAX);
+    CSRGraph csr(g);
+    Graph csr_tree = Algorithms::dfs(csr, n - 1);
+    CHECK(csr_tree.getWeight(1, 0) == 1);
+}
+
+TEST_CASE("TraversalTree from BFS and DFS") {
+    Graph g(6);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 7);
+    g.addEdge(1, 3, 2);
+    g.addEdge(2, 3, 1);
+    TraversalTree bfs_tree = Algorithms::bfsTree(g, 0);
+    CHECK(bfs_tree.getReachedCount() == 4);
+    CHECK(bfs_tree.getOrder()[0] == 0);
+    CHECK(bfs_tree.getParent(0) == -1);
+    CHECK(bfs_tree.getDistance(0) == 0);
+    CHECK(bfs_tree.getDistance(1) == 1);
+    CHECK(bfs_tree.getDistance(2) == 1);
+    CHECK(bfs_tree.getDistance(3) == 2);
+    CHECK(bfs_tree.getParentWeight(3) == g.getWeight(bfs_tree.getParent(3), 3));
+    CHECK_FALSE(bfs_tree.isReached(4));
+    CHECK(bfs_tree.getDistance(5) == TraversalTree::UNREACHED);
+    CHECK_THROWS_AS(bfs_tree.getParent(6), std::out_of_range);
+
+    TraversalTree dfs_tree = Algorithms::dfsTree(g, 0);
+    CHECK(dfs_tree.getReachedCount() == 6); // DFS covers every component
+    CHECK(dfs_tree.getOrder()[4] == 4); // Roots of the other components come in index order
+    CHECK(dfs_tree.getParent(4) == -1);
+    CHECK(dfs_tree.getDistance(4) == 0);
+    CHECK(dfs_tree.getDistance(3) == 2);
+    CHECK(dfs_tree.getDistance(dfs_tree.getOrder()[3]) == 3); // 0 -> 2 -> 3 -> 1 (lists are most-recent-first)
+}
+
+TEST_CASE("TraversalTree toGraph matches the Graph results") {
+    const int n = 200;
+    Graph g = randomGraph(n, 600, 12, 50);
+    CSRGraph csr(g);
+    Graph expected[] = {Algorithms::bfs(g, 3), Algorithms::dfs(g, 3), Algorithms::dijkstra(g, 3)};
+    Graph converted[] = {Algorithms::bfsTree(csr, 3).toGraph(), Algorithms::dfsTree(csr, 3).toGraph(), Algorithms::dijkstraTree(csr, 3).toGraph()};
+    for (int k = 0; k < 3; k++) {
+        for (int u = 0; u < n; u++) {
+            for (Edge* e = expected[k].getAdjList()[u]; e != nullptr; e = e->next) {
+                CHECK(converted[k].getWeight(u, e->dest_vertex) == e->weight);
+            }
+        }
+    }
+}
+
+TEST_CASE("Dijkstra tree distances and settle order") {
+    Graph g(5);
+    g.addEdge(0, 1, 2000000000);
+    g.addEdge(1, 2, 2000000000); // Sums past INT_MAX
+    g.addEdge(0, 3, 1);
+    TraversalTree linear = Algorithms::dijkstraTree(g, 0, DijkstraEngine::LinearScan);
+    TraversalTree heap = Algorithms::dijkstraTree(g, 0, DijkstraEngine::BinaryHeap);
+    CHECK(heap.getDistance(2) == 4000000000LL);
+    CHECK(heap.getParent(2) == 1);
+    CHECK(heap.getParentWeight(2) == 2000000000);
+    CHECK_FALSE(heap.isReached(4));
+    CHECK(heap.getReachedCount() == 4);
+    int expected_order[] = {0, 3, 1, 2};
+    for (int k = 0; k < 4; k++) {
+        CHECK(heap.getOrder()[k] == expected_order[k]);
+        CHECK(linear.getOrder()[k] == expected_order[k]);
+    }
+}
+
+TEST_CASE("TraversalTree move") {
+    Graph g(3);
+    g.addEdge(0, 1, 5);
+    TraversalTree tree = Algorithms::bfsTree(g, 0);
+    TraversalTree moved(std::move(tree));
+    CHECK(moved.getParent(1) == 0);
+    CHECK(tree.getNumOfVertices() == 0);
+    tree = Algorithms::bfsTree(g, 2);
+    CHECK(tree.getReachedCount() == 1);
+    moved = std::move(tree);
+    CHECK(moved.getParent(1) == -1);
+}
+
+TEST_CASE("SpanningForest from Prim, Kruskal and Boruvka") {
+    Graph g(6);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 2, 2);
+    g.addEdge(3, 4, -5);
+    SpanningForest prim_forest = Algorithms::primForest(g); // Only spans vertex 0's component
+    CHECK(prim_forest.getNumOfEdges() == 2);
+    CHECK(prim_forest.getTotalWeight() == 3);
+    CHECK(Algorithms::primHeapForest<2>(g).getTotalWeight() == 3);
+    SpanningForest kruskal_forest = Algorithms::kruskalForest(g);
+    CHECK(kruskal_forest.getNumOfEdges() == 3);
+    CHECK(kruskal_forest.getTotalWeight() == -2);
+    CHECK(kruskal_forest.getWeights()[0] == -5); // Accepted in weight order
+    CHECK(kruskal_forest.getSources()[0] == 3);
+    CHECK(kruskal_forest.getDestinations()[0] == 4);
+    SpanningForest boruvka_forest = Algorithms::boruvkaForest(CSRGraph(g), 2);
+    CHECK(boruvka_forest.getTotalWeight() == -2);
+    Graph mst = kruskal_forest.toGraph();
+    CHECK(mst.getWeight(4, 3) == -5);
+    CHECK(mst.getWeight(1, 2) == 1);
+    CHECK(mst.getWeight(0, 1) == INT_MAX);
+}
+
+TEST_CASE("SpanningForest holds at most n - 1 edges") {
+    SpanningForest forest(3);
+    forest.addEdge(0, 1, 1);
+    forest.addEdge(1, 2, 1);
+    CHECK_THROWS_AS(forest.addEdge(0, 2, 1), std::overflow_error);
+    SpanningForest moved(std::move(forest));
+    CHECK(moved.getNumOfEdges() == 2);
+    CHECK(forest.getNumOfEdges() == 0);
+    SpanningForest empty(0);
+    CHECK_THROWS_AS(empty.addEdge(0, 0, 1), std::overflow_error);
+}
+
+TEST_CASE("BasicCSRGraph without weights") {
+    // Undirected 4-cycle 0-1-2-3 plus a pendant 4, every edge listed in both directions
+    uint32_t sources[] = {0, 1, 1, 2, 2, 3, 3, 0, 3, 4};
+    uint32_t destinations[] = {1, 0, 2, 1, 3, 2, 0, 3, 4, 3};
+    BasicCSRGraph<uint32_t, NoWeight> g(6, 10, sources, destinations, nullptr);
+    CHECK(g.getNumOfEdges() == 10u);
+    CHECK(g.getWeights() == nullptr); // No weight column at all
+    CHECK(g.getDegree(3) == 3u);
+    CHECK(g.hasEdge(4, 3));
+    CHECK_FALSE(g.hasEdge(0, 2));
+    CHECK_THROWS_AS(g.getDegree(6), std::out_of_range);
+
+    BasicTraversalTree<uint32_t, NoWeight> bfs_tree = Algorithms::bfsTree(g, 0);
+    CHECK(bfs_tree.getDistance(2) == 2);
+    CHECK(bfs_tree.getDistance(4) == 2);
+    CHECK(bfs_tree.getParent(4) == 3u);
+    CHECK(bfs_tree.getParents()[0] == BasicTraversalTree<uint32_t, NoWeight>::NO_PARENT);
+    CHECK(bfs_tree.getParentWeights() == nullptr);
+    CHECK_FALSE(bfs_tree.isReached(5));
+
+    BasicTraversalTree<uint32_t, NoWeight> shortest = Algorithms::dijkstraTree(g, 0);
+    for (uint32_t v = 0; v < 6; v++) { // Unit lengths, so Dijkstra agrees with BFS
+        CHECK(shortest.getDistance(v) == bfs_tree.getDistance(v));
+    }
+    CHECK(Algorithms::dfsTree(g, 0).getReachedCount() == 6u);
+
+    Graph mutable_graph = bfs_tree.toGraph();
+    CHECK(mutable_graph.getWeight(3, 4) == 1); // Unweighted tree edges become weight 1
+}
+
+TEST_CASE("BasicCSRGraph frozen from a Graph matches CSRGraph") {
+    const int n = 300;
+    Graph g = randomGraph(n, 900, 5, 200);
+    CSRGraph csr(g);
+    BasicCSRGraph<uint32_t, NoWeight> unweighted(g);
+    BasicCSRGraph<uint64_t, uint8_t> small_weights(g);
+    BasicCSRGraph<uint64_t, double> real_weights(g);
+    TraversalTree bfs_tree = Algorithms::bfsTree(csr, 0);
+    BasicTraversalTree<uint32_t, NoWeight> unweighted_bfs = Algorithms::bfsTree(unweighted, 0);
+    TraversalTree dfs_tree = Algorithms::dfsTree(csr, 0);
+    BasicTraversalTree<uint32_t, NoWeight> unweighted_dfs = Algorithms::dfsTree(unweighted, 0);
+    TraversalTree shortest = Algorithms::dijkstraTree(csr, 0);
+    BasicTraversalTree<uint64_t, uint8_t> small_shortest = Algorithms::dijkstraTree(small_weights, 0, DijkstraEngine::LinearScan);
+    BasicTraversalTree<uint64_t, double> real_shortest = Algorithms::dijkstraTree(real_weights, 0);
+    for (int v = 0; v < n; v++) {
+        CHECK(unweighted_bfs.getParent(v) == static_cast<uint32_t>(bfs_tree.getParent(v)));
+        CHECK(unweighted_dfs.getParent(v) == static_cast<uint32_t>(dfs_tree.getParent(v)));
+        CHECK(small_shortest.getDistance(v) == shortest.getDistance(v));
+        if (shortest.isReached(v)) {
+            CHECK(real_shortest.getDistance(v) == doctest::Approx(static_cast<double>(shortest.getDistance(v))));
+        }
+    }
+}
+
+TEST_CASE("Templated Dijkstra sums in a wide distance type") {
+    const uint64_t n = 400;
+    uint64_t sources[n - 1];
+    uint64_t destinations[n - 1];
+    uint8_t weights[n - 1];
+    for (uint64_t i = 0; i + 1 < n; i++) { // A directed chain of maximal uint8_t weights
+        sources[i] = i;
+        destinations[i] = i + 1;
+        weights[i] = 255;
+    }
+    BasicCSRGraph<uint64_t, uint8_t> chain(n, n - 1, sources, destinations, weights);
+    BasicTraversalTree<uint64_t, uint8_t> tree = Algorithms::dijkstraTree(chain, 0);
+    CHECK(tree.getDistance(n - 1) == 255LL * 399);
+    CHECK(tree.getParentWeight(n - 1) == 255);
+
+    int64_t big_sources[] = {0, 1};
+    int64_t big_destinations[] = {1, 2};
+    int64_t big_weights[] = {4000000000000LL, 5000000000000LL};
+    BasicCSRGraph<int64_t, int64_t> big(3, 2, big_sources, big_destinations, big_weights);
+    CHECK(Algorithms::dijkstraTree(big, 0).getDistance(2) == 9000000000000LL);
+
+    float float_weights[] = {0.25f, 0.5f};
+    uint32_t float_sources[] = {0, 1};
+    uint32_t float_destinations[] = {1, 2};
+    BasicCSRGraph<uint32_t, float> fractional(3, 2, float_sources, float_destinations, float_weights);
+    CHECK(Algorithms::dijkstraTree(fractional, 0).getDistance(2) == doctest::Approx(0.75));
+    CHECK(fractional.getWeight(1, 2) == 0.5f);
+}
+
+TEST_CASE("BasicCSRGraph edge list validation") {
+    uint32_t sources[] = {0, 3};
+    uint32_t destinations[] = {1, 0};
+    CHECK_THROWS_AS((BasicCSRGraph<uint32_t, NoWeight>(3, 2, sources, destinations, nullptr)), std::out_of_range);
+    int int_sources[] = {0, -1};
+    int int_destinations[] = {1, 0};
+    int int_weights[] = {1, 1};
+    CHECK_THROWS_AS(CSRGraph(2, 2, int_sources, int_destinations, int_weights), std::out_of_range);
+    CSRGraph empty(2, 0, int_sources, int_destinations, int_weights);
+    CHECK_THROWS_AS(Algorithms::bfsTree(empty, 2), std::out_of_range);
+}
+
+// GraphFile Tests 
+
+TEST_CASE("MappedGraph round trip runs the algorithms over the mapped file") {
+    const int n = 200;
+    Graph g = randomGraph(n, 600, 11, 100);
+    CSRGraph csr(g);
+    MappedGraph::save(g, "test_graph_file.bin");
+    {
+        MappedGraph mapped("test_graph_file.bin", true);
+        const CSRGraph& view = mapped.getGraph();
+        CHECK(mapped.getVersion() == GRAPH_FILE_VERSION);
+        CHECK(mapped.verifyChecksum());
+        CHECK_FALSE(view.ownsArrays());
+        CHECK(view.getNumOfVertices() == n);
+        CHECK(view.getNumOfEdges() == csr.getNumOfEdges());
+        for (int e = 0; e < csr.getNumOfEdges(); e++) {
+            CHECK(view.getDestVertices()[e] == csr.getDestVertices()[e]);
+            CHECK(view.getWeights()[e] == csr.getWeights()[e]);
+        }
+
+        TraversalTree expected = Algorithms::dijkstraTree(csr, 0);
+        TraversalTree shortest = Algorithms::dijkstraTree(view, 0);
+        TraversalTree bfs_tree = Algorithms::bfsTree(view, 0);
+        TraversalTree expected_bfs = Algorithms::bfsTree(csr, 0);
+        for (int v = 0; v < n; v++) {
+            CHECK(shortest.getDistance(v) == expected.getDistance(v));
+            CHECK(bfs_tree.getParent(v) == expected_bfs.getParent(v));
+        }
+    }
+    std::remove("test_graph_file.bin");
+}
+
+TEST_CASE("MappedGraph without weights and with 64-bit ids") {
+    uint32_t sources[] = {0, 1, 1, 2};
+    uint32_t destinations[] = {1, 0, 2, 1};
+    BasicCSRGraph<uint32_t, NoWeight> unweighted(4, 4, sources, destinations, nullptr);
+    BasicMappedGraph<uint32_t, NoWeight>::save(unweighted, "test_graph_file.bin");
+    {
+        BasicMappedGraph<uint32_t, NoWeight> mapped("test_graph_file.bin", true);
+        CHECK(mapped.getGraph().getWeights() == nullptr);
+        CHECK(mapped.getGraph().hasEdge(2, 1));
+        CHECK(Algorithms::bfsTree(mapped.getGraph(), 0).getDistance(2) == 2);
+        CHECK_FALSE(Algorithms::bfsTree(mapped.getGraph(), 0).isReached(3));
+        // The file stores no weights, so it cannot be opened as a weighted graph
+        CHECK_THROWS_AS(MappedGraph("test_graph_file.bin"), std::runtime_error);
+        CHECK_THROWS_AS((BasicMappedGraph<uint64_t, NoWeight>("test_graph_file.bin")), std::runtime_error);
+    }
+
+    Graph empty(0);
+    BasicMappedGraph<uint64_t, double>::save(empty, "test_graph_file.bin");
+    {
+        BasicMappedGraph<uint64_t, double> mapped("test_graph_file.bin", true);
+        CHECK(mapped.getGraph().getNumOfVertices() == 0u);
+        CHECK(mapped.getGraph().getNumOfEdges() == 0u);
+    }
+    std::remove("test_graph_file.bin");
+}
+
+TEST_CASE("MappedGraph rejects bad files") {
+    CHECK_THROWS_AS(MappedGraph("no_such_graph_file.bin"), std::runtime_error);
+
+    Graph g(3);
+    g.addEdge(0, 1, 5);
+    g.addEdge(1, 2, 7);
+    MappedGraph::save(g, "test_graph_file.bin");
+
+    // Read the file back, damage a copy of it and write the copy over the file
+    std::vector<char> bytes;
+    {
+        std::FILE* file = std::fopen("test_graph_file.bin", "rb");
+        REQUIRE(file != nullptr);
+        int c;
+        while ((c = std::fgetc(file)) != EOF) bytes.push_back(static_cast<char>(c));
+        std::fclose(file);
+    }
+    auto writeBytes = [](const std::vector<char>& data, size_t count) {
+        std::FILE* file = std::fopen("test_graph_file.bin", "wb");
+        std::fwrite(data.data(), 1, count, file);
+        std::fclose(file);
+    };
+
+    std::vector<char> damaged = bytes;
+    damaged[damaged.size() - 4] ^= 1; // Flip a bit of the last weight
+    writeBytes(damaged, damaged.size());
+    {
+        MappedGraph unchecked("test_graph_file.bin"); // The header is fine, only the checksum catches it
+        CHECK_FALSE(unchecked.verifyChecksum());
+    }
+    CHECK_THROWS_AS(MappedGraph("test_graph_file.bin", true), std::runtime_error);
+
+    writeBytes(bytes, bytes.size() - 8); // Truncated
+    CHECK_THROWS_AS(MappedGraph("test_graph_file.bin"), std::runtime_error);
+
+    damaged = bytes;
+    damaged[0] = 'X'; // Bad magic
+    writeBytes(damaged, damaged.size());
+    CHECK_THROWS_AS(MappedGraph("test_graph_file.bin"), std::runtime_error);
+
+    damaged = bytes;
+    damaged[8] = 2; // Version 2
+    writeBytes(damaged, damaged.size());
+    CHECK_THROWS_AS(MappedGraph("test_graph_file.bin"), std::runtime_error);
+
+    writeBytes(bytes, 0); // Empty file
+    CHECK_THROWS_AS(MappedGraph("test_graph_file.bin"), std::runtime_error);
+    std::remove("test_graph_file.bin");
+}
+
+TEST_CASE("MappedGraph rejects counts that wrap the section sizes") {
+    uint64_t sources[] = {0, 1};
+    uint64_t destinations[] = {1, 2};
+    double weights[] = {1.5, 2.5};
+    BasicCSRGraph<uint64_t, double> g(3, 2, sources, destinations, weights);
+    BasicMappedGraph<uint64_t, double>::save(g, "test_graph_file.bin");
+    std::vector<char> bytes;
+    {
+        std::FILE* file = std::fopen("test_graph_file.bin", "rb");
+        REQUIRE(file != nullptr);
+        int c;
+        while ((c = std::fgetc(file)) != EOF) bytes.push_back(static_cast<char>(c));
+        std::fclose(file);
+    }
+    for (size_t field : {offsetof(GraphFileHeader, num_vertices), offsetof(GraphFileHeader, num_edges)}) {
+        std::vector<char> damaged = bytes;
+        uint64_t count;
+        std::memcpy(&count, damaged.data() + field, sizeof(count));
+        count += 1ULL << 61; // Times 8 bytes per element, the section size wraps back to the real one
+        std::memcpy(damaged.data() + field, &count, sizeof(count));
+        std::FILE* file = std::fopen("test_graph_file.bin", "wb");
+        std::fwrite(damaged.data(), 1, damaged.size(), file);
+        std::fclose(file);
+        CHECK_THROWS_AS((BasicMappedGraph<uint64_t, double>("test_graph_file.bin")), std::runtime_error);
+    }
+    std::remove("test_graph_file.bin");
+}
+
+// EdgeListLoader Tests 
+
+static void writeTextFile(const char* path, const std::string& text) {
+    std::FILE* file = std::fopen(path, "wb");
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+}
+
+TEST_CASE("EdgeListLoader reads a SNAP edge list") {
+    writeTextFile("test_edge_list.txt",
+        "# Directed graph: a comment\n"
+        "% another comment\n"
+        "0 1\n"
+        "1\t2 7\r\n"
+        "\n"
+        "   \n"
+        "2 0 -3\n"
+        "4 2");
+    Graph directed = EdgeListLoader::loadSnap("test_edge_list.txt", true);
+    CHECK(directed.getNumOfVertices() == 5);
+    CHECK(directed.getWeight(0, 1) == 1);
+    CHECK(directed.getWeight(1, 2) == 7);
+    CHECK(directed.getWeight(2, 0) == -3);
+    CHECK(directed.getWeight(4, 2) == 1);
+    CHECK(directed.getWeight(1, 0) == INT_MAX);
+
+    Graph undirected = EdgeListLoader::loadSnap("test_edge_list.txt");
+    CHECK(undirected.getWeight(2, 1) == 7);
+    CHECK(undirected.getWeight(2, 4) == 1);
+
+    writeTextFile("test_edge_list.txt", "");
+    CHECK(EdgeListLoader::loadSnap("test_edge_list.txt").getNumOfVertices() == 0);
+    std::remove("test_edge_list.txt");
+}
+
+TEST_CASE("EdgeListLoader reads a DIMACS file") {
+    writeTextFile("test_edge_list.txt",
+        "c 9th DIMACS challenge style\n"
+        "p sp 4 4\n"
+        "a 1 2 10\n"
+        "a 2 3 20\n"
+        "a 3 1 30\n"
+        "a 1 2 5\n");
+    Graph g = EdgeListLoader::loadDimacs("test_edge_list.txt");
+    CHECK(g.getNumOfVertices() == 4);
+    CHECK(g.getWeight(0, 1) == 5); // KeepLast
+    CHECK(g.getWeight(1, 2) == 20);
+    CHECK(g.getWeight(2, 0) == 30);
+    CHECK(EdgeListLoader::loadDimacs("test_edge_list.txt", DuplicatePolicy::KeepMin).getWeight(0, 1) == 5);
+    CHECK(g.getWeight(1, 0) == INT_MAX); // Arcs are directed
+    std::remove("test_edge_list.txt");
+}
+
+TEST_CASE("EdgeListLoader parallel chunks match a single thread") {
+    const int n = 500;
+    std::string text = "# random graph\n";
+    for (const EdgeTriple& e : randomEdges(n, 3000, 21, 50)) {
+        text += std::to_string(e.src) + " " + std::to_string(e.dest) + " " + std::to_string(e.weight) + "\n";
+    }
+    writeTextFile("test_edge_list.txt", text);
+    Graph single = EdgeListLoader::loadSnap("test_edge_list.txt", true, DuplicatePolicy::KeepLast, 1);
+    for (int threads : {2, 3, 7, 64}) {
+        Graph parallel = EdgeListLoader::loadSnap("test_edge_list.txt", true, DuplicatePolicy::KeepLast, threads);
+        CSRGraph expected(single);
+        CSRGraph actual(parallel);
+        REQUIRE(actual.getNumOfVertices() == expected.getNumOfVertices());
+        REQUIRE(actual.getNumOfEdges() == expected.getNumOfEdges());
+        for (int e = 0; e < expected.getNumOfEdges(); e++) {
+            CHECK(actual.getDestVertices()[e] == expected.getDestVertices()[e]);
+            CHECK(actual.getWeights()[e] == expected.getWeights()[e]);
+        }
+    }
+    std::remove("test_edge_list.txt");
+}
+
+TEST_CASE("EdgeListLoader rejects malformed files") {
+    CHECK_THROWS_AS(EdgeListLoader::loadSnap("no_such_edge_list.txt"), std::runtime_error);
+
+    writeTextFile("test_edge_list.txt", "0 1\n1 2\n2 x\n3 4\n");
+    for (int threads : {1, 4}) {
+        try {
+            EdgeListLoader::loadSnap("test_edge_list.txt", false, DuplicatePolicy::KeepLast, threads);
+            FAIL("Expected an exception");
+        } catch (const std::runtime_error& e) {
+            CHECK(std::string(e.what()).find("line 3") != std::string::npos);
+        }
+    }
+
+    writeTextFile("test_edge_list.txt", "0 -1\n");
+    CHECK_THROWS_AS(EdgeListLoader::loadSnap("test_edge_list.txt"), std::runtime_error);
+    writeTextFile("test_edge_list.txt", "0 1 2 3\n");
+    CHECK_THROWS_AS(EdgeListLoader::loadSnap("test_edge_list.txt"), std::runtime_error);
+    writeTextFile("test_edge_list.txt", "0 99999999999\n");
+    CHECK_THROWS_AS(EdgeListLoader::loadSnap("test_edge_list.txt"), std::runtime_error);
+
+    writeTextFile("test_edge_list.txt", "a 1 2 3\n"); // No problem line
+    CHECK_THROWS_AS(EdgeListLoader::loadDimacs("test_edge_list.txt"), std::runtime_error);
+    writeTextFile("test_edge_list.txt", "p sp 2 1\na 1 3 3\n"); // Vertex 3 of 2
+    CHECK_THROWS_AS(EdgeListLoader::loadDimacs("test_edge_list.txt"), std::runtime_error);
+    writeTextFile("test_edge_list.txt", "p sp 2 1\na 0 1 3\n"); // Ids are 1-based
+    CHECK_THROWS_AS(EdgeListLoader::loadDimacs("test_edge_list.txt"), std::runtime_error);
+    writeTextFile("test_edge_list.txt", "p sp 2 1\nx 1 2 3\n");
+    CHECK_THROWS_AS(EdgeListLoader::loadDimacs("test_edge_list.txt"), std::runtime_error);
+    std::remove("test_edge_list.txt");
+}
+
+TEST_CASE("Delta-stepping matches Dijkstra distances") {
+    const int n = 3000;
+    Graph g = randomGraph(n, 9000, 17, 999, 0); // Includes zero weights
+    CSRGraph csr(g);
+    TraversalTree expected = Algorithms::dijkstraTree(csr, 0);
+    TraversalTree single = Algorithms::deltaSteppingTree(csr, 0, 0, 1);
+    for (long long delta : {0LL, 1LL, 37LL, 1000LL, 1000000LL}) {
+        for (int threads : {1, 4}) {
+            TraversalTree tree = Algorithms::deltaSteppingTree(csr, 0, delta, threads);
+            CHECK(tree.getReachedCount() == expected.getReachedCount());
+            for (int v = 0; v < n; v++) {
+                CHECK(tree.getDistance(v) == expected.getDistance(v));
+                int p = tree.getParent(v);
+                if (p != -1) { // Every tree edge lies on a shortest path
+                    CHECK(tree.getDistance(p) + tree.getParentWeight(v) == tree.getDistance(v));
+                    CHECK(csr.getWeight(p, v) == tree.getParentWeight(v));
+                }
+            }
+            if (delta == 0) {
+                for (int v = 0; v < n; v++) { // The tree does not depend on the number of threads
+                    CHECK(tree.getParent(v) == single.getParent(v));
+                }
+            }
+        }
+    }
+    for (int k = 0; k < single.getReachedCount(); k++) { // Every reached vertex appears in the order exactly once
+        CHECK(single.isReached(single.getOrder()[k]));
+    }
+}
+
+TEST_CASE("Delta-stepping on small graphs") {
+    Graph g(6);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 1);
+    g.addEdge(2, 1, 2);
+    g.addEdge(1, 3, 0);
+    g.addEdge(3, 4, 10);
+    Graph tree = Algorithms::deltaStepping(g, 0, 2, 2);
+    CHECK(tree.getWeight(0, 2) == 1);
+    CHECK(tree.getWeight(2, 1) == 2);
+    CHECK(tree.getWeight(1, 3) == 0);
+    CHECK(tree.getWeight(3, 4) == 10);
+    TraversalTree flat = Algorithms::deltaSteppingTree(g, 0);
+    CHECK(flat.getDistance(4) == 13);
+    CHECK_FALSE(flat.isReached(5));
+    CHECK(flat.getReachedCount() == 5);
+
+    Graph single(1);
+    CHECK(Algorithms::deltaSteppingTree(single, 0, 0, 8).getReachedCount() == 1);
+
+    CHECK_THROWS_AS(Algorithms::deltaSteppingTree(g, 6), std::out_of_range);
+    g.addEdge(4, 5, -1);
+    CHECK_THROWS_AS(Algorithms::deltaSteppingTree(g, 0), std::invalid_argument);
+}
+
+TEST_CASE("Bucket queue Dijkstra matches the binary heap distances") {
+    const int n = 400;
+    Graph g = randomGraph(n, 1600, 29, 5, 0); // Small weights, including zero
+    CSRGraph csr(g);
+    TraversalTree expected = Algorithms::dijkstraTree(g, 0);
+    TraversalTree buckets = Algorithms::dijkstraTree(g, 0, DijkstraEngine::BucketQueue);
+    TraversalTree csr_buckets = Algorithms::dijkstraTree(csr, 0, DijkstraEngine::BucketQueue);
+    TraversalTree automatic = Algorithms::dijkstraTree(csr, 0, DijkstraEngine::Auto);
+    for (int v = 0; v < n; v++) {
+        CHECK(buckets.getDistance(v) == expected.getDistance(v));
+        CHECK(csr_buckets.getDistance(v) == expected.getDistance(v));
+        CHECK(automatic.getDistance(v) == expected.getDistance(v));
+        int p = buckets.getParent(v);
+        if (p != -1) { // Ties may pick another parent, but always on a shortest path
+            CHECK(buckets.getDistance(p) + g.getWeight(p, v) == buckets.getDistance(v));
+        }
+    }
+    CHECK(buckets.getReachedCount() == expected.getReachedCount());
+    for (int k = 1; k < buckets.getReachedCount(); k++) { // Settled in distance order
+        CHECK(buckets.getDistance(buckets.getOrder()[k - 1]) <= buckets.getDistance(buckets.getOrder()[k]));
+    }
+
+    // Large weights make Auto fall back to the heap, which gives the exact heap tree
+    g.addEdge(0, 1, static_cast<int>(DIJKSTRA_BUCKET_MAX_WEIGHT) + 1);
+    Graph heap_tree = Algorithms::dijkstra(g, 0);
+    Graph auto_tree = Algorithms::dijkstra(g, 0, DijkstraEngine::Auto);
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            CHECK(auto_tree.getWeight(u, v) == heap_tree.getWeight(u, v));
+        }
+    }
+}
+
+TEST_CASE("Bucket queue Dijkstra engine selection") {
+    uint32_t sources[] = {0, 1, 2};
+    uint32_t destinations[] = {1, 2, 3};
+    BasicCSRGraph<uint32_t, NoWeight> unweighted(4, 3, sources, destinations, nullptr);
+    CHECK(Algorithms::dijkstraTree(unweighted, 0, DijkstraEngine::Auto).getDistance(3) == 3);
+    CHECK(Algorithms::dijkstraTree(unweighted, 0, DijkstraEngine::BucketQueue).getDistance(3) == 3);
+
+    double weights[] = {0.5, 0.25, 0.125};
+    BasicCSRGraph<uint32_t, double> fractional(4, 3, sources, destinations, weights);
+    CHECK(Algorithms::dijkstraTree(fractional, 0, DijkstraEngine::Auto).getDistance(3) == doctest::Approx(0.875));
+    CHECK_THROWS_AS(Algorithms::dijkstraTree(fractional, 0, DijkstraEngine::BucketQueue), std::invalid_argument);
+
+    Graph g(3);
+    g.addDirectedEdge(0, 1, 4);
+    g.addDirectedEdge(1, 2, -1);
+    CHECK_THROWS_AS(Algorithms::dijkstraTree(g, 0, DijkstraEngine::BucketQueue), std::invalid_argument);
+    CHECK(Algorithms::dijkstraTree(g, 0, DijkstraEngine::Auto).getDistance(2) == 3); // Falls back to the heap
+
+    CHECK(resolveDijkstraEngine(DijkstraEngine::Auto, 0, 10) == DijkstraEngine::BucketQueue);
+    CHECK(resolveDijkstraEngine(DijkstraEngine::Auto, 0, DIJKSTRA_BUCKET_MAX_WEIGHT + 1) == DijkstraEngine::BinaryHeap);
+    CHECK(resolveDijkstraEngine(DijkstraEngine::LinearScan, -5, 10) == DijkstraEngine::LinearScan);
+}
+
+TEST_CASE("shortestPath stops at the target with the Dijkstra distance") {
+    const int n = 300;
+    Graph g = randomGraph(n, 900, 41, 49, 0, true);
+    CSRGraph csr(g);
+    for (int source = 0; source < n; source += 37) {
+        TraversalTree tree = Algorithms::dijkstraTree(g, source);
+        for (int target = 0; target < n; target += 7) {
+            Path path = Algorithms::shortestPath(g, source, target);
+            Path csr_path = Algorithms::shortestPath(csr, source, target);
+            if (!tree.isReached(target)) {
+                CHECK_FALSE(path.isFound());
+                CHECK(path.getCost() == Path::NO_PATH);
+                CHECK(path.getLength() == 0);
+                CHECK_FALSE(csr_path.isFound());
+                continue;
+            }
+            REQUIRE(path.isFound());
+            CHECK(path.getCost() == tree.getDistance(target));
+            CHECK(csr_path.getCost() == tree.getDistance(target));
+            CHECK(path.getVertex(0) == source);
+            CHECK(path.getVertex(path.getLength() - 1) == target);
+            long long cost = 0;
+            for (int k = 0; k + 1 < path.getLength(); k++) { // Consecutive vertices are joined by edges
+                int weight = g.getWeight(path.getVertex(k), path.getVertex(k + 1));
+                REQUIRE(weight != INT_MAX);
+                cost += weight;
+            }
+            CHECK(cost == path.getCost());
+            CHECK(csr_path.getLength() == path.getLength());
+        }
+    }
+}
+
+TEST_CASE("shortestPath edge cases") {
+    Graph g(4);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, 4);
+    Path same = Algorithms::shortestPath(g, 2, 2);
+    CHECK(same.isFound());
+    CHECK(same.getCost() == 0);
+    CHECK(same.getLength() == 1);
+    CHECK(same.getVertices()[0] == 2);
+
+    Path path = Algorithms::shortestPath(g, 2, 0);
+    CHECK(path.getCost() == 7);
+    CHECK(path.getLength() == 3);
+    CHECK(path.getVertex(1) == 1);
+    CHECK_THROWS_AS(path.getVertex(3), std::out_of_range);
+
+    Path moved = std::move(path);
+    CHECK(moved.getCost() == 7);
+    CHECK_FALSE(path.isFound());
+
+    CHECK_FALSE(Algorithms::shortestPath(g, 0, 3).isFound());
+    CHECK_THROWS_AS(Algorithms::shortestPath(g, 0, 4), std::out_of_range);
+    CHECK_THROWS_AS(Algorithms::shortestPath(g, -1, 0), std::out_of_range);
+}
+
+TEST_CASE("reversed flips every edge of a Graph and a CSRGraph") {
+    Graph g(4);
+    g.addDirectedEdge(0, 1, 5);
+    g.addDirectedEdge(2, 1, 7);
+    g.addDirectedEdge(1, 3, 2);
+    g.addDirectedEdge(3, 0, 4);
+    Graph reverse = g.reversed();
+    CHECK(reverse.getWeight(1, 0) == 5);
+    CHECK(reverse.getWeight(1, 2) == 7);
+    CHECK(reverse.getWeight(3, 1) == 2);
+    CHECK(reverse.getWeight(0, 3) == 4);
+    CHECK(reverse.getWeight(0, 1) == INT_MAX);
+    CHECK(reverse.getAdjList()[1]->dest_vertex == 0); // Sorted by source
+    CHECK(reverse.getAdjList()[1]->next->dest_vertex == 2);
+    CHECK(reverse.getAdjList()[2] == nullptr);
+    reverse.addDirectedEdge(2, 3, 6); // A reversed graph takes new edges like any other
+    CHECK(reverse.getWeight(2, 3) == 6);
+    CHECK(reverse.getWeight(1, 0) == 5);
+
+    CSRGraph csr(g);
+    CSRGraph csr_reverse = csr.reversed();
+    CHECK(csr_reverse.ownsArrays());
+    CHECK(csr_reverse.getNumOfEdges() == 4);
+    CHECK(csr_reverse.getWeight(1, 0) == 5);
+    CHECK(csr_reverse.getWeight(1, 2) == 7);
+    CHECK(csr_reverse.getWeight(0, 3) == 4);
+    CHECK_FALSE(csr_reverse.hasEdge(0, 1));
+    CHECK(csr_reverse.getDestVertices()[csr_reverse.getOffsets()[1]] == 0);
+}
+
+TEST_CASE("bidirectionalShortestPath matches shortestPath") {
+    const int n = 400;
+    Graph g = randomGraph(n, 1400, 97, 29, 0, true);
+    Graph reverse = g.reversed();
+    CSRGraph csr(g);
+    CSRGraph csr_reverse = csr.reversed();
+    for (int source = 0; source < n; source += 23) {
+        for (int target = 0; target < n; target += 11) {
+            Path expected = Algorithms::shortestPath(g, source, target);
+            Path path = Algorithms::bidirectionalShortestPath(g, reverse, source, target);
+            Path csr_path = Algorithms::bidirectionalShortestPath(csr, csr_reverse, source, target);
+            REQUIRE(path.getCost() == expected.getCost());
+            REQUIRE(csr_path.getCost() == expected.getCost());
+            if (!path.isFound()) continue;
+            CHECK(path.getVertex(0) == source);
+            CHECK(path.getVertex(path.getLength() - 1) == target);
+            long long cost = 0;
+            for (int k = 0; k + 1 < path.getLength(); k++) {
+                int weight = g.getWeight(path.getVertex(k), path.getVertex(k + 1));
+                REQUIRE(weight != INT_MAX);
+                cost += weight;
+            }
+            CHECK(cost == path.getCost());
+        }
+    }
+}
+
+TEST_CASE("bidirectionalShortestPath on an undirected graph and edge cases") {
+    Graph g(6);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    g.addEdge(2, 3, 2);
+    g.addEdge(0, 4, 5);
+    g.addEdge(4, 3, 5);
+    Path path = Algorithms::bidirectionalShortestPath(g, g, 0, 3); // Undirected: its own reverse
+    CHECK(path.getCost() == 6);
+    REQUIRE(path.getLength() == 4);
+    CHECK(path.getVertex(1) == 1);
+    CHECK(path.getVertex(2) == 2);
+
+    Path same = Algorithms::bidirectionalShortestPath(g, g, 3, 3);
+    CHECK(same.getCost() == 0);
+    CHECK(same.getLength() == 1);
+
+    Path none = Algorithms::bidirectionalShortestPath(g, g, 0, 5);
+    CHECK_FALSE(none.isFound());
+    CHECK(none.getCost() == Path::NO_PATH);
+
+    Graph smaller(5);
+    CHECK_THROWS_AS(Algorithms::bidirectionalShortestPath(g, smaller, 0, 3), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::bidirectionalShortestPath(g, g, 0, 6), std::out_of_range);
+}
+
+TEST_CASE("VertexCoordinates and the A* heuristics") {
+    VertexCoordinates coordinates(3);
+    coordinates.setCoordinates(1, 3, 4);
+    coordinates.setCoordinates(2, -1, 2.5);
+    CHECK(coordinates.getX(1) == 3);
+    CHECK(coordinates.getY(2) == 2.5);
+    CHECK(coordinates.getX(0) == 0);
+    CHECK_THROWS_AS(coordinates.setCoordinates(3, 0, 0), std::out_of_range);
+    CHECK_THROWS_AS(coordinates.getY(-1), std::out_of_range);
+
+    Graph g(3);
+    EuclideanHeuristic euclidean(g, coordinates, 1);
+    CHECK(euclidean(0) == 5);
+    CHECK(euclidean(1) == 0);
+    CHECK(EuclideanHeuristic(g, coordinates, 1, 2.0)(0) == 10);
+    ManhattanHeuristic manhattan(g, coordinates, 1);
+    CHECK(manhattan(0) == 7);
+    CHECK(manhattan(2) == 5); // 4 + 1.5, rounded down
+    CHECK_THROWS_AS(EuclideanHeuristic(g, coordinates, 3), std::out_of_range);
+    CHECK_THROWS_AS(ManhattanHeuristic(g, coordinates, 0, -1.0), std::invalid_argument);
+
+    Graph larger(5); // Vertices 3 and 4 have no position, the heuristics would read past the arrays
+    CHECK_THROWS_AS(EuclideanHeuristic(larger, coordinates, 1), std::invalid_argument);
+    CHECK_THROWS_AS(ManhattanHeuristic(larger, coordinates, 1), std::invalid_argument);
+}
+
+TEST_CASE("aStar on a grid finds shortest paths and settles fewer vertices") {
+    const int side = 40;
+    const int n = side * side;
+    unsigned int seed = 7;
+    Graph g(n);
+    VertexCoordinates coordinates(n);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            coordinates.setCoordinates(v, c, r);
+            int right_weight = 1 + nextRandom(seed, 3); // Every edge costs at least its length of 1
+            int down_weight = 1 + nextRandom(seed, 3);
+            if (c + 1 < side) g.addEdge(v, v + 1, right_weight);
+            if (r + 1 < side) g.addEdge(v, v + side, down_weight);
+        }
+    }
+
+    for (int query = 0; query < 20; query++) {
+        int source = nextRandom(seed, n);
+        int target = nextRandom(seed, n);
+        Path expected = Algorithms::shortestPath(g, source, target);
+
+        int manhattan_calls = 0;
+        ManhattanHeuristic manhattan(g, coordinates, target);
+        Path path = Algorithms::aStar(g, source, target, [&](int v) { manhattan_calls++; return manhattan(v); });
+        Path euclidean_path = Algorithms::aStar(g, source, target, EuclideanHeuristic(g, coordinates, target));
+        int zero_calls = 0;
+        Path dijkstra_path = Algorithms::aStar(g, source, target, [&](int) { zero_calls++; return 0LL; });
+
+        REQUIRE(path.getCost() == expected.getCost());
+        CHECK(euclidean_path.getCost() == expected.getCost());
+        CHECK(dijkstra_path.getCost() == expected.getCost());
+        CHECK(manhattan_calls <= zero_calls); // Guided towards the target, it reaches fewer vertices
+        CHECK(path.getVertex(0) == source);
+        CHECK(path.getVertex(path.getLength() - 1) == target);
+        long long cost = 0;
+        for (int k = 0; k + 1 < path.getLength(); k++) {
+            cost += g.getWeight(path.getVertex(k), path.getVertex(k + 1));
+        }
+        CHECK(cost == path.getCost());
+    }
+
+    Graph split(3);
+    split.addEdge(0, 1, 1);
+    VertexCoordinates split_coordinates(3);
+    CHECK_FALSE(Algorithms::aStar(split, 0, 2, EuclideanHeuristic(split, split_coordinates, 2)).isFound());
+    CHECK_THROWS_AS(Algorithms::aStar(split, 0, 3, [](int) { return 0LL; }), std::out_of_range);
+}
+
+// Contraction Hierarchy Tests 
+
+namespace {
+    // Checks that a path runs from source to target over edges of g and costs what it claims
+    void checkPathInGraph(const Graph& g, const Path& path, int source, int target) {
+        REQUIRE(path.isFound());
+        CHECK(path.getVertex(0) == source);
+        CHECK(path.getVertex(path.getLength() - 1) == target);
+        long long cost = 0;
+        for (int k = 0; k + 1 < path.getLength(); k++) {
+            int weight = g.getWeight(path.getVertex(k), path.getVertex(k + 1));
+            REQUIRE(weight != INT_MAX);
+            cost += weight;
+        }
+        CHECK(cost == path.getCost());
+    }
+}
+
+TEST_CASE("ContractionHierarchy matches Dijkstra on a random directed graph") {
+    const int n = 500;
+    Graph g = randomGraph(n, 2000, 2024, 39, 0, true);
+    ContractionHierarchy ch(g);
+    CHECK(ch.getNumOfVertices() == n);
+    ContractionHierarchyQuery query(ch);
+    for (int source = 0; source < n; source += 31) {
+        TraversalTree tree = Algorithms::dijkstraTree(g, source);
+        for (int target = 0; target < n; target += 13) {
+            long long expected = tree.isReached(target) ? tree.getDistance(target) : Path::NO_PATH;
+            REQUIRE(query.distance(source, target) == expected);
+            Path path = query.shortestPath(source, target);
+            REQUIRE(path.getCost() == expected);
+            if (expected != Path::NO_PATH) checkPathInGraph(g, path, source, target);
+        }
+    }
+}
+
+TEST_CASE("ContractionHierarchy on an undirected grid, ranks and convenience queries") {
+    const int side = 30;
+    const int n = side * side;
+    unsigned int seed = 5;
+    Graph g(n);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            int right_weight = 1 + nextRandom(seed, 9);
+            int down_weight = 1 + nextRandom(seed, 9);
+            if (c + 1 < side) g.addEdge(v, v + 1, right_weight);
+            if (r + 1 < side) g.addEdge(v, v + side, down_weight);
+        }
+    }
+    ContractionHierarchy ch(g);
+    bool* seen = new bool[n]{false};
+    for (int v = 0; v < n; v++) { // The ranks are a permutation
+        int rank = ch.getRank(v);
+        REQUIRE(rank >= 0);
+        REQUIRE(rank < n);
+        CHECK_FALSE(seen[rank]);
+        seen[rank] = true;
+    }
+    delete[] seen;
+
+    for (int query = 0; query < 30; query++) {
+        int source = nextRandom(seed, n);
+        int target = nextRandom(seed, n);
+        Path expected = Algorithms::shortestPath(g, source, target);
+        CHECK(ch.distance(source, target) == expected.getCost());
+        Path path = ch.shortestPath(source, target);
+        CHECK(path.getCost() == expected.getCost());
+        checkPathInGraph(g, path, source, target);
+    }
+
+    Path same = ch.shortestPath(7, 7);
+    CHECK(same.getCost() == 0);
+    CHECK(same.getLength() == 1);
+    CHECK_THROWS_AS(ch.distance(0, n), std::out_of_range);
+    CHECK_THROWS_AS(ch.shortestPath(-1, 0), std::out_of_range);
+    CHECK_THROWS_AS(ch.getRank(n), std::out_of_range);
+}
+
+TEST_CASE("ContractionHierarchy edge cases") {
+    Graph g(5);
+    g.addDirectedEdge(0, 1, 4);
+    g.addDirectedEdge(0, 1, 2); // Overwrites the weight
+    g.addDirectedEdge(1, 1, 1); // Self loop
+    g.addDirectedEdge(1, 2, 0);
+    g.addDirectedEdge(2, 3, 3);
+    ContractionHierarchy ch(g);
+    CHECK(ch.distance(0, 3) == 5);
+    CHECK(ch.distance(3, 0) == Path::NO_PATH);
+    CHECK_FALSE(ch.shortestPath(0, 4).isFound());
+    Path path = ch.shortestPath(0, 3);
+    REQUIRE(path.getLength() == 4);
+    CHECK(path.getVertex(2) == 2);
+
+    Graph negative(2);
+    negative.addDirectedEdge(0, 1, -1);
+    CHECK_THROWS_AS(ContractionHierarchy{negative}, std::invalid_argument);
+
+    Graph empty(0);
+    ContractionHierarchy empty_ch(empty);
+    CHECK(empty_ch.getNumOfShortcuts() == 0);
+}
+
+TEST_CASE("ContractionHierarchy save and load") {
+    const int n = 200;
+    Graph g = randomGraph(n, 700, 77, 20);
+    const char* path = "test_hierarchy.bin";
+    ContractionHierarchy ch(g);
+    ch.save(path);
+    ContractionHierarchy loaded = ContractionHierarchy::load(path);
+    CHECK(loaded.getNumOfVertices() == n);
+    CHECK(loaded.getNumOfShortcuts() == ch.getNumOfShortcuts());
+    for (int v = 0; v < n; v++) {
+        REQUIRE(loaded.getRank(v) == ch.getRank(v));
+    }
+    ContractionHierarchyQuery query(loaded);
+    for (int source = 0; source < n; source += 17) {
+        for (int target = 0; target < n; target += 9) {
+            REQUIRE(query.distance(source, target) == ch.distance(source, target));
+        }
+    }
+    Path unpacked = query.shortestPath(3, 150);
+    if (unpacked.isFound()) checkPathInGraph(g, unpacked, 3, 150);
+
+    { // Flip one byte of the sections: the checksum catches it
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(ContractionHierarchyHeader) + 5);
+        char byte = 0x5a;
+        file.write(&byte, 1);
+    }
+    CHECK_THROWS_AS(ContractionHierarchy::load(path), std::runtime_error);
+    MappedGraph::save(g, path); // A graph file, not a hierarchy
+    CHECK_THROWS_AS(ContractionHierarchy::load(path), std::runtime_error);
+    std::remove(path);
+    CHECK_THROWS_AS(ContractionHierarchy::load(path), std::runtime_error);
+}
+
+// Landmark Tests 
+
+TEST_CASE("LandmarkIndex bounds and A* queries match Dijkstra") {
+    const int n = 400;
+    Graph g = randomGraph(n, 1600, 321, 50, 1, true);
+    LandmarkStrategy strategies[2] = {LandmarkStrategy::Farthest, LandmarkStrategy::Avoid};
+    for (LandmarkStrategy strategy : strategies) {
+        LandmarkIndex index(g, 8, strategy);
+        REQUIRE(index.getNumOfLandmarks() == 8);
+        for (int i = 0; i < 8; i++) { // Distinct landmarks
+            for (int j = i + 1; j < 8; j++) {
+                CHECK(index.getLandmarks()[i] != index.getLandmarks()[j]);
+            }
+        }
+        for (int source = 0; source < n; source += 29) {
+            TraversalTree tree = Algorithms::dijkstraTree(g, source);
+            for (int target = 0; target < n; target += 17) {
+                long long expected = tree.isReached(target) ? tree.getDistance(target) : Path::NO_PATH;
+                if (expected != Path::NO_PATH) {
+                    REQUIRE(index.lowerBound(source, target) <= expected);
+                }
+                Path path = index.shortestPath(g, source, target);
+                REQUIRE(path.getCost() == expected);
+            }
+        }
+        int landmark = index.getLandmarks()[0];
+        TraversalTree from_landmark = Algorithms::dijkstraTree(g, landmark);
+        for (int v = 0; v < n; v++) { // The bound is exact from a landmark
+            if (from_landmark.isReached(v)) CHECK(index.lowerBound(landmark, v) == from_landmark.getDistance(v));
+        }
+    }
+}
+
+TEST_CASE("LandmarkIndex stays valid when weights increase, and errors") {
+    const int side = 20;
+    Graph g(side * side);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            if (c + 1 < side) g.addEdge(v, v + 1, 3);
+            if (r + 1 < side) g.addEdge(v, v + side, 3);
+        }
+    }
+    LandmarkIndex index(g, 4);
+    Graph congested = g.clone();
+    congested.addEdge(0, 1, 30); // Existing edges get a higher weight
+    congested.addEdge(150, 170, 50);
+    for (int target = 0; target < side * side; target += 37) {
+        CHECK(index.shortestPath(congested, 0, target).getCost() == Algorithms::shortestPath(congested, 0, target).getCost());
+    }
+
+    CHECK_THROWS_AS(LandmarkIndex(g, 0), std::invalid_argument);
+    CHECK_THROWS_AS(LandmarkIndex(g, side * side + 1), std::invalid_argument);
+    Graph negative(2);
+    negative.addDirectedEdge(0, 1, -2);
+    CHECK_THROWS_AS(LandmarkIndex(negative, 1), std::invalid_argument);
+    Graph other(3);
+    CHECK_THROWS_AS(index.shortestPath(other, 0, 1), std::invalid_argument);
+    CHECK_THROWS_AS(index.lowerBound(0, side * side), std::out_of_range);
+    CHECK_THROWS_AS(index.shortestPath(g, 0, -1), std::out_of_range);
+    CHECK_THROWS_AS(LandmarkHeuristic(index, side * side), std::out_of_range);
+}
+
+TEST_CASE("LandmarkIndex save and load") {
+    Graph g(50);
+    for (int v = 0; v + 1 < 50; v++) g.addEdge(v, v + 1, 1 + v % 4);
+    g.addEdge(0, 25, 40);
+    LandmarkIndex index(g, 3, LandmarkStrategy::Farthest);
+    const char* path = "test_landmarks.bin";
+    index.save(path);
+    LandmarkIndex loaded = LandmarkIndex::load(path);
+    CHECK(loaded.getNumOfVertices() == 50);
+    REQUIRE(loaded.getNumOfLandmarks() == 3);
+    for (int l = 0; l < 3; l++) CHECK(loaded.getLandmarks()[l] == index.getLandmarks()[l]);
+    for (int u = 0; u < 50; u += 3) {
+        for (int v = 0; v < 50; v += 7) {
+            CHECK(loaded.lowerBound(u, v) == index.lowerBound(u, v));
+        }
+    }
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(LandmarkFileHeader) + 20);
+        char byte = 0x11;
+        file.write(&byte, 1);
+    }
+    CHECK_THROWS_AS(LandmarkIndex::load(path), std::runtime_error);
+    std::remove(path);
+    CHECK_THROWS_AS(LandmarkIndex::load(path), std::runtime_error);
+}
+
+TEST_CASE("Index files are not mistaken for each other") {
+    Graph g(6);
+    for (int v = 0; v + 1 < 6; v++) g.addEdge(v, v + 1, 2);
+    const char* path = "test_index.bin";
+    ContractionHierarchy(g).save(path);
+    CHECK(ContractionHierarchy::load(path).getNumOfVertices() == 6);
+    CHECK_THROWS_AS(LandmarkIndex::load(path), std::runtime_error); // Another magic
+    LandmarkIndex(g, 2).save(path);
+    CHECK(LandmarkIndex::load(path).getNumOfLandmarks() == 2);
+    CHECK_THROWS_AS(ContractionHierarchy::load(path), std::runtime_error);
+    std::remove(path);
+}
+
+// Batch Dijkstra Tests 
+
+TEST_CASE("DijkstraScratch reuses its buffers across runs") {
+    CSRGraph csr(5, 3, std::vector<int>{0, 1, 3}.data(), std::vector<int>{1, 2, 4}.data(), std::vector<int>{2, 5, 1}.data());
+    DijkstraScratch scratch(5);
+    CHECK(scratch.getSource() == -1);
+    scratch.run(csr, 0);
+    CHECK(scratch.getReachedCount() == 3);
+    CHECK(scratch.getDistances()[2] == 7);
+    CHECK(scratch.getParents()[2] == 1);
+    CHECK(scratch.getDistances()[3] == Path::NO_PATH);
+    scratch.run(csr, 3); // Reaches only 4, everything the first run wrote must be reset
+    CHECK(scratch.getSource() == 3);
+    CHECK(scratch.getReachedCount() == 2);
+    CHECK(scratch.getOrder()[0] == 3);
+    CHECK(scratch.getOrder()[1] == 4);
+    CHECK(scratch.getDistances()[4] == 1);
+    for (int v = 0; v < 3; v++) {
+        CHECK(scratch.getDistances()[v] == Path::NO_PATH);
+        CHECK(scratch.getParents()[v] == -1);
+    }
+    CHECK_THROWS_AS(scratch.run(csr, 5), std::out_of_range);
+    CSRGraph other(Graph(4));
+    CHECK_THROWS_AS(scratch.run(other, 0), std::invalid_argument);
+}
+
+TEST_CASE("dijkstraBatch matches dijkstraTree for every source") {
+    const int n = 300;
+    Graph g = randomGraph(n, 4 * n, 11, 50, 1, true, true);
+    CSRGraph csr(g);
+    std::vector<int> sources;
+    for (int s = 0; s < n; s += 7) sources.push_back(s);
+    sources.push_back(0); // Repeats are allowed
+
+    for (int threads : {1, 4}) {
+        int num_sources = static_cast<int>(sources.size());
+        std::vector<int> calls(num_sources, 0);
+        std::vector<std::vector<long long>> distances(num_sources);
+        std::vector<int> bad_parents(num_sources, 0);
+        Algorithms::dijkstraBatch(csr, sources.data(), num_sources, [&](int index, const DijkstraScratch& result) {
+            calls[index]++;
+            distances[index].assign(result.getDistances(), result.getDistances() + n);
+            for (int i = 0; i < result.getReachedCount(); i++) {
+                int v = result.getOrder()[i];
+                int p = result.getParents()[v];
+                if (v == result.getSource() ? p != -1 : (p < 0 || result.getDistances()[p] >= result.getDistances()[v])) bad_parents[index]++;
+            }
+        }, threads);
+        for (int i = 0; i < num_sources; i++) {
+            CHECK(calls[i] == 1);
+            CHECK(bad_parents[i] == 0);
+            TraversalTree tree = Algorithms::dijkstraTree(csr, sources[i]);
+            for (int v = 0; v < n; v++) {
+                long long expected = tree.isReached(v) ? tree.getDistance(v) : Path::NO_PATH;
+                CHECK(distances[i][v] == expected);
+            }
+        }
+    }
+
+    int total = 0;
+    Algorithms::dijkstraBatch(g, sources.data(), 3, [&](int, const DijkstraScratch& result) {
+        if (result.getReachedCount() > 0) total++; // Only touched by the calling thread
+    }, 1);
+    CHECK(total == 3);
+}
+
+TEST_CASE("dijkstraBatch edge cases") {
+    Graph g(4);
+    g.addEdge(0, 1, 2);
+    int calls = 0;
+    Algorithms::dijkstraBatch(g, nullptr, 0, [&](int, const DijkstraScratch&) { calls++; });
+    CHECK(calls == 0);
+    int sources[] = {0, 4};
+    CHECK_THROWS_AS(Algorithms::dijkstraBatch(g, sources, 2, [&](int, const DijkstraScratch&) { calls++; }), std::out_of_range);
+    CHECK(calls == 0); // Nothing ran before the bad source was found
+    int one[] = {2};
+    Algorithms::dijkstraBatch(g, one, 1, [&](int index, const DijkstraScratch& result) {
+        calls++;
+        CHECK(index == 0);
+        CHECK(result.getReachedCount() == 1);
+    }, 8);
+    CHECK(calls == 1);
+}
+
+TEST_CASE("dijkstraBatch rethrows a worker's exception on the calling thread") {
+    Graph g(50);
+    for (int v = 0; v + 1 < 50; v++) g.addEdge(v, v + 1, 1);
+    std::vector<int> sources(40);
+    for (int i = 0; i < 40; i++) sources[i] = i;
+    std::atomic<int> calls(0);
+    for (int threads : {1, 4}) {
+        calls = 0;
+        CHECK_THROWS_AS(Algorithms::dijkstraBatch(g, sources.data(), 40, [&](int index, const DijkstraScratch&) {
+            calls++;
+            if (index == 3) throw std::runtime_error("callback failed");
+        }, threads), std::runtime_error);
+        if (threads == 1) CHECK(calls == 4); // The worker stopped taking sources
+    }
+}
+
+// Multi-Source BFS Tests 
+
+template <int Lanes>
+static void checkMultiSourceBfs(const Graph& g, const std::vector<int>& sources) {
+    int n = g.getNumOfVertices();
+    int num_sources = static_cast<int>(sources.size());
+    std::vector<int> levels(static_cast<size_t>(num_sources) * n, -1);
+    int repeated = 0;
+    Algorithms::multiSourceBfs<Lanes>(g, sources.data(), num_sources, [&](int index, int vertex, int level) {
+        int& slot = levels[static_cast<size_t>(index) * n + vertex];
+        if (slot != -1) repeated++;
+        slot = level;
+    });
+    CHECK(repeated == 0);
+    for (int i = 0; i < num_sources; i++) {
+        TraversalTree tree = Algorithms::bfsTree(g, sources[i]);
+        for (int v = 0; v < n; v++) {
+            int expected = tree.isReached(v) ? static_cast<int>(tree.getDistance(v)) : -1;
+            CHECK(levels[static_cast<size_t>(i) * n + v] == expected);
+        }
+    }
+}
+
+TEST_CASE("multiSourceBfs matches bfsTree for every source and width") {
+    const int n = 400;
+    Graph g = randomGraph(n, 2 * n, 5, 9, 1, false, true); // Weights are ignored
+    std::vector<int> sources;
+    for (int s = 0; s < 600; s++) sources.push_back((s * 37) % n); // More than one batch of every width, with repeats
+    checkMultiSourceBfs<64>(g, sources);
+    checkMultiSourceBfs<256>(g, sources);
+    checkMultiSourceBfs<512>(g, sources);
+
+    Graph path(70); // A long, thin graph: many levels with a frontier of a few vertices
+    for (int v = 0; v + 1 < 70; v++) path.addDirectedEdge(v, v + 1, 1);
+    checkMultiSourceBfs<64>(path, std::vector<int>{0, 69, 35, 35, 1});
+}
+
+TEST_CASE("multiSourceBfs edge cases") {
+    Graph g(3);
+    g.addEdge(0, 1, 1);
+    int calls = 0;
+    Algorithms::multiSourceBfs(g, nullptr, 0, [&](int, int, int) { calls++; });
+    CHECK(calls == 0);
+    int sources[] = {2, 3};
+    CHECK_THROWS_AS(Algorithms::multiSourceBfs(g, sources, 2, [&](int, int, int) { calls++; }), std::out_of_range);
+    CHECK(calls == 0);
+    CSRGraph csr(g);
+    int isolated[] = {2};
+    Algorithms::multiSourceBfs<256>(csr, isolated, 1, [&](int index, int vertex, int level) {
+        calls++;
+        CHECK(index == 0);
+        CHECK(vertex == 2);
+        CHECK(level == 0);
+    });
+    CHECK(calls == 1);
+}
+
+TEST_CASE("LaneMask operations") {
+    LaneMask<256> a, b;
+    a.clear();
+    b.clear();
+    CHECK(!a.any());
+    a.set(3);
+    a.set(130);
+    a.set(255);
+    b.set(130);
+    CHECK(a.any());
+    CHECK(a.andNot(b));
+    std::vector<int> lanes;
+    a.forEachLane([&](int lane) { lanes.push_back(lane); });
+    CHECK(lanes == std::vector<int>{3, 255});
+    b.orWith(a);
+    CHECK(!a.andNot(b));
+    CHECK(!a.any());
+}
+
+template <int Lanes>
+static void checkLaneMaskAgainstWords() {
+    const int words = Lanes / 64;
+    unsigned long long seed = 77;
+    for (int round = 0; round < 200; round++) {
+        LaneMask<Lanes> a, b;
+        for (int i = 0; i < words; i++) { // Sparse words, so some rounds leave nothing after andNot
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            a.words[i] = round % 3 == 0 ? seed & (seed >> 7) & (seed >> 13) : seed;
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            b.words[i] = round % 4 == 0 ? a.words[i] | seed : seed;
+        }
+        unsigned long long expected_or[words], expected_and_not[words];
+        unsigned long long left = 0;
+        for (int i = 0; i < words; i++) {
+            expected_or[i] = a.words[i] | b.words[i];
+            expected_and_not[i] = a.words[i] & ~b.words[i];
+            left |= expected_and_not[i];
+        }
+        LaneMask<Lanes> ored = a;
+        ored.orWith(b);
+        CHECK(a.andNot(b) == (left != 0));
+        CHECK(a.any() == (left != 0));
+        for (int i = 0; i < words; i++) {
+            CHECK(ored.words[i] == expected_or[i]);
+            CHECK(a.words[i] == expected_and_not[i]);
+        }
+    }
+}
+
+TEST_CASE("LaneMask matches a word-by-word reference at every width") {
+    // Built with -mavx2 / -mavx512f this checks the SIMD paths, otherwise the portable loop
+    checkLaneMaskAgainstWords<64>();
+    checkLaneMaskAgainstWords<256>();
+    checkLaneMaskAgainstWords<512>();
+}